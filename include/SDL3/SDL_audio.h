@@ -648,6 +648,66 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devi
  */
 extern SDL_DECLSPEC int * SDLCALL SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count);
 
+/**
+ * Get the properties associated with an audio device.
+ *
+ * Statistics about the device's mixing thread are reported here, to help
+ * tune buffer sizes. They cover the physical device since it was last
+ * opened, and are updated each time this function is called; the values
+ * don't change between calls. Logical device IDs report the statistics of
+ * the physical device they are opened on.
+ *
+ * The following read-only properties are provided by SDL:
+ *
+ * - `SDL_PROP_AUDIODEVICE_BUFFER_PERIOD_NS_NUMBER`: the length of one device
+ *   buffer, in nanoseconds.
+ * - `SDL_PROP_AUDIODEVICE_ITERATIONS_NUMBER`: the number of buffers the
+ *   device thread has processed.
+ * - `SDL_PROP_AUDIODEVICE_ITERATE_UNDER_25_PERCENT_NUMBER`: the number of
+ *   buffers that took less than 25% of the buffer period to process.
+ * - `SDL_PROP_AUDIODEVICE_ITERATE_UNDER_50_PERCENT_NUMBER`: the number of
+ *   buffers that took 25% to 50% of the buffer period to process.
+ * - `SDL_PROP_AUDIODEVICE_ITERATE_UNDER_75_PERCENT_NUMBER`: the number of
+ *   buffers that took 50% to 75% of the buffer period to process.
+ * - `SDL_PROP_AUDIODEVICE_ITERATE_UNDER_100_PERCENT_NUMBER`: the number of
+ *   buffers that took 75% to 100% of the buffer period to process.
+ * - `SDL_PROP_AUDIODEVICE_ITERATE_OVER_100_PERCENT_NUMBER`: the number of
+ *   buffers that took longer than the buffer period to process.
+ * - `SDL_PROP_AUDIODEVICE_ITERATE_MAX_NS_NUMBER`: the longest time spent
+ *   processing a single buffer, in nanoseconds.
+ * - `SDL_PROP_AUDIODEVICE_UNDERRUNS_NUMBER`: the number of playback buffers
+ *   that were padded with silence because a bound, unpaused audio stream
+ *   didn't have enough data.
+ * - `SDL_PROP_AUDIODEVICE_LATE_WAKEUPS_NUMBER`: the number of times the
+ *   device thread started a buffer more than one and a half buffer periods
+ *   after the previous one.
+ * - `SDL_PROP_AUDIODEVICE_BYTES_PROCESSED_NUMBER`: the number of bytes
+ *   mixed for a playback device, or read from a recording device.
+ *
+ * \param devid the instance ID of the device to query.
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ */
+extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid);
+
+#define SDL_PROP_AUDIODEVICE_BUFFER_PERIOD_NS_NUMBER            "SDL.audiodevice.buffer_period_ns"
+#define SDL_PROP_AUDIODEVICE_ITERATIONS_NUMBER                  "SDL.audiodevice.iterations"
+#define SDL_PROP_AUDIODEVICE_ITERATE_UNDER_25_PERCENT_NUMBER    "SDL.audiodevice.iterate_under_25_percent"
+#define SDL_PROP_AUDIODEVICE_ITERATE_UNDER_50_PERCENT_NUMBER    "SDL.audiodevice.iterate_under_50_percent"
+#define SDL_PROP_AUDIODEVICE_ITERATE_UNDER_75_PERCENT_NUMBER    "SDL.audiodevice.iterate_under_75_percent"
+#define SDL_PROP_AUDIODEVICE_ITERATE_UNDER_100_PERCENT_NUMBER   "SDL.audiodevice.iterate_under_100_percent"
+#define SDL_PROP_AUDIODEVICE_ITERATE_OVER_100_PERCENT_NUMBER    "SDL.audiodevice.iterate_over_100_percent"
+#define SDL_PROP_AUDIODEVICE_ITERATE_MAX_NS_NUMBER              "SDL.audiodevice.iterate_max_ns"
+#define SDL_PROP_AUDIODEVICE_UNDERRUNS_NUMBER                   "SDL.audiodevice.underruns"
+#define SDL_PROP_AUDIODEVICE_LATE_WAKEUPS_NUMBER                "SDL.audiodevice.late_wakeups"
+#define SDL_PROP_AUDIODEVICE_BYTES_PROCESSED_NUMBER             "SDL.audiodevice.bytes_processed"
+
 /**
  * Open a specific audio device.
  *
@@ -1078,6 +1138,21 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
  *   devices when the audio subsystem quits. This property was added in SDL
  *   3.4.0.
  *
+ * The following read-only properties report how full the stream's input
+ * queue has been. They are updated each time this function is called, and
+ * were added in SDL 3.4.0:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_NUMBER`: the number of input bytes
+ *   currently queued.
+ * - `SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_MAX_NUMBER`: the most input bytes
+ *   that have been queued at once.
+ * - `SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_AVERAGE_NUMBER`: the average number
+ *   of input bytes queued when data was requested from the stream.
+ * - `SDL_PROP_AUDIOSTREAM_GET_REQUESTS_NUMBER`: the number of times data was
+ *   requested from the stream, either by the app or by a bound audio device.
+ * - `SDL_PROP_AUDIOSTREAM_SHORT_READS_NUMBER`: the number of those requests
+ *   that got less data than they asked for.
+ *
  * \param stream the SDL_AudioStream to query.
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -1088,7 +1163,12 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioStreamProperties(SDL_AudioStream *stream);
 
-#define SDL_PROP_AUDIOSTREAM_AUTO_CLEANUP_BOOLEAN "SDL.audiostream.auto_cleanup"
+#define SDL_PROP_AUDIOSTREAM_AUTO_CLEANUP_BOOLEAN           "SDL.audiostream.auto_cleanup"
+#define SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_NUMBER            "SDL.audiostream.queued_bytes"
+#define SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_MAX_NUMBER        "SDL.audiostream.queued_bytes_max"
+#define SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_AVERAGE_NUMBER    "SDL.audiostream.queued_bytes_average"
+#define SDL_PROP_AUDIOSTREAM_GET_REQUESTS_NUMBER            "SDL.audiostream.get_requests"
+#define SDL_PROP_AUDIOSTREAM_SHORT_READS_NUMBER             "SDL.audiostream.short_reads"
 
 
 /**
@@ -2243,6 +2323,77 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV_IO(SDL_IOStream *src, bool closeio,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len);
 
+/**
+ * Open a WAVE file as an audio stream that decodes it on demand.
+ *
+ * Unlike SDL_LoadWAV_IO, this doesn't load and decode the whole file up
+ * front. The header is parsed immediately, and the audio data is then read
+ * from `src` and decoded a little at a time, as the stream needs more data.
+ * Memory use stays small no matter how long the file is, which makes this
+ * useful for music and other long sounds.
+ *
+ * The returned stream's input and output formats are both set to the format
+ * of the decoded data, which is also reported in `spec`. Change the output
+ * format with SDL_SetAudioStreamFormat(), or bind the stream to an audio
+ * device, which will do this for you. Once all the data has been decoded,
+ * the stream is flushed, so SDL_GetAudioStreamAvailable() will report zero
+ * after the last of it has been read.
+ *
+ * The same formats as SDL_LoadWAV_IO are supported, and the same hints
+ * apply. Since data is decoded as it is needed, an I/O error or a truncated
+ * file found partway through will end the stream early instead of making
+ * this function fail.
+ *
+ * The stream uses its get callback to decode data, so the app should not
+ * replace it with SDL_SetAudioStreamGetCallback(). `src` must stay valid
+ * until the stream is destroyed, and it must support seeking. If `closeio`
+ * is true, it will be closed when the stream is destroyed.
+ *
+ * \param src the data source for the WAVE data.
+ * \param closeio if true, calls SDL_CloseIO() on `src` when the stream is
+ *                destroyed, or before returning if this function fails.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the WAVE
+ *             data's decoded format on successful return.
+ * \returns an audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information. Destroy the stream with
+ *          SDL_DestroyAudioStream() when done with it.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyAudioStream
+ * \sa SDL_LoadWAV_IO
+ * \sa SDL_LoadWAVStream
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_LoadWAVStream_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec);
+
+/**
+ * Open a WAVE file from a file path as an audio stream that decodes it on
+ * demand.
+ *
+ * This is a convenience function that is effectively the same as:
+ *
+ * ```c
+ * SDL_LoadWAVStream_IO(SDL_IOFromFile(path, "rb"), true, spec);
+ * ```
+ *
+ * \param path the file path of the WAV file to open.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the WAVE
+ *             data's decoded format on successful return.
+ * \returns an audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information. Destroy the stream with
+ *          SDL_DestroyAudioStream() when done with it.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyAudioStream
+ * \sa SDL_LoadWAVStream_IO
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_LoadWAVStream(const char *path, SDL_AudioSpec *spec);
+
 /**
  * Mix audio data in a specified format.
  *
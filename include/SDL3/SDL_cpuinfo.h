@@ -344,6 +344,85 @@ extern SDL_DECLSPEC int SDLCALL SDL_GetSystemRAM(void);
  */
 extern SDL_DECLSPEC size_t SDLCALL SDL_GetSIMDAlignment(void);
 
+/**
+ * The kind of a CPU core on hybrid processors.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetCPUTopology
+ */
+typedef enum SDL_CPUCoreType
+{
+    SDL_CPU_CORE_PERFORMANCE,   /**< A performance core, or any core on a CPU where all cores are the same */
+    SDL_CPU_CORE_EFFICIENCY     /**< An efficiency core, slower but using less power */
+} SDL_CPUCoreType;
+
+/**
+ * Information about a single logical CPU.
+ *
+ * Logical CPUs that share a `core` are SMT siblings (for example, the two
+ * hyperthreads of an Intel core) and compete for the same execution units.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetCPUTopology
+ */
+typedef struct SDL_LogicalCPU
+{
+    int cpu;                /**< The CPU number, as used by SDL_SetCurrentThreadAffinity() */
+    int core;               /**< The physical core, from 0 to num_physical_cores - 1 */
+    int package;            /**< The physical package (socket), from 0 to num_packages - 1 */
+    int numa_node;          /**< The NUMA node, from 0 to num_numa_nodes - 1 */
+    SDL_CPUCoreType type;   /**< The kind of core this CPU is part of */
+} SDL_LogicalCPU;
+
+/**
+ * A description of the processor layout of the system.
+ *
+ * Cache sizes are those of a single cache instance as seen by one core, and
+ * are 0 if the information isn't available.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetCPUTopology
+ */
+typedef struct SDL_CPUTopology
+{
+    int num_logical_cores;      /**< The number of online logical CPUs, and the number of elements in `cpus` */
+    int num_physical_cores;     /**< The number of physical cores */
+    int num_packages;           /**< The number of physical packages (sockets) */
+    int num_numa_nodes;         /**< The number of NUMA nodes */
+    int num_performance_cores;  /**< The number of physical cores of type SDL_CPU_CORE_PERFORMANCE */
+    int num_efficiency_cores;   /**< The number of physical cores of type SDL_CPU_CORE_EFFICIENCY */
+    int l1d_cache_size;         /**< The size of the L1 data cache, in bytes */
+    int l2_cache_size;          /**< The size of the L2 cache, in bytes */
+    int l3_cache_size;          /**< The size of the L3 cache, in bytes */
+    const SDL_LogicalCPU *cpus; /**< The online logical CPUs, sorted by CPU number */
+} SDL_CPUTopology;
+
+/**
+ * Get a description of the CPU cores, caches and NUMA nodes in the system.
+ *
+ * On Linux and Android this is read from sysfs, with the cache sizes taken
+ * from the CPUID instruction on x86 if the kernel doesn't report them. On
+ * other platforms, each logical CPU is reported as its own physical core in
+ * a single package and NUMA node, which is always a safe assumption.
+ *
+ * The topology is read once and cached, so this is cheap to call repeatedly.
+ *
+ * \returns a pointer to the CPU topology, which is valid until SDL_Quit() is
+ *          called, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetNumLogicalCPUCores
+ * \sa SDL_SetCurrentThreadAffinity
+ */
+extern SDL_DECLSPEC const SDL_CPUTopology * SDLCALL SDL_GetCPUTopology(void);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -454,6 +454,7 @@ typedef struct SDL_MouseMotionEvent
     float y;            /**< Y coordinate, relative to window */
     float xrel;         /**< The relative motion in the X direction */
     float yrel;         /**< The relative motion in the Y direction */
+    Uint32 samples;     /**< The number of input samples merged into this event, set when it's queued, see SDL_GetCoalescedEventCount() */
 } SDL_MouseMotionEvent;
 
 /**
@@ -783,6 +784,7 @@ typedef struct SDL_TouchFingerEvent
     float dy;           /**< Normalized in the range -1...1 */
     float pressure;     /**< Normalized in the range 0...1 */
     SDL_WindowID windowID; /**< The window underneath the finger, if any */
+    Uint32 samples;     /**< The number of input samples merged into an SDL_EVENT_FINGER_MOTION event, set when it's queued, see SDL_GetCoalescedEventCount() */
 } SDL_TouchFingerEvent;
 
 /**
@@ -830,6 +832,7 @@ typedef struct SDL_PenMotionEvent
     SDL_PenInputFlags pen_state;   /**< Complete pen input state at time of event */
     float x;                /**< X coordinate, relative to window */
     float y;                /**< Y coordinate, relative to window */
+    Uint32 samples;         /**< The number of input samples merged into this event, set when it's queued, see SDL_GetCoalescedEventCount() */
 } SDL_PenMotionEvent;
 
 /**
@@ -1362,6 +1365,37 @@ extern SDL_DECLSPEC bool SDLCALL SDL_WaitEventTimeout(SDL_Event *event, Sint32 t
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PushEvent(SDL_Event *event);
 
+/**
+ * Add several events to the event queue at once.
+ *
+ * This works like calling SDL_PushEvent() for each event in turn, but the
+ * event filter and watchers are run over the whole array in a single pass
+ * and the events are added to the queue while it is locked once, which is
+ * much cheaper when adding a large number of events.
+ *
+ * Events that are dropped by the event filter are skipped and aren't
+ * counted in the return value. The events are added in order, so if the
+ * queue fills up, the events at the end of the array are the ones that are
+ * lost, and the number of events that were added is returned. If the queue
+ * is already full, this function fails.
+ *
+ * Any events in `events` without a timestamp will have it set to the current
+ * time.
+ *
+ * \param events an array of events to be added to the queue.
+ * \param numevents the number of events in `events`.
+ * \returns the number of events added to the queue or -1 on failure; call
+ *          SDL_GetError() for more information. A common reason for error
+ *          is the event queue being full.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PushEvent
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PushEvents(SDL_Event *events, int numevents);
+
 /**
  * A function pointer used for callbacks that watch the event queue.
  *
@@ -1607,6 +1641,112 @@ extern SDL_DECLSPEC SDL_Window * SDLCALL SDL_GetWindowFromEvent(const SDL_Event
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetEventDescription(const SDL_Event *event, char *buf, int buflen);
 
+/**
+ * Get the number of input samples that were merged into a motion event.
+ *
+ * When SDL_HINT_EVENT_COALESCE_MOTION is enabled, a mouse, pen or finger
+ * motion event that arrives while the last queued event is motion from the
+ * same source is merged into that event instead of being queued separately.
+ * The merged event keeps the latest position and timestamp, and relative
+ * motion is accumulated.
+ *
+ * This is only meaningful for events retrieved from the event queue, e.g.
+ * with SDL_PollEvent(), SDL_WaitEvent() or SDL_PeepEvents(). Event watchers
+ * and filters see every sample as it arrives.
+ *
+ * The count is also available as the `samples` field of the motion event.
+ *
+ * \param event the event to query.
+ * \returns the number of samples in the event, which is 1 for events that
+ *          weren't merged and for events that aren't motion events.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetCoalescedEventCount(const SDL_Event *event);
+
+/**
+ * The stages of event delivery that latency is recorded for.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetEventLatencyHistogram
+ */
+typedef enum SDL_EventLatencyStage
+{
+    SDL_LATENCY_SOURCE_TO_QUEUE,    /**< From the event's timestamp to when it was added to the queue */
+    SDL_LATENCY_QUEUE_TO_POLL       /**< From when the event was added to the queue to when it was retrieved */
+} SDL_EventLatencyStage;
+
+/**
+ * The number of buckets in an SDL_EventLatencyHistogram.
+ *
+ * \since This macro is available since SDL 3.4.0.
+ */
+#define SDL_EVENT_LATENCY_BUCKETS 32
+
+/**
+ * A histogram of event latencies.
+ *
+ * Bucket 0 counts latencies of less than a microsecond, and bucket `n` counts
+ * latencies of at least `2^(n-1)` and less than `2^n` microseconds. The last
+ * bucket also counts anything longer than that.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetEventLatencyHistogram
+ */
+typedef struct SDL_EventLatencyHistogram
+{
+    Uint64 count;       /**< The number of events recorded */
+    Uint64 total_ns;    /**< The sum of the recorded latencies, in nanoseconds */
+    Uint64 max_ns;      /**< The longest recorded latency, in nanoseconds */
+    Uint64 buckets[SDL_EVENT_LATENCY_BUCKETS];  /**< The number of events in each latency range */
+} SDL_EventLatencyHistogram;
+
+/**
+ * Get the recorded latency of events of a given type.
+ *
+ * Latency is only recorded while SDL_HINT_EVENT_LATENCY_TRACING is enabled,
+ * for events retrieved from the event queue, e.g. with SDL_PollEvent(),
+ * SDL_WaitEvent() or SDL_PeepEvents() with SDL_GETEVENT.
+ *
+ * Input events are timestamped by the platform when the input happened, where
+ * it provides that, so SDL_LATENCY_SOURCE_TO_QUEUE includes the time spent
+ * in the operating system before SDL saw the event. Other events are
+ * timestamped when they are pushed, and add very little latency there.
+ *
+ * \param type the type of event to query, one of the values in SDL_EventType
+ *             or a user event type.
+ * \param stage the stage of event delivery to query.
+ * \param histogram filled in with the recorded latencies, which are all zero
+ *                  if nothing has been recorded for this type.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ResetEventLatencyHistograms
+ * \sa SDL_HINT_EVENT_LATENCY_TRACING
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetEventLatencyHistogram(Uint32 type, SDL_EventLatencyStage stage, SDL_EventLatencyHistogram *histogram);
+
+/**
+ * Clear the recorded latency of all event types.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetEventLatencyHistogram
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetEventLatencyHistograms(void);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
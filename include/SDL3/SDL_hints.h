@@ -432,6 +432,30 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DISK_TIMESCALE "SDL_AUDIO_DISK_TIMESCALE"
 
+/**
+ * A variable controlling whether the disk audio driver runs faster than
+ * real-time.
+ *
+ * This turns the disk audio driver into an offline renderer: playback devices
+ * don't wait between buffers, so audio is written to the output file as fast
+ * as the bound streams and callbacks can provide it, and recording devices
+ * deliver the input file as fast as it is consumed. Nothing is written or
+ * read while all of a device's streams are paused, and when a recording
+ * device reaches the end of its input file, it is reported as disconnected
+ * instead of providing silence forever.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Simulate real-time, adjusted by SDL_HINT_AUDIO_DISK_TIMESCALE.
+ *   (default)
+ * - "1": Run as fast as possible, SDL_HINT_AUDIO_DISK_TIMESCALE is ignored.
+ *
+ * This hint should be set before an audio device is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_DISK_OFFLINE "SDL_AUDIO_DISK_OFFLINE"
+
 /**
  * A variable that specifies an audio backend to use.
  *
@@ -812,6 +836,47 @@ extern "C" {
  */
 #define SDL_HINT_EVENT_LOGGING "SDL_EVENT_LOGGING"
 
+/**
+ * A variable controlling whether consecutive motion events are merged in the
+ * event queue.
+ *
+ * High rate mice, pens and touch screens can report motion thousands of times
+ * a second. With this enabled, a SDL_EVENT_MOUSE_MOTION, SDL_EVENT_PEN_MOTION
+ * or SDL_EVENT_FINGER_MOTION event is merged into the last queued event if
+ * that is motion from the same window and device, keeping the latest position
+ * and accumulating relative motion. Use SDL_GetCoalescedEventCount() to find
+ * out how many samples an event contains.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Every motion event is queued separately. (default)
+ * - "1": Consecutive motion events from the same source are merged.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
+/**
+ * A variable controlling whether the event queue records input latency.
+ *
+ * With this enabled, SDL keeps a histogram per event type of the time from
+ * an event's source timestamp to when it was queued, and of the time it then
+ * spent in the queue until the application retrieved it. Use
+ * SDL_GetEventLatencyHistogram() to read them.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Event latency isn't recorded. (default)
+ * - "1": Event latency is recorded.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_EVENT_LATENCY_TRACING "SDL_EVENT_LATENCY_TRACING"
+
 /**
  * A variable controlling whether raising the window should be done more
  * forcefully.
@@ -3338,6 +3403,24 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ * A variable controlling how many threads run timer callbacks.
+ *
+ * By default every timer callback is called on a single timer thread, so a
+ * slow callback delays all the other timers. If this is set to a number
+ * greater than zero, that many worker threads are created to call timer
+ * callbacks, and the timer thread only does the scheduling. Callbacks for
+ * different timers may then run at the same time, but a timer's callback is
+ * never called again until its previous call has returned.
+ *
+ * The default value is "0".
+ *
+ * This hint should be set before the first timer is added.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_TIMER_WORKER_THREADS "SDL_TIMER_WORKER_THREADS"
+
 /**
  * A variable controlling whether touch events should generate synthetic mouse
  * events.
@@ -43,6 +43,11 @@
  *   types.
  *
  * Properties can be removed from a group by using SDL_ClearProperty.
+ *
+ * Property names that are queried frequently, for example every frame, can
+ * be interned with SDL_InternString. Lookups using an interned name don't
+ * need to hash the string, and properties set after the name was interned
+ * are matched by comparing pointers.
  */
 
 
@@ -139,6 +144,10 @@ extern SDL_DECLSPEC bool SDLCALL SDL_CopyProperties(SDL_PropertiesID src, SDL_Pr
  * or want to guarantee that properties being queried aren't freed in another
  * thread.
  *
+ * Getting properties doesn't take the lock, so other threads can read
+ * properties while they are locked. If you need to read several properties
+ * that are set together, you should lock the properties while reading them.
+ *
  * \param props the properties to lock.
  * \returns true on success or false on failure; call SDL_GetError() for more
  *          information.
@@ -536,6 +545,41 @@ extern SDL_DECLSPEC bool SDLCALL SDL_EnumerateProperties(SDL_PropertiesID props,
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DestroyProperties(SDL_PropertiesID props);
 
+/**
+ * Get a shared, interned copy of a string.
+ *
+ * Every call with an equal string returns the same pointer, so interned
+ * strings can be compared by pointer instead of by content.
+ *
+ * Passing a name that was returned by this function to any of the property
+ * or hint functions skips hashing the name, and properties that are set
+ * after the name has been interned are stored under the interned copy, so
+ * looking them up only compares pointers. This is useful for names that are
+ * looked up frequently, for example every frame:
+ *
+ * ```c
+ * const char *vsync_name = SDL_InternString(SDL_PROP_RENDERER_VSYNC_NUMBER);
+ *
+ * while (running) {
+ *     Sint64 vsync = SDL_GetNumberProperty(props, vsync_name, 0);
+ *     ...
+ * }
+ * ```
+ *
+ * Interned strings are never freed individually, so this shouldn't be used
+ * for an unbounded set of strings.
+ *
+ * \param str the string to intern.
+ * \returns the interned copy of the string or NULL on failure; call
+ *          SDL_GetError() for more information. The string is valid until
+ *          SDL_Quit() is called.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC const char * SDLCALL SDL_InternString(const char *str);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
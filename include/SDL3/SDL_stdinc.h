@@ -1632,6 +1632,162 @@ extern SDL_DECLSPEC void SDLCALL SDL_aligned_free(void *mem);
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ * A linear allocator for short-lived memory.
+ *
+ * An arena hands out memory by bumping a pointer through large blocks, which
+ * is much cheaper than SDL_malloc(), and frees everything at once when it is
+ * reset. This suits memory that lives for a frame, or for a single call, like
+ * temporary strings and scratch buffers.
+ *
+ * Arenas are not thread-safe; use one per thread, or SDL_GetThreadArena().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateArena
+ * \sa SDL_GetThreadArena
+ */
+typedef struct SDL_Arena SDL_Arena;
+
+/**
+ * A position in an arena, used to free everything allocated after it.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetArenaMark
+ * \sa SDL_ResetArenaToMark
+ */
+typedef Uint64 SDL_ArenaMark;
+
+/**
+ * Create a linear allocator.
+ *
+ * Memory is obtained from SDL_malloc() in blocks of `block_size` bytes, or
+ * larger when a single allocation needs it. Blocks are kept for reuse when
+ * the arena is reset, and are only freed by SDL_DestroyArena().
+ *
+ * \param block_size the size of each block of memory, or 0 for a default of
+ *                   64 kilobytes.
+ * \returns a new arena or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AllocateArenaMemory
+ * \sa SDL_DestroyArena
+ */
+extern SDL_DECLSPEC SDL_Arena * SDLCALL SDL_CreateArena(size_t block_size);
+
+/**
+ * Allocate memory from an arena.
+ *
+ * The memory is not initialized, and stays valid until the arena is reset
+ * past it or destroyed. It must not be passed to SDL_free().
+ *
+ * \param arena the arena to allocate from.
+ * \param size the number of bytes to allocate.
+ * \param alignment the alignment of the memory, which must be a power of two,
+ *                  or 0 to use SDL_GetSIMDAlignment().
+ * \returns a pointer to the memory or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function is not thread safe; an arena should only be
+ *               used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetArenaMark
+ * \sa SDL_ResetArena
+ */
+extern SDL_DECLSPEC SDL_MALLOC void * SDLCALL SDL_AllocateArenaMemory(SDL_Arena *arena, size_t size, size_t alignment);
+
+/**
+ * Get the current position in an arena.
+ *
+ * Passing this to SDL_ResetArenaToMark() later frees everything allocated
+ * after this call, which allows nested users of the same arena.
+ *
+ * \param arena the arena to query.
+ * \returns the current position in the arena.
+ *
+ * \threadsafety This function is not thread safe; an arena should only be
+ *               used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ResetArenaToMark
+ */
+extern SDL_DECLSPEC SDL_ArenaMark SDLCALL SDL_GetArenaMark(SDL_Arena *arena);
+
+/**
+ * Free everything allocated from an arena after a mark.
+ *
+ * \param arena the arena to reset.
+ * \param mark a position previously returned by SDL_GetArenaMark(), which
+ *             hasn't been freed by an earlier reset.
+ *
+ * \threadsafety This function is not thread safe; an arena should only be
+ *               used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetArenaMark
+ * \sa SDL_ResetArena
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetArenaToMark(SDL_Arena *arena, SDL_ArenaMark mark);
+
+/**
+ * Free everything allocated from an arena.
+ *
+ * The arena keeps its blocks, so allocating the same amount of memory again
+ * won't call SDL_malloc().
+ *
+ * \param arena the arena to reset.
+ *
+ * \threadsafety This function is not thread safe; an arena should only be
+ *               used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ResetArenaToMark
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetArena(SDL_Arena *arena);
+
+/**
+ * Destroy an arena and free all of its memory.
+ *
+ * \param arena the arena to destroy, or NULL.
+ *
+ * \threadsafety This function is not thread safe; an arena should only be
+ *               used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateArena
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyArena(SDL_Arena *arena);
+
+/**
+ * Get an arena that belongs to the calling thread.
+ *
+ * The arena is created on first use and destroyed when the thread exits.
+ * Since it is shared by everything running on the thread, including SDL
+ * itself, callers should free what they allocate with SDL_GetArenaMark() and
+ * SDL_ResetArenaToMark() rather than resetting the whole arena.
+ *
+ * \returns the calling thread's arena or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AllocateArenaMemory
+ */
+extern SDL_DECLSPEC SDL_Arena * SDLCALL SDL_GetThreadArena(void);
+
 /**
  * A thread-safe set of environment variables
  *
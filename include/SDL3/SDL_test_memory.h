@@ -29,6 +29,7 @@
 #define SDL_test_memory_h_
 
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_iostream.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -57,6 +58,53 @@ void SDLCALL SDLTest_RandFillAllocations(void);
  */
 void SDLCALL SDLTest_LogAllocations(void);
 
+/**
+ * Start a sampling heap profiler
+ *
+ * Unlike SDLTest_TrackAllocations(), this only records a stack trace for
+ * about one allocation per `sample_interval` bytes allocated, so it's cheap
+ * enough to leave running in a long session to look for memory growth.
+ *
+ * Calling this again while the profiler is running discards the samples
+ * collected so far and starts over with the new interval.
+ *
+ * \param sample_interval the average number of bytes allocated between
+ *                        samples, or 0 for the default of 512 KB.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ */
+bool SDLCALL SDLTest_StartHeapProfiler(Uint32 sample_interval);
+
+/**
+ * Stop the sampling heap profiler and discard its samples
+ */
+void SDLCALL SDLTest_StopHeapProfiler(void);
+
+/**
+ * Attribute allocations made on the current thread to a named subsystem
+ *
+ * Allocations without a tag are attributed to an SDL subsystem based on
+ * the SDL functions in their stack trace, when symbols are available.
+ *
+ * \param tag the name of the subsystem, which must remain valid while the
+ *            profiler is running, or NULL to clear the tag.
+ */
+void SDLCALL SDLTest_SetHeapProfilerTag(const char *tag);
+
+/**
+ * Write the allocations that are still live to a stream as text
+ *
+ * The report contains the estimated live memory for each subsystem, followed
+ * by each allocation site ordered by its estimated live memory.
+ *
+ * \param dst the stream to write the profile to.
+ * \param closeio if true, calls SDL_CloseIO() on `dst` before returning, even
+ *                in the case of an error.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ */
+bool SDLCALL SDLTest_WriteHeapProfile(SDL_IOStream *dst, bool closeio);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
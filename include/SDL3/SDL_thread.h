@@ -229,6 +229,12 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThread(SDL_ThreadFunction fn,
  *   only parameter. Optional, defaults to NULL.
  * - `SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER`: the size, in bytes, of the new
  *   thread's stack. Optional, defaults to 0 (system-defined default).
+ * - `SDL_PROP_THREAD_CREATE_AFFINITY_STRING`: a list of logical CPUs the new
+ *   thread is allowed to run on, as comma-separated CPU numbers and ranges,
+ *   like "0-3,6". This is applied when the thread starts, before the entry
+ *   function is called, and is silently ignored if the platform doesn't
+ *   support thread affinity. Optional, defaults to NULL (any CPU). (Since SDL
+ *   3.4.0)
  *
  * SDL makes an attempt to report `SDL_PROP_THREAD_CREATE_NAME_STRING` to the
  * system, so that debuggers can display it. Not all platforms support this.
@@ -284,6 +290,7 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThreadWithProperties(SDL_Prop
 #define SDL_PROP_THREAD_CREATE_NAME_STRING                             "SDL.thread.create.name"
 #define SDL_PROP_THREAD_CREATE_USERDATA_POINTER                        "SDL.thread.create.userdata"
 #define SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER                        "SDL.thread.create.stacksize"
+#define SDL_PROP_THREAD_CREATE_AFFINITY_STRING                         "SDL.thread.create.affinity"
 
 /* end wiki documentation for macros that are meant to look like functions. */
 #endif
@@ -352,6 +359,7 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThreadWithPropertiesRuntime(S
 #define SDL_PROP_THREAD_CREATE_NAME_STRING                             "SDL.thread.create.name"
 #define SDL_PROP_THREAD_CREATE_USERDATA_POINTER                        "SDL.thread.create.userdata"
 #define SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER                        "SDL.thread.create.stacksize"
+#define SDL_PROP_THREAD_CREATE_AFFINITY_STRING                         "SDL.thread.create.affinity"
 #endif
 
 
@@ -416,6 +424,32 @@ extern SDL_DECLSPEC SDL_ThreadID SDLCALL SDL_GetThreadID(SDL_Thread *thread);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SetCurrentThreadPriority(SDL_ThreadPriority priority);
 
+/**
+ * Restrict the current thread to run on a set of logical CPUs.
+ *
+ * CPU numbers are the ones reported in SDL_CPUTopology, and range from 0 to
+ * one less than the highest CPU number on the system. The thread will only be
+ * scheduled on the listed CPUs until this is called again.
+ *
+ * This is useful for keeping latency-sensitive threads, like audio mixing or
+ * rendering, away from cores that are busy with other work, or for keeping a
+ * thread on the performance cores of a hybrid CPU. Most apps should let the
+ * system scheduler decide.
+ *
+ * Not all platforms support thread affinity, and some only support the first
+ * 64 CPUs. Be prepared for this to fail.
+ *
+ * \param cpus an array of logical CPU numbers.
+ * \param num_cpus the number of elements in `cpus`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetCPUTopology
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetCurrentThreadAffinity(const int *cpus, int num_cpus);
+
 /**
  * Wait for a thread to finish.
  *
@@ -569,6 +603,185 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetTLS(SDL_TLSID *id, const void *value, SD
  */
 extern SDL_DECLSPEC void SDLCALL SDL_CleanupTLS(void);
 
+/**
+ * A pool of worker threads that run jobs.
+ *
+ * Each worker keeps its own queue of jobs, and idle workers steal jobs from
+ * the others, so jobs that submit more jobs spread across the pool without
+ * contending on a single queue.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateThreadPool
+ */
+typedef struct SDL_ThreadPool SDL_ThreadPool;
+
+/**
+ * A set of jobs that can be waited on together.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateJobGroup
+ */
+typedef struct SDL_JobGroup SDL_JobGroup;
+
+/**
+ * The function run by a job.
+ *
+ * \param userdata the pointer passed to SDL_SubmitJob().
+ *
+ * \threadsafety This is called on one of the pool's worker threads, or on a
+ *               thread that is waiting for a job group.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+typedef void (SDLCALL *SDL_JobFunction)(void *userdata);
+
+/**
+ * The function run for each range of indices by SDL_ParallelFor().
+ *
+ * \param userdata the pointer passed to SDL_ParallelFor().
+ * \param start the first index to process.
+ * \param end one past the last index to process.
+ *
+ * \threadsafety This may be called on several threads at the same time, with
+ *               different ranges.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_ParallelFor
+ */
+typedef void (SDLCALL *SDL_ParallelForFunction)(void *userdata, int start, int end);
+
+/**
+ * Create a pool of worker threads.
+ *
+ * \param num_threads the number of worker threads, or 0 to use the number of
+ *                    logical CPU cores.
+ * \returns a new thread pool or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyThreadPool
+ * \sa SDL_CreateJobGroup
+ */
+extern SDL_DECLSPEC SDL_ThreadPool * SDLCALL SDL_CreateThreadPool(int num_threads);
+
+/**
+ * Destroy a pool of worker threads.
+ *
+ * This waits for all the jobs submitted to the pool to finish. Any job groups
+ * created for the pool must be destroyed first.
+ *
+ * \param pool the thread pool to destroy.
+ *
+ * \threadsafety This function must not be called from one of the pool's jobs.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateThreadPool
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyThreadPool(SDL_ThreadPool *pool);
+
+/**
+ * Create a job group.
+ *
+ * \param pool the thread pool that runs the group's jobs, or NULL to use a
+ *             pool shared with SDL, sized from the number of logical CPU
+ *             cores.
+ * \returns a new job group or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyJobGroup
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJobGroup
+ */
+extern SDL_DECLSPEC SDL_JobGroup * SDLCALL SDL_CreateJobGroup(SDL_ThreadPool *pool);
+
+/**
+ * Submit a job to run on a thread pool.
+ *
+ * Jobs may submit more jobs, to the same group or others. If no threads are
+ * available, the job is run before this function returns.
+ *
+ * \param group the job group the job belongs to.
+ * \param func the function to run.
+ * \param userdata a pointer that is passed to `func`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_WaitJobGroup
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SubmitJob(SDL_JobGroup *group, SDL_JobFunction func, void *userdata);
+
+/**
+ * Wait for all the jobs in a group to finish.
+ *
+ * The calling thread runs jobs from the pool while it waits, so this may be
+ * called from a job without tying up a worker.
+ *
+ * \param group the job group to wait for.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_WaitJobGroup(SDL_JobGroup *group);
+
+/**
+ * Destroy a job group.
+ *
+ * This waits for all the jobs in the group to finish.
+ *
+ * \param group the job group to destroy.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateJobGroup
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyJobGroup(SDL_JobGroup *group);
+
+/**
+ * Run a function over a range of indices, spread across a thread pool.
+ *
+ * The range from 0 to `count` is split into pieces of at least `grain`
+ * indices, which the pool's workers and the calling thread take in turn until
+ * the range is done. This returns when `func` has been called for every
+ * index.
+ *
+ * \param pool the thread pool to use, or NULL to use the pool shared with
+ *             SDL.
+ * \param count the number of indices to process.
+ * \param grain the smallest number of indices to pass to `func` at once, or 0
+ *              to pick one based on the number of threads.
+ * \param func the function to call for each range of indices.
+ * \param userdata a pointer that is passed to `func`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ParallelFor(SDL_ThreadPool *pool, int count, int grain, SDL_ParallelForFunction func, void *userdata);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
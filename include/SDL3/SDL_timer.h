@@ -340,7 +340,8 @@ typedef Uint32 (SDLCALL *SDL_TimerCallback)(void *userdata, SDL_TimerID timerID,
  * canceled and will be removed.
  *
  * The callback is run on a separate thread, and for short timeouts can
- * potentially be called before this function returns.
+ * potentially be called before this function returns. Callbacks of different
+ * timers run one at a time unless SDL_HINT_TIMER_WORKER_THREADS is set.
  *
  * Timers take into account the amount of time it took to execute the
  * callback. For example, if the callback took 250 ms to execute and returned
@@ -402,7 +403,8 @@ typedef Uint64 (SDLCALL *SDL_NSTimerCallback)(void *userdata, SDL_TimerID timerI
  * timer is canceled and will be removed.
  *
  * The callback is run on a separate thread, and for short timeouts can
- * potentially be called before this function returns.
+ * potentially be called before this function returns. Callbacks of different
+ * timers run one at a time unless SDL_HINT_TIMER_WORKER_THREADS is set.
  *
  * Timers take into account the amount of time it took to execute the
  * callback. For example, if the callback took 250 ns to execute and returned
@@ -54,6 +54,7 @@
 #include "render/SDL_sysrender.h"
 #include "sensor/SDL_sensor_c.h"
 #include "stdlib/SDL_getenv_c.h"
+#include "stdlib/SDL_malloc_c.h"
 #include "thread/SDL_thread_c.h"
 #include "tray/SDL_tray_utils.h"
 #include "video/SDL_pixels_c.h"
@@ -654,6 +655,24 @@ Uint32 SDL_WasInit(SDL_InitFlags flags)
     return initialized;
 }
 
+static void SDL_ReportMallocStatistics(void)
+{
+    SDL_MallocArenaStats stats;
+    int i;
+
+    if (!SDL_GetHintBoolean("SDL_MALLOC_STATISTICS", false)) {
+        return;
+    }
+
+    for (i = 0; SDL_GetMallocArenaStats(i, &stats); ++i) {
+        if (stats.footprint == 0) {
+            continue;
+        }
+        SDL_Log("SDL MALLOC: Arena %d: %" SDL_PRIu64 " bytes from the system, %d blocks allocated, %d remote frees, %d times contended",
+                i, (Uint64)stats.footprint, stats.allocations, stats.remote_frees, stats.contended);
+    }
+}
+
 void SDL_Quit(void)
 {
     SDL_bInMainQuit = true;
@@ -675,6 +694,7 @@ void SDL_Quit(void)
 
     SDL_QuitTimers();
     SDL_QuitAsyncIO();
+    SDL_QuitThreadPools();
 
     SDL_SetObjectsInvalid();
     SDL_AssertionsQuit();
@@ -688,6 +708,8 @@ void SDL_Quit(void)
      */
     SDL_memset(SDL_SubsystemRefCount, 0x0, sizeof(SDL_SubsystemRefCount));
 
+    SDL_ReportMallocStatistics();
+
     SDL_QuitLog();
     SDL_QuitHints();
     SDL_QuitProperties();
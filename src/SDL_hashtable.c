@@ -20,50 +20,208 @@
 */
 #include "SDL_internal.h"
 
+/* This is a "Swiss table": items are kept in an open addressed array, with a
+   separate array of control bytes, one per item. A control byte is either
+   EMPTY, DELETED, or the low 7 bits of the item's hash. Lookups load a group
+   of control bytes at a time and compare all of them against the hash bits
+   at once, using SSE2 or NEON where available, so keys are only compared for
+   items that are very likely to match.
+
+   Tables created threadsafe serialize changes with a mutex, but lookups
+   don't lock. Readers check a sequence number that is odd while the table
+   is being changed, and retry if it changed while they were looking. Since
+   readers may look at stale items while they do that, writers never free
+   anything a reader could reach: removed keys and values and replaced item
+   arrays are only released after waiting for the readers that were already
+   in the table to finish.
+*/
+
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define HASHTABLE_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define HASHTABLE_NEON
+#endif
+
+#define GROUP_WIDTH 16
+
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xFE
+
+#define IS_FULL(ctrl) (((ctrl) & 0x80) == 0)
+
 typedef struct SDL_HashItem
 {
-    // TODO: Splitting off values into a separate array might be more cache-friendly
     const void *key;
     const void *value;
     Uint32 hash;
-    Uint32 probe_len : 31;
-    Uint32 live : 1;
 } SDL_HashItem;
 
-// Must be a power of 2 >= sizeof(SDL_HashItem)
-#define MAX_HASHITEM_SIZEOF 32u
-SDL_COMPILE_TIME_ASSERT(sizeof_SDL_HashItem, sizeof(SDL_HashItem) <= MAX_HASHITEM_SIZEOF);
+// The items and control bytes are allocated together, so readers always see a matching set
+typedef struct SDL_HashTableData
+{
+    Uint32 hash_mask;
+    SDL_HashItem *items;
+    Uint8 *ctrl;  // The first GROUP_WIDTH control bytes are repeated at the end, so groups never wrap around
+} SDL_HashTableData;
 
 // Anything larger than this will cause integer overflows
-#define MAX_HASHTABLE_SIZE (0x80000000u / (MAX_HASHITEM_SIZEOF))
+#define MAX_HASHTABLE_SIZE 0x4000000u
 
 struct SDL_HashTable
 {
-    SDL_RWLock *lock;  // NULL if not created threadsafe
-    SDL_HashItem *table;
+    SDL_Mutex *lock;  // NULL if not created threadsafe
+    SDL_AtomicInt sequence;  // Odd while the table is being changed
+    SDL_AtomicInt readers;   // Readers looking at the table right now
+    SDL_HashTableData *data;
     SDL_HashCallback hash;
     SDL_HashKeyMatchCallback keymatch;
     SDL_HashDestroyCallback destroy;
     void *userdata;
-    Uint32 hash_mask;
-    Uint32 max_probe_len;
-    Uint32 num_occupied_slots;
+    Uint32 num_items;
+    Uint32 growth_left;  // The number of empty slots that can be filled before the table has to grow
 };
 
+/* Group matching: each function returns a mask with a bit set for each
+   matching control byte in the group. Use GroupMatchIndex() to get the
+   index of the lowest match and clear it with mask &= mask - 1. */
+#ifdef HASHTABLE_SSE2
+
+#define GROUP_MASK_SHIFT 0
+
+static SDL_INLINE Uint64 MatchGroupByte(const Uint8 *ctrl, Uint8 value)
+{
+    const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+}
+
+static SDL_INLINE Uint64 MatchGroupNotFull(const Uint8 *ctrl)
+{
+    return (Uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+#elif defined(HASHTABLE_NEON)
+
+// NEON doesn't have movemask, so narrow the comparison to 4 bits per byte and keep one of them
+#define GROUP_MASK_SHIFT 2
+
+static SDL_INLINE Uint64 NarrowGroupMask(uint8x16_t cmp)
+{
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull;
+}
+
+static SDL_INLINE Uint64 MatchGroupByte(const Uint8 *ctrl, Uint8 value)
+{
+    return NarrowGroupMask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(value)));
+}
+
+static SDL_INLINE Uint64 MatchGroupNotFull(const Uint8 *ctrl)
+{
+    return NarrowGroupMask(vtstq_u8(vld1q_u8(ctrl), vdupq_n_u8(0x80)));
+}
+
+#else
+
+#define GROUP_MASK_SHIFT 0
+
+static SDL_INLINE Uint64 MatchGroupByte(const Uint8 *ctrl, Uint8 value)
+{
+    Uint64 mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; ++i) {
+        if (ctrl[i] == value) {
+            mask |= ((Uint64)1 << i);
+        }
+    }
+    return mask;
+}
+
+static SDL_INLINE Uint64 MatchGroupNotFull(const Uint8 *ctrl)
+{
+    Uint64 mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; ++i) {
+        if (!IS_FULL(ctrl[i])) {
+            mask |= ((Uint64)1 << i);
+        }
+    }
+    return mask;
+}
+
+#endif
+
+static SDL_INLINE Uint64 MatchGroupEmpty(const Uint8 *ctrl)
+{
+    return MatchGroupByte(ctrl, CTRL_EMPTY);
+}
+
+static SDL_INLINE Uint32 GroupMatchIndex(Uint64 mask)
+{
+    const Uint32 low = (Uint32)mask;
+    int bit;
+
+    SDL_assert(mask != 0);
+    if (low) {
+        bit = SDL_MostSignificantBitIndex32(low & (~low + 1));
+    } else {
+        const Uint32 high = (Uint32)(mask >> 32);
+        bit = 32 + SDL_MostSignificantBitIndex32(high & (~high + 1));
+    }
+    return (Uint32)bit >> GROUP_MASK_SHIFT;
+}
+
+static SDL_INLINE Uint32 GroupLastMatchIndex(Uint64 mask)
+{
+    const Uint32 high = (Uint32)(mask >> 32);
+    int bit;
+
+    SDL_assert(mask != 0);
+    if (high) {
+        bit = 32 + SDL_MostSignificantBitIndex32(high);
+    } else {
+        bit = SDL_MostSignificantBitIndex32((Uint32)mask);
+    }
+    return (Uint32)bit >> GROUP_MASK_SHIFT;
+}
+
+// The low 7 bits go in the control byte and the rest choose where to start probing
+#define HASH_POSITION(hash) ((hash) >> 7)
+#define HASH_CTRL(hash)     ((Uint8)((hash) & 0x7F))
+
+// Tables are kept at most 7/8 full
+#define MAX_LOAD(num_buckets) ((num_buckets) - (num_buckets) / 8)
 
 static Uint32 CalculateHashBucketsFromEstimate(int estimated_capacity)
 {
     if (estimated_capacity <= 0) {
-        return 4;  // start small, grow as necessary.
+        return GROUP_WIDTH;  // start small, grow as necessary.
+    }
+
+    const Uint64 needed = ((Uint64)estimated_capacity * 8 + 6) / 7;
+    if (needed >= MAX_HASHTABLE_SIZE) {
+        return MAX_HASHTABLE_SIZE;
     }
 
-    const Uint32 estimated32 = (Uint32) estimated_capacity;
-    Uint32 buckets = ((Uint32) 1) << SDL_MostSignificantBitIndex32(estimated32);
-    if (!SDL_HasExactlyOneBitSet32(estimated32)) {
+    const Uint32 needed32 = (Uint32)needed;
+    Uint32 buckets = ((Uint32) 1) << SDL_MostSignificantBitIndex32(needed32);
+    if (!SDL_HasExactlyOneBitSet32(needed32)) {
         buckets <<= 1;  // need next power of two up to fit overflow capacity bits.
     }
 
-    return SDL_min(buckets, MAX_HASHTABLE_SIZE);
+    return SDL_max(buckets, GROUP_WIDTH);
+}
+
+static SDL_HashTableData *CreateHashTableData(Uint32 num_buckets)
+{
+    const size_t items_size = num_buckets * sizeof(SDL_HashItem);
+    SDL_HashTableData *data = (SDL_HashTableData *)SDL_malloc(sizeof(*data) + items_size + num_buckets + GROUP_WIDTH);
+    if (!data) {
+        return NULL;
+    }
+
+    data->hash_mask = num_buckets - 1;
+    data->items = (SDL_HashItem *)(data + 1);
+    data->ctrl = (Uint8 *)data->items + items_size;
+    SDL_memset(data->ctrl, CTRL_EMPTY, num_buckets + GROUP_WIDTH);
+    return data;
 }
 
 SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_HashCallback hash,
@@ -77,20 +235,20 @@ SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_
     }
 
     if (threadsafe) {
-        table->lock = SDL_CreateRWLock();
+        table->lock = SDL_CreateMutex();
         if (!table->lock) {
             SDL_DestroyHashTable(table);
             return NULL;
         }
     }
 
-    table->table = (SDL_HashItem *)SDL_calloc(num_buckets, sizeof(SDL_HashItem));
-    if (!table->table) {
+    table->data = CreateHashTableData(num_buckets);
+    if (!table->data) {
         SDL_DestroyHashTable(table);
         return NULL;
     }
 
-    table->hash_mask = num_buckets - 1;
+    table->growth_left = MAX_LOAD(num_buckets);
     table->userdata = userdata;
     table->hash = hash;
     table->keymatch = keymatch;
@@ -100,194 +258,194 @@ SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_
 
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    const Uint32 BitMixer = 0x9E3779B1u;
-    return table->hash(table->userdata, key) * BitMixer;
+    // Mix the hash so IDs and other weak hashes spread over both the position and control bits
+    Uint32 hash = table->hash(table->userdata, key);
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352Du;
+    hash ^= hash >> 15;
+    hash *= 0x846CA68Bu;
+    hash ^= hash >> 16;
+    return hash;
 }
 
-static SDL_INLINE Uint32 get_probe_length(Uint32 zero_idx, Uint32 actual_idx, Uint32 num_buckets)
+static SDL_INLINE void set_ctrl(SDL_HashTableData *data, Uint32 idx, Uint8 ctrl)
 {
-    // returns the probe sequence length from zero_idx to actual_idx
-    if (actual_idx < zero_idx) {
-        return num_buckets - zero_idx + actual_idx;
+    data->ctrl[idx] = ctrl;
+    if (idx < GROUP_WIDTH) {
+        data->ctrl[data->hash_mask + 1 + idx] = ctrl;
     }
-
-    return actual_idx - zero_idx;
 }
 
-static SDL_HashItem *find_item(const SDL_HashTable *ht, const void *key, Uint32 hash, Uint32 *i, Uint32 *probe_len)
+static SDL_HashItem *find_item(const SDL_HashTable *ht, const SDL_HashTableData *data, const void *key, Uint32 hash)
 {
-    Uint32 hash_mask = ht->hash_mask;
-    Uint32 max_probe_len = ht->max_probe_len;
-
-    SDL_HashItem *table = ht->table;
-
-    while (true) {
-        SDL_HashItem *item = table + *i;
-        Uint32 item_hash = item->hash;
-
-        if (!item->live) {
-            return NULL;
+    const Uint32 hash_mask = data->hash_mask;
+    const Uint32 num_groups = (hash_mask / GROUP_WIDTH) + 1;
+    const Uint8 ctrl = HASH_CTRL(hash);
+    Uint32 pos = HASH_POSITION(hash) & hash_mask;
+
+    // Probe a group at a time, stepping 1, 2, 3, ... groups further each time, which visits every group
+    for (Uint32 probe = 1; probe <= num_groups; ++probe) {
+        const Uint8 *group = data->ctrl + pos;
+        Uint64 match = MatchGroupByte(group, ctrl);
+
+        if (match) {
+            // Make sure we see the items that go with the control bytes
+            SDL_MemoryBarrierAcquire();
+
+            do {
+                SDL_HashItem *item = data->items + ((pos + GroupMatchIndex(match)) & hash_mask);
+                if (item->hash == hash && ht->keymatch(ht->userdata, item->key, key)) {
+                    return item;
+                }
+                match &= match - 1;
+            } while (match);
         }
 
-        if (item_hash == hash && ht->keymatch(ht->userdata, item->key, key)) {
-            return item;
+        if (MatchGroupEmpty(group)) {
+            return NULL;
         }
 
-        Uint32 item_probe_len = item->probe_len;
-        SDL_assert(item_probe_len == get_probe_length(item_hash & hash_mask, (Uint32)(item - table), hash_mask + 1));
+        pos = (pos + probe * GROUP_WIDTH) & hash_mask;
+    }
+    return NULL;
+}
 
-        if (*probe_len > item_probe_len) {
-            return NULL;
-        }
+// Find the first slot that a new item with this hash can go in
+static Uint32 find_insert_slot(const SDL_HashTableData *data, Uint32 hash)
+{
+    const Uint32 hash_mask = data->hash_mask;
+    Uint32 pos = HASH_POSITION(hash) & hash_mask;
 
-        if (++*probe_len > max_probe_len) {
-            return NULL;
+    for (Uint32 probe = 1;; ++probe) {
+        const Uint64 match = MatchGroupNotFull(data->ctrl + pos);
+        if (match) {
+            return (pos + GroupMatchIndex(match)) & hash_mask;
         }
-
-        *i = (*i + 1) & hash_mask;
+        pos = (pos + probe * GROUP_WIDTH) & hash_mask;
     }
 }
 
-static SDL_HashItem *find_first_item(const SDL_HashTable *ht, const void *key, Uint32 hash)
+static void insert_item(SDL_HashTableData *data, const void *key, const void *value, Uint32 hash, Uint32 idx)
 {
-    Uint32 i = hash & ht->hash_mask;
-    Uint32 probe_len = 0;
-    return find_item(ht, key, hash, &i, &probe_len);
+    SDL_HashItem *item = data->items + idx;
+    item->key = key;
+    item->value = value;
+    item->hash = hash;
+
+    // Readers that see the control byte need to see the item
+    SDL_MemoryBarrierRelease();
+    set_ctrl(data, idx, HASH_CTRL(hash));
 }
 
-static SDL_HashItem *insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *table, Uint32 hash_mask, Uint32 *max_probe_len_ptr)
+static void delete_item(SDL_HashTable *ht, SDL_HashItem *item)
 {
-    const Uint32 num_buckets = hash_mask + 1;
-    Uint32 idx = item_to_insert->hash & hash_mask;
-    SDL_HashItem *target = NULL;
-    SDL_HashItem temp_item;
-
-    while (true) {
-        SDL_HashItem *candidate = table + idx;
-
-        if (!candidate->live) {
-            // Found an empty slot. Put it here and we're done.
-            *candidate = *item_to_insert;
-
-            if (target == NULL) {
-                target = candidate;
-            }
-
-            const Uint32 probe_len = get_probe_length(candidate->hash & hash_mask, idx, num_buckets);
-            candidate->probe_len = probe_len;
-
-            if (*max_probe_len_ptr < probe_len) {
-                *max_probe_len_ptr = probe_len;
-            }
-
-            break;
-        }
-
-        const Uint32 candidate_probe_len = candidate->probe_len;
-        SDL_assert(candidate_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-        const Uint32 new_probe_len = get_probe_length(item_to_insert->hash & hash_mask, idx, num_buckets);
-
-        if (candidate_probe_len < new_probe_len) {
-            // Robin Hood hashing: the item at idx has a better probe length than our item would at this position.
-            // Evict it and put our item in its place, then continue looking for a new spot for the displaced item.
-            // This algorithm significantly reduces clustering in the table, making lookups take very few probes.
-
-            temp_item = *candidate;
-            *candidate = *item_to_insert;
+    SDL_HashTableData *data = ht->data;
+    const Uint32 hash_mask = data->hash_mask;
+    const Uint32 idx = (Uint32)(item - data->items);
+    const Uint64 empty_before = MatchGroupEmpty(data->ctrl + ((idx - GROUP_WIDTH) & hash_mask));
+    const Uint64 empty_after = MatchGroupEmpty(data->ctrl + idx);
+
+    SDL_assert(ht->num_items > 0);
+    ht->num_items--;
+
+    /* If there's an empty slot within a group's width on both sides, no lookup ever
+       probed past this slot, so it can be marked empty instead of deleted. */
+    if (empty_before && empty_after &&
+        ((GROUP_WIDTH - 1 - GroupLastMatchIndex(empty_before)) + GroupMatchIndex(empty_after)) < GROUP_WIDTH) {
+        set_ctrl(data, idx, CTRL_EMPTY);
+        ht->growth_left++;
+    } else {
+        set_ctrl(data, idx, CTRL_DELETED);
+    }
+}
 
-            if (target == NULL) {
-                target = candidate;
-            }
+// Move the items into a new array, which also clears out deleted slots
+static bool resize(SDL_HashTable *ht, Uint32 new_size, SDL_HashTableData **old_data)
+{
+    SDL_HashTableData *new_data = CreateHashTableData(new_size);
 
-            *item_to_insert = temp_item;
+    if (!new_data) {
+        return false;
+    }
 
-            SDL_assert(new_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-            candidate->probe_len = new_probe_len;
+    SDL_HashTableData *data = ht->data;
+    const Uint32 old_size = data->hash_mask + 1;
 
-            if (*max_probe_len_ptr < new_probe_len) {
-                *max_probe_len_ptr = new_probe_len;
-            }
+    for (Uint32 i = 0; i < old_size; ++i) {
+        if (IS_FULL(data->ctrl[i])) {
+            const SDL_HashItem *item = data->items + i;
+            insert_item(new_data, item->key, item->value, item->hash, find_insert_slot(new_data, item->hash));
         }
-
-        idx = (idx + 1) & hash_mask;
     }
 
-    return target;
+    ht->growth_left = MAX_LOAD(new_size) - ht->num_items;
+    SDL_SetAtomicPointer((void **)&ht->data, new_data);
+    *old_data = data;
+    return true;
 }
 
-static void delete_item(SDL_HashTable *ht, SDL_HashItem *item)
+static bool maybe_resize(SDL_HashTable *ht, SDL_HashTableData **old_data)
 {
-    const Uint32 hash_mask = ht->hash_mask;
-    SDL_HashItem *table = ht->table;
+    const Uint32 capacity = ht->data->hash_mask + 1;
 
-    if (ht->destroy) {
-        ht->destroy(ht->userdata, item->key, item->value);
+    if (ht->growth_left > 0) {
+        return true;
     }
 
-    SDL_assert(ht->num_occupied_slots > 0);
-    ht->num_occupied_slots--;
-
-    Uint32 idx = (Uint32)(item - ht->table);
-
-    while (true) {
-        idx = (idx + 1) & hash_mask;
-        SDL_HashItem *next_item = table + idx;
-
-        if (next_item->probe_len < 1) {
-            SDL_zerop(item);
-            return;
+    // Grow if the table is at least half full, otherwise it's full of deleted slots and just needs to be cleaned up
+    if (ht->num_items >= MAX_LOAD(capacity) / 2) {
+        if (capacity >= MAX_HASHTABLE_SIZE) {
+            return false;
         }
-
-        *item = *next_item;
-        item->probe_len -= 1;
-        SDL_assert(item->probe_len < ht->max_probe_len);
-        item = next_item;
+        return resize(ht, capacity * 2, old_data);
     }
+    return resize(ht, capacity, old_data);
 }
 
-static bool resize(SDL_HashTable *ht, Uint32 new_size)
+// Spin briefly, then give up the timeslice, the thread we're waiting for might not be running
+static void SpinWait(int *iterations)
 {
-    const Uint32 new_hash_mask = new_size - 1;
-    SDL_HashItem *new_table = SDL_calloc(new_size, sizeof(*new_table));
-
-    if (!new_table) {
-        return false;
+    if (*iterations < 32) {
+        ++*iterations;
+        SDL_CPUPauseInstruction();
+    } else {
+        SDL_Delay(0);
     }
+}
 
-    SDL_HashItem *old_table = ht->table;
-    const Uint32 old_size = ht->hash_mask + 1;
-
-    ht->max_probe_len = 0;
-    ht->hash_mask = new_hash_mask;
-    ht->table = new_table;
+static void LockHashTableForWriting(SDL_HashTable *table)
+{
+    if (table->lock) {
+        SDL_LockMutex(table->lock);
+        SDL_AddAtomicInt(&table->sequence, 1);
+    }
+}
 
-    for (Uint32 i = 0; i < old_size; ++i) {
-        SDL_HashItem *item = old_table + i;
-        if (item->live) {
-            insert_item(item, new_table, new_hash_mask, &ht->max_probe_len);
+// Wait until any readers that might be looking at removed items are done -- called while the table is being changed
+static void WaitForHashTableReaders(SDL_HashTable *table)
+{
+    if (table->lock) {
+        // Readers that come in now will see the odd sequence number and back off
+        int iterations = 0;
+        while (SDL_GetAtomicInt(&table->readers) > 0) {
+            SpinWait(&iterations);
         }
     }
-
-    SDL_free(old_table);
-    return true;
 }
 
-static bool maybe_resize(SDL_HashTable *ht)
+// Let readers back in, destroy callbacks should be called after this since they might look things up in the table
+static void FinishHashTableChanges(SDL_HashTable *table)
 {
-    const Uint32 capacity = ht->hash_mask + 1;
-
-    if (capacity >= MAX_HASHTABLE_SIZE) {
-        return false;
+    if (table->lock) {
+        SDL_AddAtomicInt(&table->sequence, 1);
     }
+}
 
-    const Uint32 max_load_factor = 217; // range: 0-255; 217 is roughly 85%
-    const Uint32 resize_threshold = (Uint32)((max_load_factor * (Uint64)capacity) >> 8);
-
-    if (ht->num_occupied_slots > resize_threshold) {
-        return resize(ht, capacity * 2);
+static void UnlockHashTableForWriting(SDL_HashTable *table)
+{
+    if (table->lock) {
+        SDL_UnlockMutex(table->lock);
     }
-
-    return true;
 }
 
 bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value, bool replace)
@@ -297,42 +455,110 @@ bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *
     }
 
     bool result = false;
+    bool replaced = false;
+    const void *old_key = NULL;
+    const void *old_value = NULL;
+    SDL_HashTableData *old_data = NULL;
 
-    SDL_LockRWLockForWriting(table->lock);
+    LockHashTableForWriting(table);
 
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
-    bool do_insert = true;
+    SDL_HashItem *item = find_item(table, table->data, key, hash);
 
     if (item) {
         if (replace) {
-            delete_item(table, item);
+            old_key = item->key;
+            old_value = item->value;
+            item->key = key;
+            item->value = value;
+            replaced = true;
+            result = true;
         } else {
             SDL_SetError("key already exists and replace is disabled");
-            do_insert = false;
         }
+    } else if (maybe_resize(table, &old_data)) {
+        SDL_HashTableData *data = table->data;
+        const Uint32 idx = find_insert_slot(data, hash);
+        if (data->ctrl[idx] == CTRL_EMPTY) {
+            table->growth_left--;
+        }
+        insert_item(data, key, value, hash, idx);
+        table->num_items++;
+        result = true;
     }
 
-    if (do_insert) {
-        SDL_HashItem new_item;
-        new_item.key = key;
-        new_item.value = value;
-        new_item.hash = hash;
-        new_item.live = true;
-        new_item.probe_len = 0;
+    if (replaced || old_data) {
+        WaitForHashTableReaders(table);
+    }
+    SDL_free(old_data);
+    FinishHashTableChanges(table);
 
-        table->num_occupied_slots++;
+    if (replaced && table->destroy) {
+        table->destroy(table->userdata, old_key, old_value);
+    }
 
-        if (!maybe_resize(table)) {
-            table->num_occupied_slots--;
-        } else {
-            // This never returns NULL
-            insert_item(&new_item, table->table, table->hash_mask, &table->max_probe_len);
+    UnlockHashTableForWriting(table);
+    return result;
+}
+
+static bool FindInHashTable(const SDL_HashTable *table, const void *key, const void **value, SDL_HashTableIterateCallback callback, void *userdata)
+{
+    const Uint32 hash = calc_hash(table, key);
+    const void *found_value = NULL;
+    bool result = false;
+
+    if (!table->lock) {
+        const SDL_HashItem *item = find_item(table, table->data, key, hash);
+        if (item) {
+            found_value = item->value;
             result = true;
+            if (callback) {
+                callback(userdata, table, item->key, item->value);
+            }
+        }
+    } else {
+        SDL_HashTable *ht = (SDL_HashTable *)table;
+
+        for (;;) {
+            SDL_AddAtomicInt(&ht->readers, 1);
+
+            const int sequence = SDL_GetAtomicInt(&ht->sequence);
+            if ((sequence & 1) == 0) {
+                const SDL_HashTableData *data = (const SDL_HashTableData *)SDL_GetAtomicPointer((void **)&ht->data);
+                const SDL_HashItem *item = find_item(table, data, key, hash);
+                const void *found_key = NULL;
+                if (item) {
+                    found_key = item->key;
+                    found_value = item->value;
+                    result = true;
+                } else {
+                    found_value = NULL;
+                    result = false;
+                }
+                SDL_MemoryBarrierAcquire();
+
+                if (SDL_GetAtomicInt(&ht->sequence) == sequence) {
+                    // Writers wait for us before removing anything, so the item stays valid until we're done
+                    if (result && callback) {
+                        callback(userdata, table, found_key, found_value);
+                    }
+                    SDL_AddAtomicInt(&ht->readers, -1);
+                    break;
+                }
+            }
+            SDL_AddAtomicInt(&ht->readers, -1);
+
+            // The table is being changed, wait for the writer to finish
+            int iterations = 0;
+            while (SDL_GetAtomicInt(&ht->sequence) == sequence) {
+                SpinWait(&iterations);
+            }
         }
     }
 
-    SDL_UnlockRWLock(table->lock);
+    if (value) {
+        *value = found_value;
+    }
     return result;
 }
 
@@ -345,21 +571,19 @@ bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForReading(table->lock);
+    return FindInHashTable(table, key, value, NULL, NULL);
+}
 
-    bool result = false;
-    const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *i = find_first_item(table, key, hash);
-    if (i) {
-        if (value) {
-            *value = i->value;
-        }
-        result = true;
+bool SDL_FindInHashTableWithCallback(const SDL_HashTable *table, const void *key, SDL_HashTableIterateCallback callback, void *userdata)
+{
+    CHECK_PARAM(!table) {
+        return SDL_InvalidParamError("table");
+    }
+    CHECK_PARAM(!callback) {
+        return SDL_InvalidParamError("callback");
     }
 
-    SDL_UnlockRWLock(table->lock);
-
-    return result;
+    return FindInHashTable(table, key, NULL, callback, userdata);
 }
 
 bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
@@ -368,17 +592,29 @@ bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForWriting(table->lock);
-
     bool result = false;
+    const void *old_key = NULL;
+    const void *old_value = NULL;
+
+    LockHashTableForWriting(table);
+
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
+    SDL_HashItem *item = find_item(table, table->data, key, hash);
     if (item) {
+        old_key = item->key;
+        old_value = item->value;
         delete_item(table, item);
+        WaitForHashTableReaders(table);
         result = true;
     }
 
-    SDL_UnlockRWLock(table->lock);
+    FinishHashTableChanges(table);
+
+    if (result && table->destroy) {
+        table->destroy(table->userdata, old_key, old_value);
+    }
+
+    UnlockHashTableForWriting(table);
     return result;
 }
 
@@ -391,21 +627,28 @@ bool SDL_IterateHashTable(const SDL_HashTable *table, SDL_HashTableIterateCallba
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockRWLockForReading(table->lock);
-    SDL_HashItem *end = table->table + (table->hash_mask + 1);
+    // Changes are locked out, but readers can still look things up while we iterate
+    if (table->lock) {
+        SDL_LockMutex(table->lock);
+    }
+
+    const SDL_HashTableData *data = table->data;
+    const Uint32 num_buckets = data->hash_mask + 1;
     Uint32 num_iterated = 0;
 
-    for (SDL_HashItem *item = table->table; item < end; item++) {
-        if (item->live) {
+    for (Uint32 i = 0; i < num_buckets && num_iterated < table->num_items; ++i) {
+        if (IS_FULL(data->ctrl[i])) {
+            const SDL_HashItem *item = data->items + i;
             if (!callback(userdata, table, item->key, item->value)) {
                 break;  // callback requested iteration stop.
-            } else if (++num_iterated >= table->num_occupied_slots) {
-                break;  // we can drop out early because we've seen all the live items.
             }
+            ++num_iterated;
         }
     }
 
-    SDL_UnlockRWLock(table->lock);
+    if (table->lock) {
+        SDL_UnlockMutex(table->lock);
+    }
     return true;
 }
 
@@ -415,23 +658,26 @@ bool SDL_HashTableEmpty(SDL_HashTable *table)
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForReading(table->lock);
-    const bool retval = (table->num_occupied_slots == 0);
-    SDL_UnlockRWLock(table->lock);
+    if (table->lock) {
+        SDL_LockMutex(table->lock);
+    }
+    const bool retval = (table->num_items == 0);
+    if (table->lock) {
+        SDL_UnlockMutex(table->lock);
+    }
     return retval;
 }
 
-
-static void destroy_all(SDL_HashTable *table)
+static void destroy_all(SDL_HashTable *table, SDL_HashTableData *data)
 {
     SDL_HashDestroyCallback destroy = table->destroy;
     if (destroy) {
         void *userdata = table->userdata;
-        SDL_HashItem *end = table->table + (table->hash_mask + 1);
-        for (SDL_HashItem *i = table->table; i < end; ++i) {
-            if (i->live) {
-                i->live = false;
-                destroy(userdata, i->key, i->value);
+        const Uint32 num_buckets = data->hash_mask + 1;
+        for (Uint32 i = 0; i < num_buckets; ++i) {
+            if (IS_FULL(data->ctrl[i])) {
+                const SDL_HashItem *item = data->items + i;
+                destroy(userdata, item->key, item->value);
             }
         }
     }
@@ -440,42 +686,86 @@ static void destroy_all(SDL_HashTable *table)
 void SDL_ClearHashTable(SDL_HashTable *table)
 {
     if (table) {
-        SDL_LockRWLockForWriting(table->lock);
+        SDL_HashTableData *data;
+
+        LockHashTableForWriting(table);
         {
-            destroy_all(table);
-            SDL_memset(table->table, 0, sizeof(*table->table) * (table->hash_mask + 1));
-            table->num_occupied_slots = 0;
+            data = table->data;
+
+            // Swap in an empty table so readers can't see the items while they're being destroyed
+            SDL_HashTableData *new_data = table->lock ? CreateHashTableData(data->hash_mask + 1) : NULL;
+            if (new_data) {
+                SDL_SetAtomicPointer((void **)&table->data, new_data);
+                WaitForHashTableReaders(table);
+            } else {
+                WaitForHashTableReaders(table);
+                destroy_all(table, data);
+                SDL_memset(data->ctrl, CTRL_EMPTY, data->hash_mask + 1 + GROUP_WIDTH);
+                data = NULL;
+            }
+            table->num_items = 0;
+            table->growth_left = MAX_LOAD(table->data->hash_mask + 1);
+        }
+        FinishHashTableChanges(table);
+
+        if (data) {
+            destroy_all(table, data);
+            SDL_free(data);
         }
-        SDL_UnlockRWLock(table->lock);
+        UnlockHashTableForWriting(table);
     }
 }
 
 void SDL_DestroyHashTable(SDL_HashTable *table)
 {
     if (table) {
-        destroy_all(table);
+        if (table->data) {
+            destroy_all(table, table->data);
+            SDL_free(table->data);
+        }
         if (table->lock) {
-            SDL_DestroyRWLock(table->lock);
+            SDL_DestroyMutex(table->lock);
         }
-        SDL_free(table->table);
         SDL_free(table);
     }
 }
 
-// this is djb's xor hashing function.
-static SDL_INLINE Uint32 hash_string_djbxor(const char *str, size_t len)
+// Hash a string a word at a time, mixing each word in with a multiply and a shift
+static SDL_INLINE Uint32 hash_string(const char *str, size_t len)
 {
-    Uint32 hash = 5381;
-    while (len--) {
-        hash = ((hash << 5) + hash) ^ *(str++);
+    const Uint64 multiplier = 0x9E3779B97F4A7C15ull;
+    Uint64 hash = len * multiplier;
+    Uint64 word;
+
+    while (len >= sizeof(word)) {
+        SDL_memcpy(&word, str, sizeof(word));
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 29;
+        str += sizeof(word);
+        len -= sizeof(word);
     }
-    return hash;
+    if (len > 0) {
+        word = 0;
+        SDL_memcpy(&word, str, len);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 29;
+    }
+
+    hash ^= hash >> 32;
+    hash *= 0xD6E8FEB86659FD93ull;
+    hash ^= hash >> 32;
+    return (Uint32)hash;
 }
 
 Uint32 SDL_HashPointer(void *unused, const void *key)
 {
+    Uint64 hash = (Uint64)(uintptr_t)key;
+
     (void)unused;
-    return SDL_murmur3_32(&key, sizeof(key), 0);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return (Uint32)hash;
 }
 
 bool SDL_KeyMatchPointer(void *unused, const void *a, const void *b)
@@ -488,7 +778,7 @@ Uint32 SDL_HashString(void *unused, const void *key)
 {
     (void)unused;
     const char *str = (const char *)key;
-    return hash_string_djbxor(str, SDL_strlen(str));
+    return hash_string(str, SDL_strlen(str));
 }
 
 bool SDL_KeyMatchString(void *unused, const void *a, const void *b)
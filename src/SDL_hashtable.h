@@ -60,12 +60,12 @@
  * iterate through all the items in the table (SDL_IterateHashTable).
  *
  * The underlying hash table implementation is always subject to change, but
- * at the time of writing, it uses open addressing and Robin Hood hashing.
- * The technical details are explained [here](https://github.com/libsdl-org/SDL/pull/10897).
+ * at the time of writing, it uses open addressing with a separate array of
+ * control bytes that are checked a group at a time (a "Swiss table").
  *
- * Hashtables keep an SDL_RWLock internally, so multiple threads can perform
- * hash lookups in parallel, while changes to the table will safely serialize
- * access between threads.
+ * Hashtables created threadsafe keep a mutex internally to serialize changes
+ * to the table, while hash lookups don't lock at all and run in parallel
+ * with each other and with changes.
  *
  * SDL provides a layer on top of this hash table implementation that might be
  * more pleasant to use. SDL_PropertiesID maps a string to arbitrary data of
@@ -218,11 +218,11 @@ typedef void (SDLCALL *SDL_HashDestroyCallback)(void *userdata, const void *key,
  * \param value the current value being iterated.
  * \returns true to keep iterating, false to stop iteration.
  *
- * \threadsafety A read lock is held during iteration, so other threads can
- *               still access the hash table, but threads attempting to make
- *               changes will be blocked until iteration completes. If this
- *               is a concern, do as little in the callback as possible and
- *               finish iteration quickly.
+ * \threadsafety Changes to the table are locked out during iteration, so
+ *               other threads can still look up items in the hash table,
+ *               but threads attempting to make changes will be blocked until
+ *               iteration completes. If this is a concern, do as little in
+ *               the callback as possible and finish iteration quickly.
  *
  * \since This datatype is available since SDL 3.4.0.
  *
@@ -258,9 +258,9 @@ typedef bool (SDLCALL *SDL_HashTableIterateCallback)(void *userdata, const SDL_H
  * table will start small and reallocate as necessary; often this is the
  * correct thing to do.
  *
- * !!! FIXME: add note about `threadsafe` here. And update `threadsafety` tags.
- * !!! FIXME: note that `threadsafe` tables can't be recursively locked, so
- * !!! FIXME:  you can't use `destroy` callbacks that might end up relocking.
+ * If `threadsafe` is true, lookups may happen while other threads change the
+ * table. Removed keys and values aren't passed to the `destroy` callback
+ * until no lookup can still be looking at them.
  *
  * Note that SDL provides a higher-level option built on its hash tables:
  * SDL_PropertiesID lets you map strings to various datatypes, and this
@@ -272,7 +272,7 @@ typedef bool (SDLCALL *SDL_HashTableIterateCallback)(void *userdata, const SDL_H
  *
  * \param estimated_capacity the approximate maximum number of items to be held
  *                           in the hash table, or 0 for no estimate.
- * \param threadsafe true to create an internal rwlock for this table.
+ * \param threadsafe true to allow the table to be used from multiple threads.
  * \param hash the function to use to hash keys.
  * \param keymatch the function to use to compare keys.
  * \param destroy the function to use to clean up keys and values, may be NULL.
@@ -360,6 +360,32 @@ extern bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const
  */
 extern bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **value);
 
+/**
+ * Look up an item in a hash table and call a function with it.
+ *
+ * In a thread-safe table, `callback` is called while the item is protected:
+ * it can't be removed or replaced, and so the destroy callback won't be
+ * called for it, until `callback` returns. This lets readers look at the
+ * data a value points to without taking any locks, as long as the table
+ * owns that data.
+ *
+ * `callback` is called at most once, and its return value is ignored. It
+ * must not change the table.
+ *
+ * \param table the hash table to search.
+ * \param key the key to search for in the table.
+ * \param callback the function to call with the item, if it's found.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true if key exists in the table, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_FindInHashTable
+ */
+extern bool SDL_FindInHashTableWithCallback(const SDL_HashTable *table, const void *key, SDL_HashTableIterateCallback callback, void *userdata);
+
 /**
  * Remove an item from a hash table.
  *
@@ -40,7 +40,18 @@ typedef struct SDL_Hint
     SDL_HintWatch *callbacks;
 } SDL_Hint;
 
+// What's known about the value of a cached hint
+#define SDL_CACHED_HINT_VALID       0x01    // The value has been cached
+#define SDL_CACHED_HINT_SET         0x02    // The hint has a value
+#define SDL_CACHED_HINT_NOT_EMPTY   0x04    // The value isn't an empty string
+#define SDL_CACHED_HINT_TRUE        0x08    // The value is true as a boolean
+#define SDL_CACHED_HINT_HAS_INTEGER 0x10    // The value is an integer
+
 static SDL_AtomicU32 SDL_hint_props;
+static SDL_SpinLock SDL_cached_hints_lock;
+static SDL_CachedHint *SDL_cached_hints;
+
+static void SDL_ResetCachedHints(void);
 
 
 void SDL_InitHints(void)
@@ -57,6 +68,9 @@ void SDL_QuitHints(void)
     if (props) {
         SDL_DestroyProperties(props);
     }
+
+    // The hint callbacks are gone, so the cached hints need to be looked up again
+    SDL_ResetCachedHints();
 }
 
 static SDL_PropertiesID GetHintProperties(bool create)
@@ -280,19 +294,31 @@ const char *SDL_GetHint(const char *name)
     return result;
 }
 
-int SDL_GetStringInteger(const char *value, int default_value)
+static bool ParseStringInteger(const char *value, int *result)
 {
     if (!value || !*value) {
-        return default_value;
+        return false;
     }
     if (SDL_strcasecmp(value, "false") == 0) {
-        return 0;
+        *result = 0;
+        return true;
     }
     if (SDL_strcasecmp(value, "true") == 0) {
-        return 1;
+        *result = 1;
+        return true;
     }
     if (*value == '-' || SDL_isdigit(*value)) {
-        return SDL_atoi(value);
+        *result = SDL_atoi(value);
+        return true;
+    }
+    return false;
+}
+
+int SDL_GetStringInteger(const char *value, int default_value)
+{
+    int result;
+    if (ParseStringInteger(value, &result)) {
+        return result;
     }
     return default_value;
 }
@@ -402,3 +428,125 @@ void SDL_RemoveHintCallback(const char *name, SDL_HintCallback callback, void *u
     SDL_UnlockProperties(hints);
 }
 
+/* This is called with the hints locked, so there's only one thread changing the value.
+   The values are stored before the flags, so a reader that sees the new flags sees the new values. */
+static void SDLCALL SDL_CachedHintChanged(void *userdata, const char *name, const char *oldValue, const char *newValue)
+{
+    SDL_CachedHint *hint = (SDL_CachedHint *)userdata;
+    int flags = SDL_CACHED_HINT_VALID;
+    int integer_value = 0;
+    float float_value = 0.0f;
+    Uint32 float_bits;
+
+    if (newValue) {
+        flags |= SDL_CACHED_HINT_SET;
+        if (*newValue) {
+            flags |= SDL_CACHED_HINT_NOT_EMPTY;
+            float_value = (float)SDL_atof(newValue);
+        }
+        if (SDL_GetStringBoolean(newValue, false)) {
+            flags |= SDL_CACHED_HINT_TRUE;
+        }
+        if (ParseStringInteger(newValue, &integer_value)) {
+            flags |= SDL_CACHED_HINT_HAS_INTEGER;
+        }
+    }
+    SDL_memcpy(&float_bits, &float_value, sizeof(float_bits));
+
+    SDL_SetAtomicInt(&hint->integer_value, integer_value);
+    SDL_SetAtomicU32(&hint->float_value, float_bits);
+    SDL_SetAtomicInt(&hint->flags, flags);
+}
+
+// Returns the flags for the current value, or 0 if the hint should be looked up directly
+static int SDL_GetCachedHintFlags(SDL_CachedHint *hint)
+{
+    int flags = SDL_GetAtomicInt(&hint->flags);
+    // The first caller adds a hint callback, which is called right away with
+    // the current value. Other threads look up the hint directly until then.
+    if (!flags && SDL_CompareAndSwapAtomicInt(&hint->watching, 0, 1)) {
+        if (SDL_AddHintCallback(hint->name, SDL_CachedHintChanged, hint)) {
+            SDL_LockSpinlock(&SDL_cached_hints_lock);
+            hint->next = SDL_cached_hints;
+            SDL_cached_hints = hint;
+            SDL_UnlockSpinlock(&SDL_cached_hints_lock);
+        } else {
+            SDL_SetAtomicInt(&hint->watching, 0);
+        }
+
+        flags = SDL_GetAtomicInt(&hint->flags);
+    }
+    return flags;
+}
+
+static void SDL_ResetCachedHints(void)
+{
+    SDL_LockSpinlock(&SDL_cached_hints_lock);
+    SDL_CachedHint *hint = SDL_cached_hints;
+    SDL_cached_hints = NULL;
+    SDL_UnlockSpinlock(&SDL_cached_hints_lock);
+
+    while (hint) {
+        SDL_CachedHint *next = hint->next;
+
+        SDL_SetAtomicInt(&hint->flags, 0);
+        hint->next = NULL;
+        SDL_SetAtomicInt(&hint->watching, 0);
+
+        hint = next;
+    }
+}
+
+bool SDL_IsCachedHintSet(SDL_CachedHint *hint)
+{
+    const int flags = SDL_GetCachedHintFlags(hint);
+    if (!flags) {
+        return SDL_GetHint(hint->name) != NULL;
+    }
+    return (flags & SDL_CACHED_HINT_SET) != 0;
+}
+
+bool SDL_GetCachedHintBoolean(SDL_CachedHint *hint, bool default_value)
+{
+    const int flags = SDL_GetCachedHintFlags(hint);
+    if (!flags) {
+        return SDL_GetHintBoolean(hint->name, default_value);
+    }
+    if (!(flags & SDL_CACHED_HINT_NOT_EMPTY)) {
+        return default_value;
+    }
+    return (flags & SDL_CACHED_HINT_TRUE) != 0;
+}
+
+int SDL_GetCachedHintInteger(SDL_CachedHint *hint, int default_value)
+{
+    const int flags = SDL_GetCachedHintFlags(hint);
+    if (!flags) {
+        return SDL_GetStringInteger(SDL_GetHint(hint->name), default_value);
+    }
+    if (!(flags & SDL_CACHED_HINT_HAS_INTEGER)) {
+        return default_value;
+    }
+    return SDL_GetAtomicInt(&hint->integer_value);
+}
+
+float SDL_GetCachedHintFloat(SDL_CachedHint *hint, float default_value)
+{
+    const int flags = SDL_GetCachedHintFlags(hint);
+    Uint32 float_bits;
+    float result;
+
+    if (!flags) {
+        const char *string = SDL_GetHint(hint->name);
+        if (!string || !*string) {
+            return default_value;
+        }
+        return (float)SDL_atof(string);
+    }
+    if (!(flags & SDL_CACHED_HINT_NOT_EMPTY)) {
+        return default_value;
+    }
+    float_bits = SDL_GetAtomicU32(&hint->float_value);
+    SDL_memcpy(&result, &float_bits, sizeof(result));
+    return result;
+}
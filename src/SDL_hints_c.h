@@ -30,4 +30,36 @@ extern bool SDL_GetStringBoolean(const char *value, bool default_value);
 extern int SDL_GetStringInteger(const char *value, int default_value);
 extern void SDL_QuitHints(void);
 
+/* A hint that is looked up once and then kept up to date with a hint
+   callback, for hints that are checked frequently, e.g. every frame or
+   for every event. These are declared statically:
+
+    static SDL_CachedHint allow_alt_tab = SDL_CACHED_HINT_INIT(SDL_HINT_ALLOW_ALT_TAB_WHILE_GRABBED);
+
+    if (SDL_GetCachedHintBoolean(&allow_alt_tab, true)) {
+        ...
+    }
+
+   The parsed value is stored atomically whenever the hint changes, so
+   reading it doesn't take any locks or allocate memory. Like other hint
+   callbacks, changes to environment variables after the hint is first read
+   aren't noticed.
+ */
+typedef struct SDL_CachedHint
+{
+    const char *name;
+    SDL_AtomicInt watching;         // Whether a hint callback is keeping the value up to date
+    SDL_AtomicInt flags;            // What's known about the current value, 0 until it's cached
+    SDL_AtomicInt integer_value;
+    SDL_AtomicU32 float_value;      // The bits of the float value
+    struct SDL_CachedHint *next;    // The list of cached hints that are in use
+} SDL_CachedHint;
+
+#define SDL_CACHED_HINT_INIT(name) { (name), { 0 }, { 0 }, { 0 }, { 0 }, NULL }
+
+extern bool SDL_IsCachedHintSet(SDL_CachedHint *hint);
+extern bool SDL_GetCachedHintBoolean(SDL_CachedHint *hint, bool default_value);
+extern int SDL_GetCachedHintInteger(SDL_CachedHint *hint, int default_value);
+extern float SDL_GetCachedHintFloat(SDL_CachedHint *hint, float default_value);
+
 #endif // SDL_hints_c_h_
@@ -0,0 +1,175 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_mempool.h"
+
+void SDL_InitMemoryPool(SDL_MemoryPool *pool, size_t block_size, int max_free, bool threadsafe)
+{
+    SDL_zerop(pool);
+
+    SDL_assert(block_size >= sizeof(void *));
+    pool->block_size = block_size;
+    pool->max_free = max_free;
+    pool->threadsafe = threadsafe;
+}
+
+static void LockMemoryPool(SDL_MemoryPool *pool)
+{
+    if (pool->threadsafe) {
+        SDL_LockSpinlock(&pool->lock);
+    }
+}
+
+static void UnlockMemoryPool(SDL_MemoryPool *pool)
+{
+    if (pool->threadsafe) {
+        SDL_UnlockSpinlock(&pool->lock);
+    }
+}
+
+// Add a block to the free list -- called with the pool locked
+static void PushFreeBlock(SDL_MemoryPool *pool, void *block)
+{
+    *(void **)block = pool->free_blocks;
+    pool->free_blocks = block;
+}
+
+// Take a block from the free list, reclaiming returned blocks if needed -- called with the pool locked
+static void *PopFreeBlock(SDL_MemoryPool *pool)
+{
+    void *block = pool->free_blocks;
+
+    if (!block && pool->threadsafe) {
+        block = SDL_SetAtomicPointer(&pool->returned_blocks, NULL);
+    }
+    if (block) {
+        pool->free_blocks = *(void **)block;
+    }
+    return block;
+}
+
+bool SDL_ReserveMemoryPoolBlocks(SDL_MemoryPool *pool, int num_blocks)
+{
+    for (; num_blocks > 0; --num_blocks) {
+        void *block = SDL_malloc(pool->block_size);
+        if (!block) {
+            return false;
+        }
+
+        LockMemoryPool(pool);
+        PushFreeBlock(pool, block);
+        UnlockMemoryPool(pool);
+        SDL_AddAtomicInt(&pool->num_free, 1);
+    }
+    return true;
+}
+
+void *SDL_AllocMemoryPoolBlock(SDL_MemoryPool *pool)
+{
+    void *block;
+    int in_use, high_water;
+
+    if (SDL_GetAtomicInt(&pool->num_free) > 0) {
+        LockMemoryPool(pool);
+        block = PopFreeBlock(pool);
+        UnlockMemoryPool(pool);
+    } else {
+        block = NULL;
+    }
+
+    if (block) {
+        SDL_AddAtomicInt(&pool->num_free, -1);
+    } else {
+        block = SDL_malloc(pool->block_size);
+        if (!block) {
+            return NULL;
+        }
+    }
+
+    in_use = SDL_AddAtomicInt(&pool->num_in_use, 1) + 1;
+    high_water = SDL_GetAtomicInt(&pool->high_water);
+    while (in_use > high_water) {
+        if (SDL_CompareAndSwapAtomicInt(&pool->high_water, high_water, in_use)) {
+            break;
+        }
+        high_water = SDL_GetAtomicInt(&pool->high_water);
+    }
+    return block;
+}
+
+void SDL_FreeMemoryPoolBlock(SDL_MemoryPool *pool, void *block)
+{
+    if (!block) {
+        return;
+    }
+
+    SDL_AddAtomicInt(&pool->num_in_use, -1);
+
+    if (SDL_AddAtomicInt(&pool->num_free, 1) >= pool->max_free) {
+        SDL_AddAtomicInt(&pool->num_free, -1);
+        SDL_free(block);
+        return;
+    }
+
+    if (pool->threadsafe) {
+        void *head;
+        do {
+            head = SDL_GetAtomicPointer(&pool->returned_blocks);
+            *(void **)block = head;
+        } while (!SDL_CompareAndSwapAtomicPointer(&pool->returned_blocks, head, block));
+    } else {
+        PushFreeBlock(pool, block);
+    }
+}
+
+void SDL_GetMemoryPoolStats(SDL_MemoryPool *pool, SDL_MemoryPoolStats *stats)
+{
+    stats->block_size = pool->block_size;
+    stats->num_free = SDL_GetAtomicInt(&pool->num_free);
+    stats->num_in_use = SDL_GetAtomicInt(&pool->num_in_use);
+    stats->high_water = SDL_GetAtomicInt(&pool->high_water);
+}
+
+void SDL_DestroyMemoryPool(SDL_MemoryPool *pool)
+{
+    void *block;
+
+    LockMemoryPool(pool);
+    block = pool->free_blocks;
+    pool->free_blocks = NULL;
+    UnlockMemoryPool(pool);
+
+    while (block) {
+        void *next = *(void **)block;
+        SDL_free(block);
+        SDL_AddAtomicInt(&pool->num_free, -1);
+        block = next;
+    }
+
+    block = SDL_SetAtomicPointer(&pool->returned_blocks, NULL);
+    while (block) {
+        void *next = *(void **)block;
+        SDL_free(block);
+        SDL_AddAtomicInt(&pool->num_free, -1);
+        block = next;
+    }
+}
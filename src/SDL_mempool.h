@@ -0,0 +1,70 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_mempool_h_
+#define SDL_mempool_h_
+
+/* A pool of fixed-size memory blocks, used for objects that are created and
+   destroyed at a high rate (event entries, timers, audio chunks, etc.)
+
+   Freed blocks are kept for reuse, up to max_free of them, and the rest are
+   returned to the system allocator.
+
+   A thread-safe pool may be used from any thread: freeing a block is a
+   lock-free push onto a list of returned blocks, and the allocating side
+   reclaims that whole list at once when it runs out of cached blocks. A pool
+   that isn't thread-safe must be protected by its owner. */
+
+typedef struct SDL_MemoryPool
+{
+    size_t block_size;
+    int max_free;
+    bool threadsafe;
+    SDL_SpinLock lock;          // Protects free_blocks in a thread-safe pool
+    void *free_blocks;
+    void *returned_blocks;      // Blocks freed into a thread-safe pool, pushed without the lock
+    SDL_AtomicInt num_free;     // Blocks on both lists
+    SDL_AtomicInt num_in_use;
+    SDL_AtomicInt high_water;   // The most blocks that have been in use at once
+} SDL_MemoryPool;
+
+typedef struct SDL_MemoryPoolStats
+{
+    size_t block_size;
+    int num_free;
+    int num_in_use;
+    int high_water;
+} SDL_MemoryPoolStats;
+
+// Statically initialize a pool, equivalent to calling SDL_InitMemoryPool()
+#define SDL_MEMORY_POOL_INITIALIZER(block_size, max_free, threadsafe) \
+    { (block_size), (max_free), (threadsafe), 0, NULL, NULL, { 0 }, { 0 }, { 0 } }
+
+extern void SDL_InitMemoryPool(SDL_MemoryPool *pool, size_t block_size, int max_free, bool threadsafe);
+extern bool SDL_ReserveMemoryPoolBlocks(SDL_MemoryPool *pool, int num_blocks);
+extern void *SDL_AllocMemoryPoolBlock(SDL_MemoryPool *pool);
+extern void SDL_FreeMemoryPoolBlock(SDL_MemoryPool *pool, void *block);
+extern void SDL_GetMemoryPoolStats(SDL_MemoryPool *pool, SDL_MemoryPoolStats *stats);
+
+// Free all the cached blocks. The pool may still be used afterwards.
+extern void SDL_DestroyMemoryPool(SDL_MemoryPool *pool);
+
+#endif // SDL_mempool_h_
@@ -36,12 +36,15 @@ typedef struct
         bool boolean_value;
     } value;
 
-    char *string_storage;
+    char *string_storage;   // Set atomically, since readers don't take the lock
 
     SDL_CleanupPropertyCallback cleanup;
     void *userdata;
 } SDL_Property;
 
+// Properties are looked up without taking the lock, using a thread-safe hash
+// table. Values are read in a callback while the table guarantees that the
+// property can't be removed and freed. The lock serializes changes.
 typedef struct
 {
     SDL_HashTable *props;
@@ -53,8 +56,69 @@ static SDL_HashTable *SDL_properties;
 static SDL_AtomicU32 SDL_last_properties_id;
 static SDL_AtomicU32 SDL_global_properties;
 
+// Interned strings are stored in chunks with their hash in front of them, so
+// names that were returned by SDL_InternString() can be recognized by their
+// address, and looked up without hashing the string. Properties are stored
+// under the interned name if there is one, so those lookups only compare
+// pointers. Other names are copied and freed with the property.
+typedef struct SDL_InternedHeader
+{
+    Uint32 hash;
+    Uint32 check;   // ~hash, to make sure this is the start of an interned string
+} SDL_InternedHeader;
+
+typedef struct SDL_InternedChunk
+{
+    char *start;
+    char *end;
+} SDL_InternedChunk;
+
+#define SDL_INTERNED_CHUNK_SIZE 4096
+
+static SDL_HashTable *SDL_interned_strings;
+static SDL_SpinLock SDL_interned_lock;
+static SDL_InternedChunk SDL_interned_chunks[32];   // each chunk is twice the size of the last one
+static SDL_AtomicInt SDL_num_interned_chunks;
+static char *SDL_interned_next;                     // free space in the last chunk, protected by SDL_interned_lock
+
 
-static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, bool cleanup)
+static const SDL_InternedHeader *SDL_GetInternedHeader(const char *str)
+{
+    const int num_chunks = SDL_GetAtomicInt(&SDL_num_interned_chunks);
+    for (int i = 0; i < num_chunks; ++i) {
+        const SDL_InternedChunk *chunk = &SDL_interned_chunks[i];
+        if ((uintptr_t)str >= (uintptr_t)(chunk->start + sizeof(SDL_InternedHeader)) && (uintptr_t)str < (uintptr_t)chunk->end) {
+            const SDL_InternedHeader *header = (const SDL_InternedHeader *)str - 1;
+            if (((uintptr_t)str % sizeof(SDL_InternedHeader)) == 0 && header->check == ~header->hash) {
+                return header;
+            }
+            break;
+        }
+    }
+    return NULL;
+}
+
+static Uint32 SDLCALL SDL_HashPropertyName(void *unused, const void *key)
+{
+    const SDL_InternedHeader *header = SDL_GetInternedHeader((const char *)key);
+    if (header) {
+        return header->hash;
+    }
+    return SDL_HashString(unused, key);
+}
+
+static void SDL_FreeInternedStrings(void)
+{
+    const int num_chunks = SDL_GetAtomicInt(&SDL_num_interned_chunks);
+    SDL_SetAtomicInt(&SDL_num_interned_chunks, 0);
+    for (int i = 0; i < num_chunks; ++i) {
+        SDL_free(SDL_interned_chunks[i].start);
+    }
+    SDL_zeroa(SDL_interned_chunks);
+    SDL_interned_next = NULL;
+}
+
+static void SDL_FreePropertyWithCleanup(const void *value, bool cleanup)
 {
     SDL_Property *property = (SDL_Property *)value;
     if (property) {
@@ -72,13 +136,20 @@ static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void
         }
         SDL_free(property->string_storage);
     }
-    SDL_free((void *)key);
     SDL_free((void *)value);
 }
 
+static void SDL_FreePropertyName(const void *key)
+{
+    if (!SDL_GetInternedHeader((const char *)key)) {
+        SDL_free((void *)key);
+    }
+}
+
 static void SDLCALL SDL_FreeProperty(void *data, const void *key, const void *value)
 {
-    SDL_FreePropertyWithCleanup(key, value, data, true);
+    SDL_FreePropertyName(key);
+    SDL_FreePropertyWithCleanup(value, true);
 }
 
 static void SDL_FreeProperties(SDL_Properties *properties)
@@ -97,7 +168,14 @@ bool SDL_InitProperties(void)
     }
 
     SDL_properties = SDL_CreateHashTable(0, true, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
-    const bool initialized = (SDL_properties != NULL);
+    SDL_interned_strings = SDL_CreateHashTable(0, true, SDL_HashPropertyName, SDL_KeyMatchString, NULL, NULL);
+    const bool initialized = (SDL_properties && SDL_interned_strings);
+    if (!initialized) {
+        SDL_DestroyHashTable(SDL_interned_strings);
+        SDL_interned_strings = NULL;
+        SDL_DestroyHashTable(SDL_properties);
+        SDL_properties = NULL;
+    }
     SDL_SetInitialized(&SDL_properties_init, initialized);
     return initialized;
 }
@@ -131,6 +209,11 @@ void SDL_QuitProperties(void)
     SDL_IterateHashTable(properties, FreeOneProperties, NULL);
     SDL_DestroyHashTable(properties);
 
+    // Nothing refers to the property names anymore, so free the interned strings
+    SDL_DestroyHashTable(SDL_interned_strings);
+    SDL_interned_strings = NULL;
+    SDL_FreeInternedStrings();
+
     SDL_SetInitialized(&SDL_properties_init, false);
 }
 
@@ -139,6 +222,93 @@ static bool SDL_CheckInitProperties(void)
     return SDL_InitProperties();
 }
 
+// Add a string to the interned string chunks, called with SDL_interned_lock held
+static const char *SDL_AddInternedString(const char *str)
+{
+    const size_t len = SDL_strlen(str) + 1;
+    const size_t size = sizeof(SDL_InternedHeader) + ((len + sizeof(SDL_InternedHeader) - 1) & ~(sizeof(SDL_InternedHeader) - 1));
+    const int num_chunks = SDL_GetAtomicInt(&SDL_num_interned_chunks);
+
+    if (!SDL_interned_next || (size_t)(SDL_interned_chunks[num_chunks - 1].end - SDL_interned_next) < size) {
+        if (num_chunks == (int)SDL_arraysize(SDL_interned_chunks)) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+
+        size_t chunk_size = SDL_INTERNED_CHUNK_SIZE;
+        if (num_chunks > 0) {
+            chunk_size = 2 * (size_t)(SDL_interned_chunks[num_chunks - 1].end - SDL_interned_chunks[num_chunks - 1].start);
+        }
+        chunk_size = SDL_max(chunk_size, size);
+
+        char *chunk = (char *)SDL_malloc(chunk_size);
+        if (!chunk) {
+            return NULL;
+        }
+        SDL_interned_chunks[num_chunks].start = chunk;
+        SDL_interned_chunks[num_chunks].end = chunk + chunk_size;
+        SDL_SetAtomicInt(&SDL_num_interned_chunks, num_chunks + 1);
+        SDL_interned_next = chunk;
+    }
+
+    SDL_InternedHeader *header = (SDL_InternedHeader *)SDL_interned_next;
+    char *interned = (char *)(header + 1);
+    header->hash = SDL_HashString(NULL, str);
+    header->check = ~header->hash;
+    SDL_memcpy(interned, str, len);
+    SDL_interned_next += size;
+
+    if (!SDL_InsertIntoHashTable(SDL_interned_strings, interned, interned, false)) {
+        // Give the space back, nobody else has seen it
+        SDL_interned_next -= size;
+        return NULL;
+    }
+    return interned;
+}
+
+const char *SDL_InternString(const char *str)
+{
+    CHECK_PARAM(!str) {
+        SDL_InvalidParamError("str");
+        return NULL;
+    }
+
+    if (SDL_GetInternedHeader(str)) {
+        return str;
+    }
+
+    if (!SDL_CheckInitProperties()) {
+        return NULL;
+    }
+
+    const char *interned = NULL;
+    if (!SDL_FindInHashTable(SDL_interned_strings, str, (const void **)&interned)) {
+        SDL_LockSpinlock(&SDL_interned_lock);
+        {
+            // Check again, somebody else may have interned it before we took the lock
+            if (!SDL_FindInHashTable(SDL_interned_strings, str, (const void **)&interned)) {
+                interned = SDL_AddInternedString(str);
+            }
+        }
+        SDL_UnlockSpinlock(&SDL_interned_lock);
+    }
+    return interned;
+}
+
+// Get the name to store a property under, the interned copy if there is one, otherwise a copy that's owned by the property
+static const char *SDL_GetPropertyName(const char *name)
+{
+    const char *interned = NULL;
+
+    if (SDL_GetInternedHeader(name)) {
+        return name;
+    }
+    if (SDL_FindInHashTable(SDL_interned_strings, name, (const void **)&interned)) {
+        return interned;
+    }
+    return SDL_strdup(name);
+}
+
 SDL_PropertiesID SDL_GetGlobalProperties(void)
 {
     SDL_PropertiesID props = SDL_GetAtomicU32(&SDL_global_properties);
@@ -170,7 +340,7 @@ SDL_PropertiesID SDL_CreateProperties(void)
         return 0;
     }
 
-    properties->props = SDL_CreateHashTable(0, false, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, NULL);
+    properties->props = SDL_CreateHashTable(0, true, SDL_HashPropertyName, SDL_KeyMatchString, SDL_FreeProperty, NULL);
     if (!properties->props) {
         SDL_DestroyMutex(properties->lock);
         SDL_free(properties);
@@ -213,35 +383,37 @@ static bool SDLCALL CopyOneProperty(void *userdata, const SDL_HashTable *table,
 
     CopyOnePropertyData *data = (CopyOnePropertyData *) userdata;
     SDL_Properties *dst_properties = data->dst_properties;
-    const char *src_name = (const char *)key;
+    const char *name;
     SDL_Property *dst_property;
 
-    char *dst_name = SDL_strdup(src_name);
-    if (!dst_name) {
+    name = SDL_GetPropertyName((const char *)key);
+    if (!name) {
         data->result = false;
         return true; // keep iterating (I guess...?)
     }
 
     dst_property = (SDL_Property *)SDL_malloc(sizeof(*dst_property));
     if (!dst_property) {
-        SDL_free(dst_name);
+        SDL_FreePropertyName(name);
         data->result = false;
         return true; // keep iterating (I guess...?)
     }
 
     SDL_copyp(dst_property, src_property);
+    dst_property->string_storage = NULL;
     if (src_property->type == SDL_PROPERTY_TYPE_STRING) {
         dst_property->value.string_value = SDL_strdup(src_property->value.string_value);
         if (!dst_property->value.string_value) {
-            SDL_free(dst_name);
+            SDL_FreePropertyName(name);
             SDL_free(dst_property);
             data->result = false;
             return true; // keep iterating (I guess...?)
         }
     }
 
-    if (!SDL_InsertIntoHashTable(dst_properties->props, dst_name, dst_property, true)) {
-        SDL_FreePropertyWithCleanup(dst_name, dst_property, NULL, false);
+    if (!SDL_InsertIntoHashTable(dst_properties->props, name, dst_property, true)) {
+        SDL_FreePropertyName(name);
+        SDL_FreePropertyWithCleanup(dst_property, false);
         data->result = false;
     }
 
@@ -322,27 +494,35 @@ static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL
     bool result = true;
 
     CHECK_PARAM(!props) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        SDL_FreePropertyWithCleanup(property, true);
         return SDL_InvalidParamError("props");
     }
     CHECK_PARAM(!name || !*name) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        SDL_FreePropertyWithCleanup(property, true);
         return SDL_InvalidParamError("name");
     }
 
     SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
     CHECK_PARAM(!properties) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        SDL_FreePropertyWithCleanup(property, true);
         return SDL_InvalidParamError("props");
     }
 
+    if (property) {
+        name = SDL_GetPropertyName(name);
+        if (!name) {
+            SDL_FreePropertyWithCleanup(property, true);
+            return false;
+        }
+    }
+
     SDL_LockMutex(properties->lock);
     {
         SDL_RemoveFromHashTable(properties->props, name);
         if (property) {
-            char *key = SDL_strdup(name);
-            if (!key || !SDL_InsertIntoHashTable(properties->props, key, property, false)) {
-                SDL_FreePropertyWithCleanup(key, property, NULL, true);
+            if (!SDL_InsertIntoHashTable(properties->props, name, property, false)) {
+                SDL_FreePropertyName(name);
+                SDL_FreePropertyWithCleanup(property, true);
                 result = false;
             }
         }
@@ -368,7 +548,7 @@ bool SDL_SetPointerPropertyWithCleanup(SDL_PropertiesID props, const char *name,
         if (cleanup) {
             cleanup(userdata, value);
         }
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, false);
+        SDL_FreePropertyWithCleanup(property, false);
         return false;
     }
     property->type = SDL_PROPERTY_TYPE_POINTER;
@@ -476,6 +656,15 @@ bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
     return (SDL_GetPropertyType(props, name) != SDL_PROPERTY_TYPE_INVALID);
 }
 
+static bool SDLCALL SDL_GetPropertyTypeCallback(void *userdata, const SDL_HashTable *table, const void *key, const void *item)
+{
+    const SDL_Property *property = (const SDL_Property *)item;
+    SDL_PropertyType *type = (SDL_PropertyType *)userdata;
+
+    *type = property->type;
+    return true;
+}
+
 SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
     SDL_Properties *properties = NULL;
@@ -493,18 +682,22 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            type = property->type;
-        }
-    }
-    SDL_UnlockMutex(properties->lock);
+    SDL_FindInHashTableWithCallback(properties->props, name, SDL_GetPropertyTypeCallback, &type);
 
     return type;
 }
 
+static bool SDLCALL SDL_GetPointerPropertyCallback(void *userdata, const SDL_HashTable *table, const void *key, const void *item)
+{
+    const SDL_Property *property = (const SDL_Property *)item;
+    void **value = (void **)userdata;
+
+    if (property->type == SDL_PROPERTY_TYPE_POINTER) {
+        *value = property->value.pointer_value;
+    }
+    return true;
+}
+
 void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
 {
     SDL_Properties *properties = NULL;
@@ -522,21 +715,63 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
         return value;
     }
 
-    // Note that taking the lock here only guarantees that we won't read the
-    // hashtable while it's being modified. The value itself can easily be
-    // freed from another thread after it is returned here.
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            if (property->type == SDL_PROPERTY_TYPE_POINTER) {
-                value = property->value.pointer_value;
-            }
+    // Note that this only guarantees that the property isn't freed while we
+    // look at it. The value itself can easily be freed from another thread
+    // after it is returned here.
+    SDL_FindInHashTableWithCallback(properties->props, name, SDL_GetPointerPropertyCallback, &value);
+
+    return value;
+}
+
+// Get the string form of a number or float property, which is created the first time it's needed
+static const char *SDL_GetPropertyStringStorage(SDL_Property *property)
+{
+    char *string = (char *)SDL_GetAtomicPointer((void **)&property->string_storage);
+    if (!string) {
+        int result;
+        if (property->type == SDL_PROPERTY_TYPE_NUMBER) {
+            result = SDL_asprintf(&string, "%" SDL_PRIs64, property->value.number_value);
+        } else {
+            result = SDL_asprintf(&string, "%f", property->value.float_value);
+        }
+        if (result < 0) {
+            return NULL;
+        }
+
+        if (!SDL_CompareAndSwapAtomicPointer((void **)&property->string_storage, NULL, string)) {
+            // Another reader got here first, use theirs
+            SDL_free(string);
+            string = (char *)SDL_GetAtomicPointer((void **)&property->string_storage);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    return string;
+}
 
-    return value;
+static bool SDLCALL SDL_GetStringPropertyCallback(void *userdata, const SDL_HashTable *table, const void *key, const void *item)
+{
+    SDL_Property *property = (SDL_Property *)item;
+    const char **value = (const char **)userdata;
+
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = property->value.string_value;
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+    case SDL_PROPERTY_TYPE_FLOAT:
+        {
+            const char *string = SDL_GetPropertyStringStorage(property);
+            if (string) {
+                *value = string;
+            }
+        }
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = property->value.boolean_value ? "true" : "false";
+        break;
+    default:
+        break;
+    }
+    return true;
 }
 
 const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
@@ -556,47 +791,35 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = property->value.string_value;
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%" SDL_PRIs64, property->value.number_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
-                }
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
-                }
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value ? "true" : "false";
-                break;
-            default:
-                break;
-            }
-        }
-    }
-    SDL_UnlockMutex(properties->lock);
+    SDL_FindInHashTableWithCallback(properties->props, name, SDL_GetStringPropertyCallback, &value);
 
     return value;
 }
 
+static bool SDLCALL SDL_GetNumberPropertyCallback(void *userdata, const SDL_HashTable *table, const void *key, const void *item)
+{
+    const SDL_Property *property = (const SDL_Property *)item;
+    Sint64 *value = (Sint64 *)userdata;
+
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = (Sint64)SDL_strtoll(property->value.string_value, NULL, 0);
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        *value = property->value.number_value;
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        *value = (Sint64)SDL_round((double)property->value.float_value);
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = property->value.boolean_value;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
 Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
 {
     SDL_Properties *properties = NULL;
@@ -614,33 +837,35 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = (Sint64)SDL_strtoll(property->value.string_value, NULL, 0);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = property->value.number_value;
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = (Sint64)SDL_round((double)property->value.float_value);
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value;
-                break;
-            default:
-                break;
-            }
-        }
-    }
-    SDL_UnlockMutex(properties->lock);
+    SDL_FindInHashTableWithCallback(properties->props, name, SDL_GetNumberPropertyCallback, &value);
 
     return value;
 }
 
+static bool SDLCALL SDL_GetFloatPropertyCallback(void *userdata, const SDL_HashTable *table, const void *key, const void *item)
+{
+    const SDL_Property *property = (const SDL_Property *)item;
+    float *value = (float *)userdata;
+
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = (float)SDL_atof(property->value.string_value);
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        *value = (float)property->value.number_value;
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        *value = property->value.float_value;
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = (float)property->value.boolean_value;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
 float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
 {
     SDL_Properties *properties = NULL;
@@ -658,33 +883,35 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = (float)SDL_atof(property->value.string_value);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = (float)property->value.number_value;
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = property->value.float_value;
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = (float)property->value.boolean_value;
-                break;
-            default:
-                break;
-            }
-        }
-    }
-    SDL_UnlockMutex(properties->lock);
+    SDL_FindInHashTableWithCallback(properties->props, name, SDL_GetFloatPropertyCallback, &value);
 
     return value;
 }
 
+static bool SDLCALL SDL_GetBooleanPropertyCallback(void *userdata, const SDL_HashTable *table, const void *key, const void *item)
+{
+    const SDL_Property *property = (const SDL_Property *)item;
+    bool *value = (bool *)userdata;  // holds the default value on entry
+
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = SDL_GetStringBoolean(property->value.string_value, *value);
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        *value = (property->value.number_value != 0);
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        *value = (property->value.float_value != 0.0f);
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = property->value.boolean_value;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
 bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value)
 {
     SDL_Properties *properties = NULL;
@@ -702,29 +929,7 @@ bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool defau
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = SDL_GetStringBoolean(property->value.string_value, default_value);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = (property->value.number_value != 0);
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = (property->value.float_value != 0.0f);
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value;
-                break;
-            default:
-                break;
-            }
-        }
-    }
-    SDL_UnlockMutex(properties->lock);
+    SDL_FindInHashTableWithCallback(properties->props, name, SDL_GetBooleanPropertyCallback, &value);
 
     return value;
 }
@@ -588,6 +588,7 @@ static void DestroyPhysicalAudioDevice(SDL_AudioDevice *device)
 
     SDL_UnlockMutex(device->lock);  // don't use ReleaseAudioDevice because we don't want to change refcounts while destroying.
 
+    SDL_DestroyProperties(device->props);
     SDL_DestroyMutex(device->lock);
     SDL_DestroyCondition(device->close_cond);
     SDL_free(device->work_buffer);
@@ -1142,6 +1143,54 @@ static void MixFloat32Audio(float *dst, const float *src, const int buffer_size)
 }
 
 
+// How long one device buffer lasts, in nanoseconds. Zero if the device format isn't set up yet.
+static Uint64 GetAudioDeviceBufferPeriodNS(const SDL_AudioDevice *device)
+{
+    if ((device->spec.freq <= 0) || (device->sample_frames <= 0)) {
+        return 0;
+    }
+    return ((Uint64) device->sample_frames * SDL_NS_PER_SECOND) / (Uint64) device->spec.freq;
+}
+
+// Call this at the start of an iteration of a device thread, while holding the device lock.
+static Uint64 BeginAudioDeviceStats(SDL_AudioDevice *device)
+{
+    SDL_AudioDeviceStats *stats = &device->stats;
+    const Uint64 now = SDL_GetTicksNS();
+    const Uint64 period_ns = GetAudioDeviceBufferPeriodNS(device);
+    if (stats->last_iterate_ns && period_ns) {
+        if ((now - stats->last_iterate_ns) > (period_ns + (period_ns / 2))) {
+            stats->late_wakeups++;
+        }
+    }
+    stats->last_iterate_ns = now;
+    return now;
+}
+
+// Call this at the end of an iteration of a device thread, while holding the device lock.
+static void EndAudioDeviceStats(SDL_AudioDevice *device, Uint64 start_ns, int bytes, bool underrun)
+{
+    SDL_AudioDeviceStats *stats = &device->stats;
+    const Uint64 elapsed_ns = SDL_GetTicksNS() - start_ns;
+    const Uint64 period_ns = GetAudioDeviceBufferPeriodNS(device);
+    int bucket = SDL_AUDIO_ITERATE_HISTOGRAM_BUCKETS - 1;
+
+    if (period_ns) {
+        bucket = (int) SDL_min((elapsed_ns * (SDL_AUDIO_ITERATE_HISTOGRAM_BUCKETS - 1)) / period_ns, (Uint64) (SDL_AUDIO_ITERATE_HISTOGRAM_BUCKETS - 1));
+    }
+
+    stats->iterations++;
+    stats->iterate_histogram[bucket]++;
+    stats->iterate_max_ns = SDL_max(stats->iterate_max_ns, elapsed_ns);
+    if (underrun) {
+        stats->underruns++;
+    }
+    if (bytes > 0) {
+        stats->bytes_processed += (Uint64) bytes;
+    }
+}
+
+
 // Playback device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
 void SDL_PlaybackAudioThreadSetup(SDL_AudioDevice *device)
@@ -1161,7 +1210,9 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 start_ns = BeginAudioDeviceStats(device);
     bool failed = false;
+    bool underrun = false;
     int buffer_size = device->buffer_size;
     Uint8 *device_buffer = device->GetDeviceBuf(device, &buffer_size);
     if (buffer_size == 0) {
@@ -1187,6 +1238,7 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                 SDL_memset(device_buffer, device->silence_value, buffer_size);  // just supply silence to the device before we die.
             } else if (br < buffer_size) {
                 SDL_memset(device_buffer + br, device->silence_value, buffer_size - br);  // silence whatever we didn't write to.
+                underrun = !SDL_GetAtomicInt(&logdev->paused);
             }
 
             // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
@@ -1233,7 +1285,13 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                     if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
                         failed = true;
                         break;
-                    } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
+                    }
+
+                    if (br < work_buffer_size) {
+                        underrun = true;  // this stream is going to have a gap in it.
+                    }
+
+                    if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
                         // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
                         if (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap)) {
                             ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), device->work_buffer, device->spec.format, device->spec.channels, NULL,
@@ -1264,6 +1322,8 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         }
     }
 
+    EndAudioDeviceStats(device, start_ns, buffer_size, underrun);
+
     SDL_UnlockMutex(device->lock);
 
     if (failed) {
@@ -1323,13 +1383,16 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 start_ns = BeginAudioDeviceStats(device);
     bool failed = false;
+    int recorded = 0;
 
     if (!device->logical_devices) {
         device->FlushRecording(device); // nothing wants data, dump anything pending.
     } else {
         // this SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitRecordingDevice!
         int br = device->RecordDevice(device, device->work_buffer, device->buffer_size);
+        recorded = br;
         if (br < 0) {  // uhoh, device failed for some reason!
             failed = true;
         } else if (br > 0) {  // queue the new data to each bound stream.
@@ -1385,6 +1448,8 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         }
     }
 
+    EndAudioDeviceStats(device, start_ns, recorded, false);
+
     SDL_UnlockMutex(device->lock);
 
     if (failed) {
@@ -1594,6 +1659,36 @@ bool SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec, int
     return result;
 }
 
+SDL_PropertiesID SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid)
+{
+    SDL_PropertiesID result = 0;
+    SDL_AudioDevice *device = ObtainPhysicalAudioDeviceDefaultAllowed(devid);
+    if (device) {
+        if (device->props == 0) {
+            device->props = SDL_CreateProperties();
+        }
+
+        result = device->props;
+        if (result) {
+            const SDL_AudioDeviceStats *stats = &device->stats;
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_BUFFER_PERIOD_NS_NUMBER, (Sint64) GetAudioDeviceBufferPeriodNS(device));
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_ITERATIONS_NUMBER, (Sint64) stats->iterations);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_ITERATE_UNDER_25_PERCENT_NUMBER, (Sint64) stats->iterate_histogram[0]);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_ITERATE_UNDER_50_PERCENT_NUMBER, (Sint64) stats->iterate_histogram[1]);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_ITERATE_UNDER_75_PERCENT_NUMBER, (Sint64) stats->iterate_histogram[2]);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_ITERATE_UNDER_100_PERCENT_NUMBER, (Sint64) stats->iterate_histogram[3]);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_ITERATE_OVER_100_PERCENT_NUMBER, (Sint64) stats->iterate_histogram[4]);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_ITERATE_MAX_NS_NUMBER, (Sint64) stats->iterate_max_ns);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_UNDERRUNS_NUMBER, (Sint64) stats->underruns);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_LATE_WAKEUPS_NUMBER, (Sint64) stats->late_wakeups);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_BYTES_PROCESSED_NUMBER, (Sint64) stats->bytes_processed);
+        }
+    }
+    ReleaseAudioDevice(device);
+
+    return result;
+}
+
 int *SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count)
 {
     int *result = NULL;
@@ -1802,6 +1897,8 @@ static bool OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
 
     SDL_UpdatedAudioDeviceFormat(device);  // in case the backend changed things and forgot to call this.
 
+    SDL_zero(device->stats);  // statistics cover the current open of the physical device.
+
     // Allocate a scratch audio buffer
     device->work_buffer = (Uint8 *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), device->work_buffer_size);
     if (!device->work_buffer) {
@@ -99,6 +99,262 @@ static void SDL_TARGETING("sse") SDL_ConvertMonoToStereo_SSE(float *dst, const f
 // Include the autogenerated channel converters...
 #include "SDL_audio_channel_converters.h"
 
+/* SIMD versions of the most common surround up and downmixes. These work on two
+   sample frames at a time, use the same coefficients in the same order as the
+   generated scalar converters above, and hand any leftover frames to them. */
+
+#ifdef SDL_SSE_INTRINSICS
+static void SDL_TARGETING("sse") SDL_Convert51ToStereo_SSE(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("5.1", "stereo (using SSE)");
+
+    const __m128 front = _mm_set1_ps(0.294545442f);
+    const __m128 center = _mm_set1_ps(0.208181813f);
+    const __m128 lfe = _mm_set1_ps(0.090909094f);
+    const __m128 backleft = _mm_setr_ps(0.251818180f, 0.154545456f, 0.251818180f, 0.154545456f);
+    const __m128 backright = _mm_setr_ps(0.154545456f, 0.251818180f, 0.154545456f, 0.251818180f);
+    int i = num_frames;
+
+    while (i >= 2) {
+        const __m128 in0 = _mm_loadu_ps(src);     // FL0 FR0 FC0 LFE0
+        const __m128 in1 = _mm_loadu_ps(src + 4); // BL0 BR0 FL1 FR1
+        const __m128 in2 = _mm_loadu_ps(src + 8); // FC1 LFE1 BL1 BR1
+        __m128 out = _mm_mul_ps(_mm_shuffle_ps(in0, in1, _MM_SHUFFLE(3, 2, 1, 0)), front);
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in0, in2, _MM_SHUFFLE(0, 0, 2, 2)), center));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in0, in2, _MM_SHUFFLE(1, 1, 3, 3)), lfe));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in1, in2, _MM_SHUFFLE(2, 2, 0, 0)), backleft));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in1, in2, _MM_SHUFFLE(3, 3, 1, 1)), backright));
+        _mm_storeu_ps(dst, out);
+        i -= 2;
+        src += 12;
+        dst += 4;
+    }
+
+    if (i) {
+        SDL_Convert51ToStereo(dst, src, i);
+    }
+}
+
+static void SDL_TARGETING("sse") SDL_Convert71ToStereo_SSE(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("7.1", "stereo (using SSE)");
+
+    const __m128 front = _mm_set1_ps(0.211866662f);
+    const __m128 center = _mm_set1_ps(0.150266662f);
+    const __m128 lfe = _mm_set1_ps(0.066666670f);
+    const __m128 backleft = _mm_setr_ps(0.181066677f, 0.111066669f, 0.181066677f, 0.111066669f);
+    const __m128 backright = _mm_setr_ps(0.111066669f, 0.181066677f, 0.111066669f, 0.181066677f);
+    const __m128 sideleft = _mm_setr_ps(0.194133341f, 0.085866667f, 0.194133341f, 0.085866667f);
+    const __m128 sideright = _mm_setr_ps(0.085866667f, 0.194133341f, 0.085866667f, 0.194133341f);
+    int i = num_frames;
+
+    while (i >= 2) {
+        const __m128 in0 = _mm_loadu_ps(src);      // FL0 FR0 FC0 LFE0
+        const __m128 in1 = _mm_loadu_ps(src + 4);  // BL0 BR0 SL0 SR0
+        const __m128 in2 = _mm_loadu_ps(src + 8);  // FL1 FR1 FC1 LFE1
+        const __m128 in3 = _mm_loadu_ps(src + 12); // BL1 BR1 SL1 SR1
+        __m128 out = _mm_mul_ps(_mm_shuffle_ps(in0, in2, _MM_SHUFFLE(1, 0, 1, 0)), front);
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in0, in2, _MM_SHUFFLE(2, 2, 2, 2)), center));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in0, in2, _MM_SHUFFLE(3, 3, 3, 3)), lfe));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in1, in3, _MM_SHUFFLE(0, 0, 0, 0)), backleft));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in1, in3, _MM_SHUFFLE(1, 1, 1, 1)), backright));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in1, in3, _MM_SHUFFLE(2, 2, 2, 2)), sideleft));
+        out = _mm_add_ps(out, _mm_mul_ps(_mm_shuffle_ps(in1, in3, _MM_SHUFFLE(3, 3, 3, 3)), sideright));
+        _mm_storeu_ps(dst, out);
+        i -= 2;
+        src += 16;
+        dst += 4;
+    }
+
+    if (i) {
+        SDL_Convert71ToStereo(dst, src, i);
+    }
+}
+
+static void SDL_TARGETING("sse") SDL_ConvertStereoTo51_SSE(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("stereo", "5.1 (using SSE)");
+
+    const __m128 zero = _mm_setzero_ps();
+    int i = num_frames;
+
+    // convert backwards, since output is growing in-place.
+    src += num_frames * 2;
+    dst += num_frames * 6;
+    while (i >= 2) {
+        src -= 4;
+        dst -= 12;
+        const __m128 input = _mm_loadu_ps(src);                                  // FL0 FR0 FL1 FR1
+        _mm_storeu_ps(dst + 8, zero);                                            // 0 0 0 0
+        _mm_storeu_ps(dst + 4, _mm_shuffle_ps(zero, input, _MM_SHUFFLE(3, 2, 0, 0))); // 0 0 FL1 FR1
+        _mm_storeu_ps(dst, _mm_movelh_ps(input, zero));                          // FL0 FR0 0 0
+        i -= 2;
+    }
+
+    // Only the first frame can be left over now.
+    if (i) {
+        SDL_ConvertStereoTo51(dst - 6, src - 2, i);
+    }
+}
+
+static void SDL_TARGETING("sse") SDL_ConvertStereoTo71_SSE(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("stereo", "7.1 (using SSE)");
+
+    const __m128 zero = _mm_setzero_ps();
+    int i = num_frames;
+
+    // convert backwards, since output is growing in-place.
+    src += num_frames * 2;
+    dst += num_frames * 8;
+    while (i >= 2) {
+        src -= 4;
+        dst -= 16;
+        const __m128 input = _mm_loadu_ps(src);            // FL0 FR0 FL1 FR1
+        _mm_storeu_ps(dst + 12, zero);                     // 0 0 0 0
+        _mm_storeu_ps(dst + 8, _mm_movehl_ps(zero, input)); // FL1 FR1 0 0
+        _mm_storeu_ps(dst + 4, zero);                      // 0 0 0 0
+        _mm_storeu_ps(dst, _mm_movelh_ps(input, zero));    // FL0 FR0 0 0
+        i -= 2;
+    }
+
+    // Only the first frame can be left over now.
+    if (i) {
+        SDL_ConvertStereoTo71(dst - 8, src - 2, i);
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_Convert51ToStereo_NEON(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("5.1", "stereo (using NEON)");
+
+    static const float backleft_coeffs[4] = { 0.251818180f, 0.154545456f, 0.251818180f, 0.154545456f };
+    static const float backright_coeffs[4] = { 0.154545456f, 0.251818180f, 0.154545456f, 0.251818180f };
+    const float32x4_t front = vdupq_n_f32(0.294545442f);
+    const float32x4_t center = vdupq_n_f32(0.208181813f);
+    const float32x4_t lfe = vdupq_n_f32(0.090909094f);
+    const float32x4_t backleft = vld1q_f32(backleft_coeffs);
+    const float32x4_t backright = vld1q_f32(backright_coeffs);
+    int i = num_frames;
+
+    while (i >= 2) {
+        const float32x4_t in0 = vld1q_f32(src);     // FL0 FR0 FC0 LFE0
+        const float32x4_t in1 = vld1q_f32(src + 4); // BL0 BR0 FL1 FR1
+        const float32x4_t in2 = vld1q_f32(src + 8); // FC1 LFE1 BL1 BR1
+        float32x4_t out = vmulq_f32(vcombine_f32(vget_low_f32(in0), vget_high_f32(in1)), front);
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_high_f32(in0), 0), vdup_lane_f32(vget_low_f32(in2), 0)), center));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_high_f32(in0), 1), vdup_lane_f32(vget_low_f32(in2), 1)), lfe));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_low_f32(in1), 0), vdup_lane_f32(vget_high_f32(in2), 0)), backleft));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_low_f32(in1), 1), vdup_lane_f32(vget_high_f32(in2), 1)), backright));
+        vst1q_f32(dst, out);
+        i -= 2;
+        src += 12;
+        dst += 4;
+    }
+
+    if (i) {
+        SDL_Convert51ToStereo(dst, src, i);
+    }
+}
+
+static void SDL_Convert71ToStereo_NEON(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("7.1", "stereo (using NEON)");
+
+    static const float backleft_coeffs[4] = { 0.181066677f, 0.111066669f, 0.181066677f, 0.111066669f };
+    static const float backright_coeffs[4] = { 0.111066669f, 0.181066677f, 0.111066669f, 0.181066677f };
+    static const float sideleft_coeffs[4] = { 0.194133341f, 0.085866667f, 0.194133341f, 0.085866667f };
+    static const float sideright_coeffs[4] = { 0.085866667f, 0.194133341f, 0.085866667f, 0.194133341f };
+    const float32x4_t front = vdupq_n_f32(0.211866662f);
+    const float32x4_t center = vdupq_n_f32(0.150266662f);
+    const float32x4_t lfe = vdupq_n_f32(0.066666670f);
+    const float32x4_t backleft = vld1q_f32(backleft_coeffs);
+    const float32x4_t backright = vld1q_f32(backright_coeffs);
+    const float32x4_t sideleft = vld1q_f32(sideleft_coeffs);
+    const float32x4_t sideright = vld1q_f32(sideright_coeffs);
+    int i = num_frames;
+
+    while (i >= 2) {
+        const float32x4_t in0 = vld1q_f32(src);      // FL0 FR0 FC0 LFE0
+        const float32x4_t in1 = vld1q_f32(src + 4);  // BL0 BR0 SL0 SR0
+        const float32x4_t in2 = vld1q_f32(src + 8);  // FL1 FR1 FC1 LFE1
+        const float32x4_t in3 = vld1q_f32(src + 12); // BL1 BR1 SL1 SR1
+        float32x4_t out = vmulq_f32(vcombine_f32(vget_low_f32(in0), vget_low_f32(in2)), front);
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_high_f32(in0), 0), vdup_lane_f32(vget_high_f32(in2), 0)), center));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_high_f32(in0), 1), vdup_lane_f32(vget_high_f32(in2), 1)), lfe));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_low_f32(in1), 0), vdup_lane_f32(vget_low_f32(in3), 0)), backleft));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_low_f32(in1), 1), vdup_lane_f32(vget_low_f32(in3), 1)), backright));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_high_f32(in1), 0), vdup_lane_f32(vget_high_f32(in3), 0)), sideleft));
+        out = vaddq_f32(out, vmulq_f32(vcombine_f32(vdup_lane_f32(vget_high_f32(in1), 1), vdup_lane_f32(vget_high_f32(in3), 1)), sideright));
+        vst1q_f32(dst, out);
+        i -= 2;
+        src += 16;
+        dst += 4;
+    }
+
+    if (i) {
+        SDL_Convert71ToStereo(dst, src, i);
+    }
+}
+
+static void SDL_ConvertStereoTo51_NEON(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("stereo", "5.1 (using NEON)");
+
+    const float32x2_t zero2 = vdup_n_f32(0.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    int i = num_frames;
+
+    // convert backwards, since output is growing in-place.
+    src += num_frames * 2;
+    dst += num_frames * 6;
+    while (i >= 2) {
+        src -= 4;
+        dst -= 12;
+        const float32x4_t input = vld1q_f32(src);                         // FL0 FR0 FL1 FR1
+        vst1q_f32(dst + 8, zero);                                         // 0 0 0 0
+        vst1q_f32(dst + 4, vcombine_f32(zero2, vget_high_f32(input)));   // 0 0 FL1 FR1
+        vst1q_f32(dst, vcombine_f32(vget_low_f32(input), zero2));        // FL0 FR0 0 0
+        i -= 2;
+    }
+
+    // Only the first frame can be left over now.
+    if (i) {
+        SDL_ConvertStereoTo51(dst - 6, src - 2, i);
+    }
+}
+
+static void SDL_ConvertStereoTo71_NEON(float *dst, const float *src, int num_frames)
+{
+    LOG_DEBUG_AUDIO_CONVERT("stereo", "7.1 (using NEON)");
+
+    const float32x2_t zero2 = vdup_n_f32(0.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    int i = num_frames;
+
+    // convert backwards, since output is growing in-place.
+    src += num_frames * 2;
+    dst += num_frames * 8;
+    while (i >= 2) {
+        src -= 4;
+        dst -= 16;
+        const float32x4_t input = vld1q_f32(src);                         // FL0 FR0 FL1 FR1
+        vst1q_f32(dst + 12, zero);                                        // 0 0 0 0
+        vst1q_f32(dst + 8, vcombine_f32(vget_high_f32(input), zero2));   // FL1 FR1 0 0
+        vst1q_f32(dst + 4, zero);                                         // 0 0 0 0
+        vst1q_f32(dst, vcombine_f32(vget_low_f32(input), zero2));        // FL0 FR0 0 0
+        i -= 2;
+    }
+
+    // Only the first frame can be left over now.
+    if (i) {
+        SDL_ConvertStereoTo71(dst - 8, src - 2, i);
+    }
+}
+#endif
+
 static bool SDL_IsSupportedAudioFormat(const SDL_AudioFormat fmt)
 {
     switch (fmt) {
@@ -362,6 +618,34 @@ void ConvertAudio(int num_frames,
             #ifdef SDL_SSE_INTRINSICS
             if (!override && SDL_HasSSE()) { override = SDL_ConvertMonoToStereo_SSE; }
             #endif
+        } else if (channel_converter == SDL_Convert51ToStereo) {
+            #ifdef SDL_SSE_INTRINSICS
+            if (!override && SDL_HasSSE()) { override = SDL_Convert51ToStereo_SSE; }
+            #endif
+            #ifdef SDL_NEON_INTRINSICS
+            if (!override && SDL_HasNEON()) { override = SDL_Convert51ToStereo_NEON; }
+            #endif
+        } else if (channel_converter == SDL_Convert71ToStereo) {
+            #ifdef SDL_SSE_INTRINSICS
+            if (!override && SDL_HasSSE()) { override = SDL_Convert71ToStereo_SSE; }
+            #endif
+            #ifdef SDL_NEON_INTRINSICS
+            if (!override && SDL_HasNEON()) { override = SDL_Convert71ToStereo_NEON; }
+            #endif
+        } else if (channel_converter == SDL_ConvertStereoTo51) {
+            #ifdef SDL_SSE_INTRINSICS
+            if (!override && SDL_HasSSE()) { override = SDL_ConvertStereoTo51_SSE; }
+            #endif
+            #ifdef SDL_NEON_INTRINSICS
+            if (!override && SDL_HasNEON()) { override = SDL_ConvertStereoTo51_NEON; }
+            #endif
+        } else if (channel_converter == SDL_ConvertStereoTo71) {
+            #ifdef SDL_SSE_INTRINSICS
+            if (!override && SDL_HasSSE()) { override = SDL_ConvertStereoTo71_SSE; }
+            #endif
+            #ifdef SDL_NEON_INTRINSICS
+            if (!override && SDL_HasNEON()) { override = SDL_ConvertStereoTo71_NEON; }
+            #endif
         }
 
         if (override) {
@@ -483,6 +767,15 @@ SDL_PropertiesID SDL_GetAudioStreamProperties(SDL_AudioStream *stream)
     if (stream->props == 0) {
         stream->props = SDL_CreateProperties();
     }
+    if (stream->props) {
+        const size_t queued = SDL_GetAudioQueueQueued(stream->queue);
+        const Sint64 average = stream->get_requests ? (Sint64) (stream->queued_bytes_total / stream->get_requests) : 0;
+        SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_NUMBER, (Sint64) SDL_min(queued, (size_t) SDL_MAX_SINT64));
+        SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_MAX_NUMBER, (Sint64) SDL_min(stream->queued_bytes_max, (size_t) SDL_MAX_SINT64));
+        SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_AVERAGE_NUMBER, average);
+        SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_GET_REQUESTS_NUMBER, (Sint64) stream->get_requests);
+        SDL_SetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_SHORT_READS_NUMBER, (Sint64) stream->short_reads);
+    }
     SDL_UnlockMutex(stream->lock);
     return stream->props;
 }
@@ -816,6 +1109,9 @@ static bool PutAudioStreamBufferInternal(SDL_AudioStream *stream, const SDL_Audi
     }
 
     if (retval) {
+        const size_t queued = SDL_GetAudioQueueQueued(stream->queue);
+        stream->queued_bytes_max = SDL_max(stream->queued_bytes_max, queued);
+
         if (stream->put_callback) {
             const int newavail = SDL_GetAudioStreamAvailable(stream) - prev_available;
             stream->put_callback(stream->put_callback_userdata, stream, newavail, newavail);
@@ -1090,22 +1386,18 @@ bool SDL_FlushAudioStream(SDL_AudioStream *stream)
     return true;
 }
 
-/* this does not save the previous contents of stream->work_buffer. It's a work buffer!!
+/* Scratch space for data conversion/resampling comes from the calling thread's arena, so streams
+   don't each hold on to a buffer as big as their largest request.
    The returned buffer is aligned/padded for use with SIMD instructions. */
-static Uint8 *EnsureAudioStreamWorkBufferSize(SDL_AudioStream *stream, size_t newlen)
+static Uint8 *AllocateAudioStreamWorkBuffer(SDL_Arena *arena, size_t len)
 {
-    if (stream->work_buffer_allocation >= newlen) {
-        return stream->work_buffer;
-    }
+    const size_t alignment = SDL_GetSIMDAlignment();
+    const size_t padded_len = (len + alignment - 1) & ~(alignment - 1);
 
-    Uint8 *ptr = (Uint8 *) SDL_aligned_alloc(SDL_GetSIMDAlignment(), newlen);
-    if (!ptr) {
-        return NULL;  // previous work buffer is still valid!
+    Uint8 *ptr = (Uint8 *) SDL_AllocateArenaMemory(arena, padded_len, alignment);
+    if (ptr) {
+        SDL_memset(ptr + len, 0, padded_len - len);
     }
-
-    SDL_aligned_free(stream->work_buffer);
-    stream->work_buffer = ptr;
-    stream->work_buffer_allocation = newlen;
     return ptr;
 }
 
@@ -1204,7 +1496,7 @@ static Sint64 GetAudioStreamHead(SDL_AudioStream *stream, SDL_AudioSpec *out_spe
 
 // You must hold stream->lock and validate your parameters before calling this!
 // Enough input data MUST be available!
-static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int output_frames, float gain)
+static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, SDL_Arena *arena, void *buf, int output_frames, float gain)
 {
     const SDL_AudioSpec *src_spec = &stream->input_spec;
     const SDL_AudioSpec *dst_spec = &stream->dst_spec;
@@ -1231,7 +1523,7 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
 
         // Ensure we have enough scratch space for any conversions
         if ((src_format != dst_format) || (src_channels != dst_channels) || (gain != 1.0f)) {
-            work_buffer = EnsureAudioStreamWorkBufferSize(stream, output_frames * max_frame_size);
+            work_buffer = AllocateAudioStreamWorkBuffer(arena, output_frames * max_frame_size);
 
             if (!work_buffer) {
                 return false;
@@ -1297,7 +1589,7 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
         work_buffer_capacity += resample_bytes;
     }
 
-    Uint8 *work_buffer = EnsureAudioStreamWorkBufferSize(stream, work_buffer_capacity);
+    Uint8 *work_buffer = AllocateAudioStreamWorkBuffer(arena, work_buffer_capacity);
 
     if (!work_buffer) {
         return false;
@@ -1393,6 +1685,11 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
     }
 
+    const size_t queued = SDL_GetAudioQueueQueued(stream->queue);
+    stream->get_requests++;
+    stream->queued_bytes_total += queued;
+    stream->queued_bytes_max = SDL_max(stream->queued_bytes_max, queued);
+
     // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
     const int chunk_size = 4096;
 
@@ -1428,7 +1725,16 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         output_frames = SDL_min(output_frames, chunk_size);
         output_frames = (int) SDL_min(output_frames, available_frames);
 
-        if (!GetAudioStreamDataInternal(stream, &buf[total], output_frames, gain)) {
+        // Scratch memory used by the conversion is released as soon as it's done
+        SDL_Arena *arena = SDL_GetThreadArena();
+        if (!arena) {
+            total = total ? total : -1;
+            break;
+        }
+        const SDL_ArenaMark mark = SDL_GetArenaMark(arena);
+        const bool converted = GetAudioStreamDataInternal(stream, arena, &buf[total], output_frames, gain);
+        SDL_ResetArenaToMark(arena, mark);
+        if (!converted) {
             total = total ? total : -1;
             break;
         }
@@ -1436,6 +1742,10 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         total += output_frames * dst_frame_size;
     }
 
+    if ((total >= 0) && (total < len)) {
+        stream->short_reads++;
+    }
+
     SDL_UnlockMutex(stream->lock);
 
 #if DEBUG_AUDIOSTREAM
@@ -1531,7 +1841,6 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
         SDL_UnbindAudioStream(stream);
     }
 
-    SDL_aligned_free(stream->work_buffer);
     SDL_DestroyAudioQueue(stream->queue);
     SDL_DestroyMutex(stream->lock);
 
@@ -48,6 +48,9 @@
 
 #define SDL_MAX_CHANNELMAP_CHANNELS 8  // !!! FIXME: if SDL ever supports more channels, clean this out and make those parts dynamic.
 
+// Device thread iteration times are bucketed by quarters of the device's buffer period; the last bucket is "took longer than a whole period".
+#define SDL_AUDIO_ITERATE_HISTOGRAM_BUCKETS 5
+
 typedef struct SDL_AudioDevice SDL_AudioDevice;
 typedef struct SDL_LogicalAudioDevice SDL_LogicalAudioDevice;
 
@@ -200,6 +203,18 @@ typedef struct SDL_AudioDriver
 
 struct SDL_AudioQueue; // forward decl.
 
+// Timing and throughput statistics for a physical device. These are updated by the device thread, protected by the device lock.
+typedef struct SDL_AudioDeviceStats
+{
+    Uint64 iterations;  // number of device thread iterations since the device was opened.
+    Uint64 iterate_histogram[SDL_AUDIO_ITERATE_HISTOGRAM_BUCKETS];  // how long each iteration took, relative to the buffer period.
+    Uint64 iterate_max_ns;  // the longest single iteration.
+    Uint64 underruns;  // playback buffers that were padded with silence because a bound, unpaused stream ran dry.
+    Uint64 late_wakeups;  // iterations that started more than 1.5 buffer periods after the previous one.
+    Uint64 bytes_processed;  // bytes mixed for playback, or bytes read from the device for recording.
+    Uint64 last_iterate_ns;  // SDL_GetTicksNS() at the start of the previous iteration, zero if there wasn't one yet.
+} SDL_AudioDeviceStats;
+
 struct SDL_AudioStream
 {
     SDL_Mutex *lock;
@@ -225,8 +240,11 @@ struct SDL_AudioStream
     int input_chmap_storage[SDL_MAX_CHANNELMAP_CHANNELS];  // !!! FIXME: this needs to grow if SDL ever supports more channels. But if it grows, we should probably be more clever about allocations.
     Sint64 resample_offset;
 
-    Uint8 *work_buffer;    // used for scratch space during data conversion/resampling.
-    size_t work_buffer_allocation;
+    // Queue depth statistics, reported through the stream's properties.
+    Uint64 get_requests;  // calls to SDL_GetAudioStreamData (or the device thread pulling from a bound stream).
+    Uint64 short_reads;  // get requests that couldn't be fully satisfied.
+    Uint64 queued_bytes_total;  // sum of the input bytes queued at each get request, for the average.
+    size_t queued_bytes_max;  // the most input bytes that have been queued at once.
 
     bool simplified;  // true if created via SDL_OpenAudioDeviceStream
 
@@ -351,6 +369,12 @@ struct SDL_AudioDevice
     // Data private to this driver
     struct SDL_PrivateAudioData *hidden;
 
+    // Timing statistics, reported through SDL_GetAudioDeviceProperties().
+    SDL_AudioDeviceStats stats;
+
+    // Properties associated with this device, created on demand.
+    SDL_PropertiesID props;
+
     // All logical devices associated with this physical device.
     SDL_LogicalAudioDevice *logical_devices;
 };
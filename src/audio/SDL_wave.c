@@ -101,6 +101,134 @@ typedef struct MS_ADPCM_ChannelState
     Sint16 coeff2;
 } MS_ADPCM_ChannelState;
 
+/* ADPCM blocks carry their own decoder state in the block header, so the
+ * blocks of big files can be decoded on several threads at once, each one
+ * writing to its own part of the output buffer.
+ */
+#define ADPCM_PARALLEL_MIN_DATA_SIZE (1024 * 1024) // Don't bother with threads for less ADPCM data than this.
+#define ADPCM_PARALLEL_MIN_BLOCKS    64            // Don't give a thread fewer blocks than this.
+#define ADPCM_PARALLEL_MAX_THREADS   16
+
+typedef bool (*ADPCM_DecodeFunction)(ADPCM_DecoderState *state);
+
+typedef struct ADPCM_BlockRange
+{
+    const ADPCM_DecoderState *state; // Template for the decoder state of this range.
+    ADPCM_DecodeFunction decodeheader;
+    ADPCM_DecodeFunction decodedata;
+    size_t cstatesize;               // Size of the channel states in bytes.
+    size_t firstblock;
+    size_t numblocks;
+    bool result;
+    char error[128];
+} ADPCM_BlockRange;
+
+static bool ADPCM_DecodeBlockRange(ADPCM_BlockRange *range)
+{
+    ADPCM_DecoderState state;
+    size_t i;
+
+    SDL_copyp(&state, range->state);
+    state.cstate = SDL_calloc(1, range->cstatesize);
+    if (!state.cstate) {
+        return false;
+    }
+
+    for (i = range->firstblock; i < range->firstblock + range->numblocks; i++) {
+        state.block.data = state.input.data + i * state.blocksize;
+        state.block.size = state.blocksize;
+        state.block.pos = 0;
+        state.output.pos = i * state.samplesperblock * state.channels;
+        state.framesleft = (Sint64)state.samplesperblock;
+
+        if (!range->decodeheader(&state) || !range->decodedata(&state)) {
+            SDL_free(state.cstate);
+            return false;
+        }
+    }
+
+    SDL_free(state.cstate);
+    return true;
+}
+
+static int SDLCALL ADPCM_DecodeBlockRangeThread(void *data)
+{
+    ADPCM_BlockRange *range = (ADPCM_BlockRange *)data;
+
+    range->result = ADPCM_DecodeBlockRange(range);
+    if (!range->result) {
+        // The error message is thread-local, hand it over to the waiting thread.
+        SDL_strlcpy(range->error, SDL_GetError(), sizeof(range->error));
+    }
+    return 0;
+}
+
+/* Decodes all complete blocks that don't run into the end of the sample frames
+ * on several threads, if there is enough data to make that worthwhile. The
+ * state is advanced past these blocks and the usual block by block loop of the
+ * caller takes care of the rest, including any truncated block at the end.
+ */
+static bool ADPCM_DecodeBlocksParallel(ADPCM_DecoderState *state, ADPCM_DecodeFunction decodeheader, ADPCM_DecodeFunction decodedata, size_t cstatesize)
+{
+    ADPCM_BlockRange ranges[ADPCM_PARALLEL_MAX_THREADS];
+    SDL_Thread *threads[ADPCM_PARALLEL_MAX_THREADS];
+    size_t availableblocks, fullblocks, numthreads, blocksperthread, i;
+    bool result = true;
+
+    if (state->input.pos != 0 || state->output.pos != 0 || state->input.size < ADPCM_PARALLEL_MIN_DATA_SIZE) {
+        return true;
+    }
+
+    availableblocks = state->input.size / state->blocksize;
+    fullblocks = (size_t)(state->framesleft / (Sint64)state->samplesperblock);
+    fullblocks = SDL_min(fullblocks, availableblocks);
+
+    numthreads = (size_t)SDL_max(SDL_GetNumLogicalCPUCores(), 1);
+    numthreads = SDL_min(numthreads, fullblocks / ADPCM_PARALLEL_MIN_BLOCKS);
+    numthreads = SDL_min(numthreads, ADPCM_PARALLEL_MAX_THREADS);
+    if (numthreads < 2) {
+        return true;
+    }
+
+    blocksperthread = fullblocks / numthreads;
+    for (i = 0; i < numthreads; i++) {
+        ranges[i].state = state;
+        ranges[i].decodeheader = decodeheader;
+        ranges[i].decodedata = decodedata;
+        ranges[i].cstatesize = cstatesize;
+        ranges[i].firstblock = i * blocksperthread;
+        ranges[i].numblocks = (i == numthreads - 1) ? fullblocks - ranges[i].firstblock : blocksperthread;
+        ranges[i].result = false;
+        ranges[i].error[0] = '\0';
+    }
+
+    // This thread decodes the first range, and any range that didn't get a thread of its own.
+    threads[0] = NULL;
+    for (i = 1; i < numthreads; i++) {
+        threads[i] = SDL_CreateThread(ADPCM_DecodeBlockRangeThread, "SDLWaveDecode", &ranges[i]);
+    }
+
+    for (i = 0; i < numthreads; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+            if (!ranges[i].result && result) {
+                SDL_SetError("%s", ranges[i].error);
+            }
+        } else {
+            ranges[i].result = ADPCM_DecodeBlockRange(&ranges[i]);
+        }
+        result = result && ranges[i].result;
+    }
+
+    if (result) {
+        state->input.pos = fullblocks * state->blocksize;
+        state->output.pos = fullblocks * state->samplesperblock * state->channels;
+        state->framesleft -= (Sint64)(fullblocks * state->samplesperblock);
+    }
+
+    return result;
+}
+
 #ifdef SDL_WAVE_DEBUG_LOG_FORMAT
 static void WaveDebugLogFormat(WaveFile *file)
 {
@@ -689,6 +817,12 @@ static bool MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len
 
     state.cstate = cstate;
 
+    // Decode the bulk of big files on several threads.
+    if (!ADPCM_DecodeBlocksParallel(&state, MS_ADPCM_DecodeBlockHeader, MS_ADPCM_DecodeBlockData, sizeof(cstate))) {
+        SDL_free(state.output.data);
+        return false;
+    }
+
     // Decode block by block. A truncated block will stop the decoding.
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -1085,6 +1219,13 @@ static bool IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_le
     }
     state.cstate = cstate;
 
+    // Decode the bulk of big files on several threads.
+    if (!ADPCM_DecodeBlocksParallel(&state, IMA_ADPCM_DecodeBlockHeader, IMA_ADPCM_DecodeBlockData, state.channels * sizeof(Sint8))) {
+        SDL_free(state.output.data);
+        SDL_free(cstate);
+        return false;
+    }
+
     // Decode block by block. A truncated block will stop the decoding.
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -1159,7 +1300,10 @@ static bool LAW_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+/* Expands A-law or mu-law samples to 16-bit PCM. This works backwards, so
+ * `dst` and `src` can be the same buffer.
+ */
+static bool LAW_Expand(Uint16 encoding, Sint16 *dst, const Uint8 *src, size_t sample_count)
 {
 #ifdef SDL_WAVE_LAW_LUT
     const Sint16 alaw_lut[256] = {
@@ -1200,53 +1344,9 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     };
 #endif
 
-    WaveFormat *format = &file->format;
-    WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
-    Uint8 *src;
-    Sint16 *dst;
+    size_t i = sample_count;
 
-    if (chunk->length != chunk->size) {
-        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
-        if (file->sampleframes < 0) {
-            return false;
-        }
-    }
-
-    // Nothing to decode, nothing to return.
-    if (file->sampleframes == 0) {
-        *audio_buf = NULL;
-        *audio_len = 0;
-        return true;
-    }
-
-    sample_count = (size_t)file->sampleframes;
-    if (SafeMult(&sample_count, format->channels)) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    expanded_len = sample_count;
-    if (SafeMult(&expanded_len, sizeof(Sint16))) {
-        return SDL_SetError("WAVE file too big");
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    // 1 to avoid allocating zero bytes, to keep static analysis happy.
-    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
-    if (!src) {
-        return false;
-    }
-    chunk->data = NULL;
-    chunk->size = 0;
-
-    dst = (Sint16 *)src;
-
-    /* Work backwards, since we're expanding in-place. `format` will
-     * inform the caller about the byte order.
-     */
-    i = sample_count;
-    switch (file->format.encoding) {
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
     case ALAW_CODE:
         while (i--) {
@@ -1291,10 +1391,61 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         break;
 #endif
     default:
-        SDL_free(src);
         return SDL_SetError("Unknown companded encoding");
     }
 
+    return true;
+}
+
+static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    size_t sample_count, expanded_len;
+    Uint8 *src;
+
+    if (chunk->length != chunk->size) {
+        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
+        if (file->sampleframes < 0) {
+            return false;
+        }
+    }
+
+    // Nothing to decode, nothing to return.
+    if (file->sampleframes == 0) {
+        *audio_buf = NULL;
+        *audio_len = 0;
+        return true;
+    }
+
+    sample_count = (size_t)file->sampleframes;
+    if (SafeMult(&sample_count, format->channels)) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    expanded_len = sample_count;
+    if (SafeMult(&expanded_len, sizeof(Sint16))) {
+        return SDL_SetError("WAVE file too big");
+    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    // 1 to avoid allocating zero bytes, to keep static analysis happy.
+    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
+    if (!src) {
+        return false;
+    }
+    chunk->data = NULL;
+    chunk->size = 0;
+
+    /* Expanding in-place. `format` will inform the caller about the byte
+     * order.
+     */
+    if (!LAW_Expand(format->encoding, (Sint16 *)src, src, sample_count)) {
+        SDL_free(src);
+        return false;
+    }
+
     *audio_buf = src;
     *audio_len = (Uint32)expanded_len;
 
@@ -1344,11 +1495,34 @@ static bool PCM_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
+/* Shifts 24-bit samples into 32-bit containers. This works backwards, so
+ * `dst` and `src` can be the same buffer.
+ */
+static void PCM_ExpandSint24(Uint8 *dst, const Uint8 *src, size_t sample_count)
+{
+    size_t i;
+
+    for (i = sample_count; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = src[o * 3];
+        b[2] = src[o * 3 + 1];
+        b[3] = src[o * 3 + 2];
+
+        dst[o * 4 + 0] = b[0];
+        dst[o * 4 + 1] = b[1];
+        dst[o * 4 + 2] = b[2];
+        dst[o * 4 + 3] = b[3];
+    }
+}
+
 static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1376,21 +1550,8 @@ static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    // work from end to start, since we're expanding in-place.
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    // this works from end to start, since we're expanding in-place.
+    PCM_ExpandSint24(ptr, ptr, sample_count);
 
     return true;
 }
@@ -1770,7 +1931,11 @@ static bool WaveCheckFormat(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Finds and validates the fmt, fact, and data chunks and initializes the
+ * decoder. On success, `datachunk` describes the (still unread) data chunk and
+ * `endposition` is where the WAVE data ends in the stream.
+ */
+static bool WaveLoadHeaders(SDL_IOStream *src, WaveFile *file, WaveChunk *datachunk, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1778,15 +1943,13 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
     const char *hint;
     Sint64 RIFFstart, RIFFend, lastchunkpos;
     bool RIFFlengthknown = false;
-    WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
     WaveChunk RIFFchunk;
     WaveChunk fmtchunk;
-    WaveChunk datachunk;
 
     SDL_zero(RIFFchunk);
     SDL_zero(fmtchunk);
-    SDL_zero(datachunk);
+    SDL_zerop(datachunk);
 
     hint = SDL_GetHint(SDL_HINT_WAVE_CHUNK_LIMIT);
     if (hint) {
@@ -1877,7 +2040,7 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
                 // Multiple fmt chunks. Ignore or error?
             } else {
                 // The fmt chunk must occur before the data chunk.
-                if (datachunk.fourcc == DATA) {
+                if (datachunk->fourcc == DATA) {
                     return SDL_SetError("fmt chunk after data chunk in WAVE file");
                 }
                 fmtchunk = *chunk;
@@ -1886,8 +2049,8 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
             /* Only use the first data chunk. Handling the wavl list madness
              * may require a different approach.
              */
-            if (datachunk.fourcc != DATA) {
-                datachunk = *chunk;
+            if (datachunk->fourcc != DATA) {
+                *datachunk = *chunk;
             }
         } else if (chunk->fourcc == FACT) {
             /* The fact chunk data must be at least 4 bytes for the
@@ -1915,7 +2078,7 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
             if ((Uint64)RIFFend < (Uint64)chunk->position + chunk->length) {
                 return SDL_SetError("RIFF size truncates chunk");
             }
-        } else if (fmtchunk.fourcc == FMT && datachunk.fourcc == DATA) {
+        } else if (fmtchunk.fourcc == FMT && datachunk->fourcc == DATA) {
             if (file->fact.status == 1 || file->facthint == FactIgnore || file->facthint == FactNoHint) {
                 break;
             }
@@ -1932,7 +2095,7 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
         return SDL_SetError("Missing fmt chunk in WAVE file");
     }
     // A data chunk must be present.
-    if (datachunk.fourcc != DATA) {
+    if (datachunk->fourcc != DATA) {
         return SDL_SetError("Missing data chunk in WAVE file");
     }
     // Check if the last chunk has all of its data in verystrict mode.
@@ -1968,7 +2131,7 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
         return SDL_SetError("Could not read data of WAVE fmt chunk");
     } else if (!WaveReadFormat(file)) {
         return false;
-    } else if (!WaveCheckFormat(file, (size_t)datachunk.length)) {
+    } else if (!WaveCheckFormat(file, (size_t)datachunk->length)) {
         return false;
     }
 
@@ -1976,11 +2139,77 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
     WaveDebugLogFormat(file);
 #endif
 #ifdef SDL_WAVE_DEBUG_DUMP_FORMAT
-    WaveDebugDumpFormat(file, RIFFchunk.length, fmtchunk.length, datachunk.length);
+    WaveDebugDumpFormat(file, RIFFchunk.length, fmtchunk.length, datachunk->length);
 #endif
 
     WaveFreeChunkData(chunk);
 
+    // Report the end position back to the caller.
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return true;
+}
+
+// Sets up an SDL_AudioSpec for the decoded data. All unsupported formats were filtered out by WaveCheckFormat.
+static bool WaveGetSpec(WaveFile *file, SDL_AudioSpec *spec)
+{
+    WaveFormat *format = &file->format;
+
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = SDL_AUDIO_UNKNOWN;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        // These can be easily stored in the byte order of the system.
+        spec->format = SDL_AUDIO_S16;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LE;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LE;
+            break;
+        case 24: // Gets shifted to 32 bits.
+        case 32:
+            spec->format = SDL_AUDIO_S32LE;
+            break;
+        default:
+            // Just in case something unexpected happened in the checks.
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    return true;
+}
+
+static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition = 0;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    WaveChunk datachunk;
+
+    if (!WaveLoadHeaders(src, file, &datachunk, &endposition)) {
+        return false;
+    }
+
     // Process data chunk.
     *chunk = datachunk;
 
@@ -2027,51 +2256,13 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = SDL_AUDIO_UNKNOWN;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        // These can be easily stored in the byte order of the system.
-        spec->format = SDL_AUDIO_S16;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LE;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LE;
-            break;
-        case 24: // Has been shifted to 32 bits.
-        case 32:
-            spec->format = SDL_AUDIO_S32LE;
-            break;
-        default:
-            // Just in case something unexpected happened in the checks.
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
+    // Setting up the specs.
+    if (!WaveGetSpec(file, spec)) {
+        return false;
     }
 
     // Report the end position back to the cleanup code.
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return true;
 }
@@ -2152,3 +2343,317 @@ bool SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint3
     return SDL_LoadWAV_IO(stream, true, spec, audio_buf, audio_len);
 }
 
+
+/* Streaming WAVE decoding. Instead of decoding the whole data chunk up front,
+ * an audio stream's get callback reads and decodes the data a step at a time
+ * (one ADPCM block, or a few thousand sample frames of anything else), so
+ * memory use doesn't depend on the length of the file.
+ */
+
+#define SDL_PROP_AUDIOSTREAM_WAVE_POINTER "SDL.internal.audiostream.wave"
+
+// Number of sample frames decoded per step for PCM and companded data.
+#define WAVE_STREAM_STEP_FRAMES 4096
+
+typedef struct WaveStream
+{
+    WaveFile file;
+    SDL_IOStream *src;
+    bool closeio;
+    SDL_AudioStream *stream;
+    Sint64 dataleft;    // Bytes of the data chunk that haven't been read yet.
+    Sint64 framesleft;  // Number of sample frames still to be decoded.
+    size_t stepsize;    // Bytes read from the data chunk in one step.
+    size_t inframesize; // Size of a sample frame in the data chunk in bytes. Unused for ADPCM.
+    size_t framesize;   // Size of a decoded sample frame in bytes.
+    Uint8 *input;       // One step of data from the data chunk.
+    Uint8 *output;      // One step of decoded data. Points to `input` unless this is ADPCM.
+    void *cstate;      // ADPCM channel states.
+    bool done;
+} WaveStream;
+
+/* Decodes a single ADPCM block into `output`, which must have room for a whole
+ * block of sample frames. Returns the number of sample frames decoded, or -1
+ * if the block is truncated and the truncation hint doesn't allow that.
+ */
+static Sint64 ADPCM_DecodeOneBlock(WaveFile *file, void *cstate, Uint8 *block, size_t blocksize, Sint64 framesleft, Sint16 *output)
+{
+    ADPCM_DecoderState state;
+    bool result;
+
+    SDL_zero(state);
+    state.channels = file->format.channels;
+    state.blocksize = file->format.blockalign;
+    state.samplesperblock = file->format.samplesperblock;
+    state.framesize = state.channels * sizeof(Sint16);
+    state.ddata = file->decoderdata;
+    state.cstate = cstate;
+    state.framestotal = framesleft;
+    state.framesleft = framesleft;
+
+    state.block.data = block;
+    state.block.size = blocksize;
+    state.block.pos = 0;
+
+    state.output.data = output;
+    state.output.size = state.samplesperblock * state.channels;
+    state.output.pos = 0;
+
+    if (file->format.encoding == MS_ADPCM_CODE) {
+        state.blockheadersize = (size_t)state.channels * 7;
+        result = MS_ADPCM_DecodeBlockHeader(&state) && MS_ADPCM_DecodeBlockData(&state);
+    } else {
+        state.blockheadersize = (size_t)state.channels * 4;
+        result = IMA_ADPCM_DecodeBlockHeader(&state) && IMA_ADPCM_DecodeBlockData(&state);
+    }
+
+    if (!result) {
+        // Unexpected end. Return partial data if the hint allows it.
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            SDL_SetError("Truncated data chunk");
+            return -1;
+        } else if (file->trunchint != TruncDropFrame) {
+            state.output.pos -= state.output.pos % (state.samplesperblock * state.channels);
+        }
+    }
+
+    return SDL_min((Sint64)(state.output.pos / state.channels), framesleft);
+}
+
+/* Reads and decodes the next step of the data chunk into `ws->output`.
+ * Returns the number of decoded sample frames, 0 at the end of the data, or
+ * -1 on error.
+ */
+static Sint64 WaveStreamDecodeStep(WaveStream *ws)
+{
+    WaveFile *file = &ws->file;
+    WaveFormat *format = &file->format;
+    size_t length = (size_t)SDL_min((Sint64)ws->stepsize, ws->dataleft);
+    size_t sample_count;
+    Sint64 frames;
+
+    if (ws->framesleft <= 0 || length == 0) {
+        return 0;
+    }
+
+    const size_t bytesread = SDL_ReadIO(ws->src, ws->input, length);
+    ws->dataleft -= bytesread;
+    if (bytesread < length) {
+        // I/O issues or corrupt file.
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            SDL_SetError("Could not read data of WAVE data chunk");
+            return -1;
+        }
+        ws->dataleft = 0;  // whatever we got is the last of it.
+    }
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        // A truncated block header ends the decoding.
+        if (bytesread < (size_t)format->channels * (format->encoding == MS_ADPCM_CODE ? 7 : 4)) {
+            return 0;
+        }
+        frames = ADPCM_DecodeOneBlock(file, ws->cstate, ws->input, bytesread, ws->framesleft, (Sint16 *)ws->output);
+        break;
+
+    case ALAW_CODE:
+    case MULAW_CODE:
+        // Incomplete sample frames are dropped.
+        frames = SDL_min((Sint64)(bytesread / ws->inframesize), ws->framesleft);
+        sample_count = (size_t)frames * format->channels;
+        if (!LAW_Expand(format->encoding, (Sint16 *)ws->output, ws->input, sample_count)) {
+            return -1;
+        }
+        break;
+
+    default:
+        frames = SDL_min((Sint64)(bytesread / ws->inframesize), ws->framesleft);
+        if (format->encoding == PCM_CODE && format->bitspersample == 24) {
+            sample_count = (size_t)frames * format->channels;
+            PCM_ExpandSint24(ws->output, ws->input, sample_count);
+        }
+        break;
+    }
+
+    if (frames > 0) {
+        ws->framesleft -= frames;
+    }
+
+    return frames;
+}
+
+static void SDLCALL WaveStreamGetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    WaveStream *ws = (WaveStream *)userdata;
+
+    while (additional_amount > 0 && !ws->done) {
+        const Sint64 frames = WaveStreamDecodeStep(ws);
+        if (frames > 0) {
+            const int len = (int)((size_t)frames * ws->framesize);
+            if (!SDL_PutAudioStreamData(stream, ws->output, len)) {
+                break;  // probably out of memory. Try again next time.
+            }
+            additional_amount -= len;
+        }
+
+        if (frames <= 0 || ws->framesleft <= 0) {
+            // End of the data (or an error we can't report from here). Let the stream drain what it has.
+            ws->done = true;
+            SDL_FlushAudioStream(stream);
+        }
+    }
+}
+
+static void FreeWaveStream(WaveStream *ws)
+{
+    if (ws->closeio) {
+        SDL_CloseIO(ws->src);
+    }
+    WaveFreeChunkData(&ws->file.chunk);
+    SDL_free(ws->file.decoderdata);
+    SDL_free(ws->cstate);
+    if (ws->output != ws->input) {
+        SDL_free(ws->output);
+    }
+    SDL_free(ws->input);
+    SDL_free(ws);
+}
+
+static void SDLCALL CleanupWaveStream(void *userdata, void *value)
+{
+    WaveStream *ws = (WaveStream *)value;
+
+    /* The stream might still be bound to a device, so make sure the device
+     * thread can't get into the callback while we free its state.
+     */
+    SDL_SetAudioStreamGetCallback(ws->stream, NULL, NULL);
+    FreeWaveStream(ws);
+}
+
+static bool WaveStreamInit(WaveStream *ws, SDL_AudioSpec *spec)
+{
+    WaveFile *file = &ws->file;
+    WaveFormat *format = &file->format;
+    WaveChunk datachunk;
+    Sint64 endposition;
+
+    if (!WaveLoadHeaders(ws->src, file, &datachunk, &endposition) || !WaveGetSpec(file, spec)) {
+        return false;
+    }
+
+    ws->framesize = SDL_AUDIO_FRAMESIZE(*spec);
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        // One block at a time, decoded into a separate buffer.
+        ws->framesleft = file->sampleframes;
+        ws->dataleft = datachunk.length;
+        ws->stepsize = format->blockalign;
+        ws->input = (Uint8 *)SDL_malloc(ws->stepsize);
+        ws->output = (Uint8 *)SDL_malloc((size_t)format->samplesperblock * ws->framesize);
+        ws->cstate = SDL_calloc(format->channels, sizeof(MS_ADPCM_ChannelState));
+        if (!ws->input || !ws->output || !ws->cstate) {
+            return false;
+        }
+        break;
+    default:
+        /* Like the full decoders, the sample frame count is in units of
+         * nBlockAlign here. The data is read in whole sample frames, and
+         * decoded in place.
+         */
+        ws->inframesize = ((size_t)format->channels * format->bitspersample) / 8;
+        ws->dataleft = SDL_min((Sint64)datachunk.length, file->sampleframes * format->blockalign);
+        ws->framesleft = ws->dataleft / (Sint64)ws->inframesize;
+        ws->dataleft = ws->framesleft * (Sint64)ws->inframesize;
+        ws->stepsize = WAVE_STREAM_STEP_FRAMES * ws->inframesize;
+        ws->input = (Uint8 *)SDL_malloc(WAVE_STREAM_STEP_FRAMES * SDL_max(ws->inframesize, ws->framesize));
+        ws->output = ws->input;
+        if (!ws->input) {
+            return false;
+        }
+        break;
+    }
+
+    if (SDL_SeekIO(ws->src, datachunk.position, SDL_IO_SEEK_SET) != datachunk.position) {
+        return SDL_SetError("Could not seek data of WAVE data chunk");
+    }
+
+    return true;
+}
+
+SDL_AudioStream *SDL_LoadWAVStream_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec)
+{
+    WaveStream *ws = NULL;
+    SDL_AudioStream *stream = NULL;
+
+    if (spec) {
+        SDL_zerop(spec);
+    }
+
+    CHECK_PARAM(!src) {
+        SDL_InvalidParamError("src");
+        goto failed;
+    }
+    CHECK_PARAM(!spec) {
+        SDL_InvalidParamError("spec");
+        goto failed;
+    }
+
+    ws = (WaveStream *)SDL_calloc(1, sizeof(*ws));
+    if (!ws) {
+        goto failed;
+    }
+    ws->src = src;
+    ws->file.riffhint = WaveGetRiffSizeHint();
+    ws->file.trunchint = WaveGetTruncationHint();
+    ws->file.facthint = WaveGetFactChunkHint();
+
+    if (!WaveStreamInit(ws, spec)) {
+        goto failed;
+    }
+
+    stream = SDL_CreateAudioStream(spec, spec);
+    if (!stream) {
+        goto failed;
+    }
+    ws->stream = stream;
+    ws->closeio = closeio;
+
+    // The decoder state is freed along with the stream's properties, when the stream is destroyed.
+    if (!SDL_SetPointerPropertyWithCleanup(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_WAVE_POINTER, ws, CleanupWaveStream, NULL)) {
+        SDL_DestroyAudioStream(stream);  // the cleanup callback already freed `ws` (and closed `src`, if requested).
+        SDL_zerop(spec);
+        return NULL;
+    }
+
+    SDL_SetAudioStreamGetCallback(stream, WaveStreamGetCallback, ws);
+
+    return stream;
+
+failed:
+    if (ws) {
+        ws->closeio = false;
+        FreeWaveStream(ws);
+    }
+    if (closeio && src) {
+        SDL_CloseIO(src);
+    }
+    if (spec) {
+        SDL_zerop(spec);
+    }
+    return NULL;
+}
+
+SDL_AudioStream *SDL_LoadWAVStream(const char *path, SDL_AudioSpec *spec)
+{
+    SDL_IOStream *stream = SDL_IOFromFile(path, "rb");
+    if (!stream) {
+        if (spec) {
+            SDL_zerop(spec);
+        }
+        return NULL;
+    }
+    return SDL_LoadWAVStream_IO(stream, true, spec);
+}
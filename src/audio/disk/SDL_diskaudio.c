@@ -30,14 +30,35 @@
 #define DISKDEFAULT_OUTFILE "sdlaudio.raw"
 #define DISKDEFAULT_INFILE  "sdlaudio-in.raw"
 
+// In offline mode, only move data while something is listening, so a paused device doesn't fill (or drain) the file.
+// This is called with the device lock held.
+static bool DISKAUDIO_UpdateIdle(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *h = device->hidden;
+
+    h->idle = h->offline;
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev && h->idle; logdev = logdev->next) {
+        if (!SDL_GetAtomicInt(&logdev->paused)) {
+            h->idle = false;
+        }
+    }
+    return h->idle;
+}
+
 static bool DISKAUDIO_WaitDevice(SDL_AudioDevice *device)
 {
-    SDL_Delay(device->hidden->io_delay);
+    if (!device->hidden->offline || device->hidden->idle) {
+        SDL_Delay(device->hidden->io_delay);
+    }
     return true;
 }
 
 static bool DISKAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
 {
+    if (DISKAUDIO_UpdateIdle(device)) {
+        return true;
+    }
+
     const int written = (int)SDL_WriteIO(device->hidden->io, buffer, (size_t)buffer_size);
     if (written != buffer_size) { // If we couldn't write, assume fatal error for now
         return false;
@@ -58,14 +79,21 @@ static int DISKAUDIO_RecordDevice(SDL_AudioDevice *device, void *buffer, int buf
     struct SDL_PrivateAudioData *h = device->hidden;
     const int origbuflen = buflen;
 
-    if (h->io) {
+    if (DISKAUDIO_UpdateIdle(device)) {
+        return 0;
+    } else if (h->io) {
         const int br = (int)SDL_ReadIO(h->io, buffer, (size_t)buflen);
         buflen -= br;
         buffer = ((Uint8 *)buffer) + br;
         if (buflen > 0) { // EOF (or error, but whatever).
             SDL_CloseIO(h->io);
             h->io = NULL;
+            if (h->offline) {
+                return br;  // just what was left; the device goes away on the next read.
+            }
         }
+    } else if (h->offline) {
+        return -1;  // out of file, report the device as disconnected instead of making endless silence.
     }
 
     // if we ran out of file, just write silence.
@@ -122,6 +150,8 @@ static bool DISKAUDIO_OpenDevice(SDL_AudioDevice *device)
 
     device->hidden->io_delay = ((device->sample_frames * 1000) / device->spec.freq);
 
+    device->hidden->offline = SDL_GetHintBoolean(SDL_HINT_AUDIO_DISK_OFFLINE, false);
+
     const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DISK_TIMESCALE);
     if (hint) {
         double scale = SDL_atof(hint);
@@ -146,9 +176,10 @@ static bool DISKAUDIO_OpenDevice(SDL_AudioDevice *device)
     }
 
     SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO, "You are using the SDL disk i/o audio driver!");
-    SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO, " %s file [%s], format=%s channels=%d freq=%d.",
+    SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO, " %s file [%s], format=%s channels=%d freq=%d%s.",
                     recording ? "Reading from" : "Writing to", fname,
-                    AudioFormatString(device->spec.format), device->spec.channels, device->spec.freq);
+                    AudioFormatString(device->spec.format), device->spec.channels, device->spec.freq,
+                    device->hidden->offline ? ", offline" : "");
 
     return true;  // We're ready to rock and roll. :-)
 }
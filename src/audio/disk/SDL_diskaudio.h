@@ -30,6 +30,8 @@ struct SDL_PrivateAudioData
     // The file descriptor for the audio device
     SDL_IOStream *io;
     Uint32 io_delay;
+    bool offline;  // don't simulate real-time, run as fast as possible.
+    bool idle;     // offline, but nothing is playing or recording right now.
     Uint8 *mixbuf;
 };
 
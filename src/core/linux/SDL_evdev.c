@@ -33,6 +33,7 @@
 #include "SDL_evdev_kbd.h"
 
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -74,6 +75,7 @@ typedef struct SDL_evdevlist_item
     char *path;
     int fd;
     int udev_class;
+    bool monotonic_clock; // Events are timestamped with CLOCK_MONOTONIC rather than CLOCK_REALTIME
 
     // TODO: use this for every device, not just touchscreen
     bool out_of_sync;
@@ -346,7 +348,7 @@ void SDL_EVDEV_Poll(void)
                 switch (event->type) {
                 case EV_KEY:
                     if (event->code >= BTN_MOUSE && event->code < BTN_MOUSE + SDL_arraysize(EVDEV_MouseButtons)) {
-                        Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
+                        Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock);
                         mouse_button = event->code - BTN_MOUSE;
                         SDL_SendMouseButton(timestamp, mouse->focus, (SDL_MouseID)item->fd, EVDEV_MouseButtons[mouse_button], (event->value != 0));
                         break;
@@ -369,7 +371,7 @@ void SDL_EVDEV_Poll(void)
 
                     // Probably keyboard
                     {
-                        Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
+                        Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock);
                         scancode = SDL_EVDEV_translate_keycode(event->code);
                         if (event->value == 0) {
                             SDL_SendKeyboardKey(timestamp, (SDL_KeyboardID)item->fd, event->code, scancode, false);
@@ -489,7 +491,7 @@ void SDL_EVDEV_Poll(void)
                         // Send mouse axis changes together to ensure consistency and reduce event processing overhead
                         if (item->relative_mouse) {
                             if (item->mouse_x != 0 || item->mouse_y != 0) {
-                                Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
+                                Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock);
                                 SDL_SendMouseMotion(timestamp, mouse->focus, (SDL_MouseID)item->fd, item->relative_mouse, (float)item->mouse_x, (float)item->mouse_y);
                                 item->mouse_x = item->mouse_y = 0;
                             }
@@ -507,13 +509,13 @@ void SDL_EVDEV_Poll(void)
                                 screen_w = mode->w;
                                 screen_h = mode->h;
                             }
-                            SDL_SendMouseMotion(SDL_EVDEV_GetEventTimestamp(event), mouse->focus, (SDL_MouseID)item->fd, item->relative_mouse,
+                            SDL_SendMouseMotion(SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock), mouse->focus, (SDL_MouseID)item->fd, item->relative_mouse,
                                 (float)(item->mouse_x - item->min_x) * screen_w / item->range_x,
                                 (float)(item->mouse_y - item->min_y) * screen_h / item->range_y);
                         }
 
                         if (item->mouse_wheel != 0 || item->mouse_hwheel != 0) {
-                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
+                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock);
                             const float denom = (item->high_res_hwheel ? 120.0f : 1.0f);
                             SDL_SendMouseWheel(timestamp,
                                                mouse->focus, (SDL_MouseID)item->fd,
@@ -546,16 +548,16 @@ void SDL_EVDEV_Poll(void)
                              * be window-relative in that case. */
                             switch (item->touchscreen_data->slots[j].delta) {
                             case EVDEV_TOUCH_SLOTDELTA_DOWN:
-                                SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event), item->fd, item->touchscreen_data->slots[j].tracking_id, NULL, SDL_EVENT_FINGER_DOWN, norm_x, norm_y, norm_pressure);
+                                SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock), item->fd, item->touchscreen_data->slots[j].tracking_id, NULL, SDL_EVENT_FINGER_DOWN, norm_x, norm_y, norm_pressure);
                                 item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
                                 break;
                             case EVDEV_TOUCH_SLOTDELTA_UP:
-                                SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event), item->fd, item->touchscreen_data->slots[j].tracking_id, NULL, SDL_EVENT_FINGER_UP, norm_x, norm_y, norm_pressure);
+                                SDL_SendTouch(SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock), item->fd, item->touchscreen_data->slots[j].tracking_id, NULL, SDL_EVENT_FINGER_UP, norm_x, norm_y, norm_pressure);
                                 item->touchscreen_data->slots[j].tracking_id = 0;
                                 item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
                                 break;
                             case EVDEV_TOUCH_SLOTDELTA_MOVE:
-                                SDL_SendTouchMotion(SDL_EVDEV_GetEventTimestamp(event), item->fd, item->touchscreen_data->slots[j].tracking_id, NULL, norm_x, norm_y, norm_pressure);
+                                SDL_SendTouchMotion(SDL_EVDEV_GetEventTimestamp(event, item->monotonic_clock), item->fd, item->touchscreen_data->slots[j].tracking_id, NULL, norm_x, norm_y, norm_pressure);
                                 item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
                                 break;
                             default:
@@ -915,6 +917,7 @@ static bool SDL_EVDEV_device_added(const char *dev_path, int udev_class)
         SDL_free(item);
         return SDL_SetError("Unable to open %s", dev_path);
     }
+    item->monotonic_clock = SDL_EVDEV_SetEventClock(item->fd);
 
     item->path = SDL_strdup(dev_path);
     if (!item->path) {
@@ -1015,11 +1018,24 @@ static bool SDL_EVDEV_device_removed(const char *dev_path)
     return false;
 }
 
-Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event)
+// Returns true if the device will report events in CLOCK_MONOTONIC time
+bool SDL_EVDEV_SetEventClock(int fd)
+{
+#ifdef EVIOCSCLOCKID
+    int clock_id = CLOCK_MONOTONIC;
+    if (ioctl(fd, EVIOCSCLOCKID, &clock_id) == 0) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event, bool monotonic)
 {
     static Uint64 timestamp_offset;
     Uint64 timestamp;
     Uint64 now = SDL_GetTicksNS();
+    struct timespec monotonic_now;
 
     /* The kernel internally has nanosecond timestamps, but converts it
        to microseconds when delivering the events */
@@ -1027,6 +1043,15 @@ Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event)
     timestamp *= SDL_NS_PER_SECOND;
     timestamp += SDL_US_TO_NS(event->input_event_usec);
 
+    /* Devices that SDL_EVDEV_SetEventClock() switched to monotonic time tell us
+       exactly how old the event is. Otherwise the event has a wall clock time,
+       so estimate the offset from the wall clock to our own timeline. */
+    if (monotonic && clock_gettime(CLOCK_MONOTONIC, &monotonic_now) == 0) {
+        const Uint64 monotonic_ns = (Uint64)monotonic_now.tv_sec * SDL_NS_PER_SECOND + monotonic_now.tv_nsec;
+        const Uint64 age = (timestamp < monotonic_ns) ? (monotonic_ns - timestamp) : 0;
+        return (age < now) ? (now - age) : 0;
+    }
+
     if (!timestamp_offset) {
         timestamp_offset = (now - timestamp);
     }
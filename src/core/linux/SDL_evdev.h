@@ -34,7 +34,8 @@ extern void SDL_EVDEV_SetVTSwitchCallbacks(void (*release_callback)(void *), voi
                                            void (*acquire_callback)(void *), void *acquire_callback_data);
 extern int SDL_EVDEV_GetDeviceCount(int device_class);
 extern void SDL_EVDEV_Poll(void);
-extern Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event);
+extern bool SDL_EVDEV_SetEventClock(int fd);
+extern Uint64 SDL_EVDEV_GetEventTimestamp(struct input_event *event, bool monotonic);
 
 #endif // SDL_INPUT_LINUXEV
 
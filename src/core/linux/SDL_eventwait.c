@@ -0,0 +1,173 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifdef SDL_PLATFORM_LINUX
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "SDL_eventwait.h"
+#include "../unix/SDL_poll.h"
+
+/* All the input file descriptors are kept in one epoll set, which itself
+   becomes readable when any of them are, so backends only need to add one
+   more file descriptor to their wait. */
+static SDL_SpinLock SDL_eventwait_lock;
+static int SDL_eventwait_fd = -1;
+static int SDL_eventwait_count = 0;
+static SDL_AtomicInt SDL_eventwait_enabled;
+
+bool SDL_EventWait_AddFD(int fd)
+{
+    struct epoll_event event;
+    bool result = true;
+
+    SDL_zero(event);
+    event.events = EPOLLIN | EPOLLPRI;
+    event.data.fd = fd;
+
+    SDL_LockSpinlock(&SDL_eventwait_lock);
+    if (SDL_eventwait_fd < 0) {
+        SDL_eventwait_fd = epoll_create1(EPOLL_CLOEXEC);
+    }
+    if (SDL_eventwait_fd < 0 || epoll_ctl(SDL_eventwait_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        result = SDL_SetError("Couldn't add input to the event wait set: %s", strerror(errno));
+    } else {
+        ++SDL_eventwait_count;
+    }
+    if (SDL_eventwait_count == 0 && SDL_eventwait_fd >= 0) {
+        close(SDL_eventwait_fd);
+        SDL_eventwait_fd = -1;
+    }
+    SDL_UnlockSpinlock(&SDL_eventwait_lock);
+
+    return result;
+}
+
+void SDL_EventWait_RemoveFD(int fd)
+{
+    SDL_LockSpinlock(&SDL_eventwait_lock);
+    if (SDL_eventwait_fd >= 0 && epoll_ctl(SDL_eventwait_fd, EPOLL_CTL_DEL, fd, NULL) == 0) {
+        if (--SDL_eventwait_count == 0) {
+            close(SDL_eventwait_fd);
+            SDL_eventwait_fd = -1;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_eventwait_lock);
+}
+
+void SDL_EventWait_SetEnabled(bool enabled)
+{
+    SDL_SetAtomicInt(&SDL_eventwait_enabled, enabled);
+}
+
+/* Check which inputs in the wait set are ready. Disconnected devices report
+   EPOLLHUP or EPOLLERR on every wait until they're closed, so they're taken
+   out of the set instead of being reported as input. */
+static bool SDL_EventWait_CheckInput(int eventwait_fd)
+{
+    struct epoll_event events[16];
+    bool input_ready = false;
+    int i, count;
+
+    count = epoll_wait(eventwait_fd, events, SDL_arraysize(events), 0);
+    for (i = 0; i < count; ++i) {
+        if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+            SDL_EventWait_RemoveFD(events[i].data.fd);
+        }
+        if (events[i].events & (EPOLLIN | EPOLLPRI)) {
+            input_ready = true;
+        }
+    }
+    return input_ready;
+}
+
+int SDL_EventWait_IOReady(int fd, int flags, Sint64 timeoutNS)
+{
+    struct pollfd info[2];
+    int eventwait_fd;
+    int timeoutMS;
+    int result;
+
+    SDL_LockSpinlock(&SDL_eventwait_lock);
+    eventwait_fd = SDL_eventwait_fd;
+    SDL_UnlockSpinlock(&SDL_eventwait_lock);
+
+    if (eventwait_fd < 0 || !SDL_GetAtomicInt(&SDL_eventwait_enabled)) {
+        return SDL_IOReady(fd, flags, timeoutNS);
+    }
+
+    SDL_assert(flags & (SDL_IOR_READ | SDL_IOR_WRITE));
+
+    info[0].fd = fd;
+    info[0].events = 0;
+    if (flags & SDL_IOR_READ) {
+        info[0].events |= POLLIN | POLLPRI;
+    }
+    if (flags & SDL_IOR_WRITE) {
+        info[0].events |= POLLOUT;
+    }
+    info[1].events = POLLIN;
+
+    if (timeoutNS > 0) {
+        timeoutMS = (int)SDL_NS_TO_MS(timeoutNS + (SDL_NS_PER_MS - 1));
+    } else if (timeoutNS == 0) {
+        timeoutMS = 0;
+    } else {
+        timeoutMS = -1;
+    }
+
+    for (;;) {
+        info[1].fd = eventwait_fd;
+
+        // Note: We don't bother to account for elapsed time if we get EINTR
+        do {
+            info[0].revents = 0;
+            info[1].revents = 0;
+            result = poll(info, SDL_arraysize(info), timeoutMS);
+        } while (result < 0 && errno == EINTR && !(flags & SDL_IOR_NO_RETRY));
+
+        if (result <= 0) {
+            return result;
+        }
+        if (info[0].revents) {
+            return SDL_EVENTWAIT_READY;
+        }
+        if (SDL_EventWait_CheckInput(eventwait_fd)) {
+            return SDL_EVENTWAIT_INPUT_READY;
+        }
+
+        // Only disconnected devices were ready and they've been removed, keep waiting
+        SDL_LockSpinlock(&SDL_eventwait_lock);
+        eventwait_fd = SDL_eventwait_fd;
+        SDL_UnlockSpinlock(&SDL_eventwait_lock);
+
+        if (eventwait_fd < 0) {
+            return SDL_IOReady(fd, flags, timeoutNS);
+        }
+    }
+}
+
+#endif // SDL_PLATFORM_LINUX
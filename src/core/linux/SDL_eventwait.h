@@ -0,0 +1,39 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#ifndef SDL_eventwait_h_
+#define SDL_eventwait_h_
+
+/* A set of input file descriptors that SDL_WaitEvent() can block on along
+   with the video backend, so input devices that are read during event pumping
+   wake up a waiting application instead of being polled periodically. */
+
+#define SDL_EVENTWAIT_READY       1 // The file descriptor being waited on is ready
+#define SDL_EVENTWAIT_INPUT_READY 2 // Only input in the wait set is ready
+
+extern bool SDL_EventWait_AddFD(int fd);
+extern void SDL_EventWait_RemoveFD(int fd);
+extern void SDL_EventWait_SetEnabled(bool enabled);
+extern int SDL_EventWait_IOReady(int fd, int flags, Sint64 timeoutNS);
+
+#endif // SDL_eventwait_h_
@@ -528,6 +528,14 @@ static void device_event(SDL_UDEV_deviceevent type, struct udev_device *dev)
     }
 }
 
+int SDL_UDEV_GetMonitorFD(void)
+{
+    if (_this && _this->udev_mon) {
+        return _this->syms.udev_monitor_get_fd(_this->udev_mon);
+    }
+    return -1;
+}
+
 void SDL_UDEV_Poll(void)
 {
     struct udev_device *dev = NULL;
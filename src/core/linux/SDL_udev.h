@@ -103,6 +103,7 @@ extern void SDL_UDEV_Quit(void);
 extern void SDL_UDEV_UnloadLibrary(void);
 extern bool SDL_UDEV_LoadLibrary(void);
 extern void SDL_UDEV_Poll(void);
+extern int SDL_UDEV_GetMonitorFD(void);
 extern bool SDL_UDEV_Scan(void);
 extern bool SDL_UDEV_GetProductInfo(const char *device_path, struct input_id *inpid, int *class, char **driver);
 extern bool SDL_UDEV_AddCallback(SDL_UDEV_Callback cb);
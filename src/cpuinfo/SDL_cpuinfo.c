@@ -1054,8 +1054,11 @@ static Uint32 SDL_GetCPUFeatures(void)
     return SDL_CPUFeatures;
 }
 
+static void *SDL_CPUTopologyInfo = NULL;
+
 void SDL_QuitCPUInfo(void) {
     SDL_CPUFeatures = SDL_CPUFEATURES_RESET_VALUE;
+    SDL_free(SDL_SetAtomicPointer(&SDL_CPUTopologyInfo, NULL));
 }
 
 #define CPU_FEATURE_AVAILABLE(f) ((SDL_GetCPUFeatures() & (f)) ? true : false)
@@ -1222,3 +1225,367 @@ size_t SDL_GetSIMDAlignment(void)
     SDL_assert(SDL_SIMDAlignment != 0);
     return SDL_SIMDAlignment;
 }
+
+// A sanity limit for CPU numbers in CPU lists
+#define SDL_MAX_CPUS 65536
+
+bool SDL_ParseCPUList(const char *list, int **cpus, int *num_cpus)
+{
+    const char *p = list;
+    int *result = NULL;
+    int count = 0;
+    int max_count = 0;
+
+    *cpus = NULL;
+    *num_cpus = 0;
+
+    while (*p) {
+        char *end;
+        long first, last, cpu;
+
+        while (*p == ',' || SDL_isspace(*p)) {
+            ++p;
+        }
+        if (!*p) {
+            break;
+        }
+
+        first = SDL_strtol(p, &end, 10);
+        if (end == p || first < 0) {
+            goto invalid;
+        }
+        p = end;
+        last = first;
+        if (*p == '-') {
+            ++p;
+            last = SDL_strtol(p, &end, 10);
+            if (end == p || last < first) {
+                goto invalid;
+            }
+            p = end;
+        }
+        if (*p && *p != ',' && !SDL_isspace(*p)) {
+            goto invalid;
+        }
+        if (last >= SDL_MAX_CPUS) {
+            goto invalid;
+        }
+
+        for (cpu = first; cpu <= last; ++cpu) {
+            if (count == max_count) {
+                int *new_result;
+                max_count = max_count ? (max_count * 2) : 16;
+                new_result = (int *)SDL_realloc(result, max_count * sizeof(*result));
+                if (!new_result) {
+                    SDL_free(result);
+                    return false;
+                }
+                result = new_result;
+            }
+            result[count++] = (int)cpu;
+        }
+    }
+
+    *cpus = result;
+    *num_cpus = count;
+    return true;
+
+invalid:
+    SDL_free(result);
+    return SDL_SetError("Invalid CPU list '%s'", list);
+}
+
+static void CPU_GetCacheSizesFromCPUID(SDL_CPUTopology *topology)
+{
+    int a, b, c, d;
+
+    CPU_calcCPUIDFeatures();
+    if (CPU_CPUIDMaxFunction <= 0) {
+        return;
+    }
+
+    if (CPU_CPUIDMaxFunction >= 4) {
+        // Deterministic cache parameters, the first entry is the L1 data cache on Intel CPUs
+        cpuid(4, a, b, c, d);
+        if ((a & 0x1f) == 1 && ((a >> 5) & 0x7) == 1) {
+            topology->l1d_cache_size = (((b >> 22) & 0x3ff) + 1) * (((b >> 12) & 0x3ff) + 1) * ((b & 0xfff) + 1) * (c + 1);
+        }
+    }
+
+    cpuid(0x80000000, a, b, c, d);
+    if ((Uint32)a >= 0x80000005 && !topology->l1d_cache_size) {
+        cpuid(0x80000005, a, b, c, d);
+        topology->l1d_cache_size = ((c >> 24) & 0xff) * 1024;
+    }
+    if ((Uint32)a >= 0x80000006) {
+        cpuid(0x80000006, a, b, c, d);
+        topology->l2_cache_size = ((c >> 16) & 0xffff) * 1024;
+        topology->l3_cache_size = ((d >> 18) & 0x3fff) * 512 * 1024;
+    }
+}
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+
+// Return the index of id in ids, adding it if it's not there yet
+static int CPU_MapID(int *ids, int *num_ids, int id)
+{
+    int i;
+
+    for (i = 0; i < *num_ids; ++i) {
+        if (ids[i] == id) {
+            return i;
+        }
+    }
+    ids[*num_ids] = id;
+    return (*num_ids)++;
+}
+
+static bool CPU_ReadSysfs(char *buf, size_t buflen, SDL_PRINTF_FORMAT_STRING const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(3);
+static bool CPU_ReadSysfs(char *buf, size_t buflen, SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
+{
+    char path[128];
+    va_list ap;
+    FILE *f;
+    bool result = false;
+
+    va_start(ap, fmt);
+    SDL_vsnprintf(path, sizeof(path), fmt, ap);
+    va_end(ap);
+
+    f = fopen(path, "r");
+    if (f) {
+        if (fgets(buf, (int)buflen, f)) {
+            result = true;
+        }
+        fclose(f);
+    }
+    return result;
+}
+
+static int CPU_ReadSysfsCacheSize(int index)
+{
+    char buf[32];
+    char *end;
+    long size;
+
+    if (!CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index)) {
+        return 0;
+    }
+    size = SDL_strtol(buf, &end, 10);
+    if (*end == 'K') {
+        size *= 1024;
+    } else if (*end == 'M') {
+        size *= 1024 * 1024;
+    }
+    return (int)size;
+}
+
+static bool CPU_GetTopologyFromSysfs(SDL_CPUTopology *topology, SDL_LogicalCPU *cpus)
+{
+    char buf[256];
+    int *list = NULL;
+    int *cores = NULL;
+    int *packages = NULL;
+    int *nodes = NULL;
+    int *capacities = NULL;
+    int num_list = 0;
+    int min_capacity = 0;
+    int max_capacity = 0;
+    int i, j;
+    bool hybrid = false;
+
+    cores = (int *)SDL_calloc(3 * topology->num_logical_cores, sizeof(*cores));
+    if (!cores) {
+        return false;
+    }
+    packages = cores + topology->num_logical_cores;
+    capacities = packages + topology->num_logical_cores;
+
+    for (i = 0; i < topology->num_logical_cores; ++i) {
+        SDL_LogicalCPU *cpu = &cpus[i];
+        int package = 0;
+        int core = cpu->cpu;
+
+        if (CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu->cpu)) {
+            package = SDL_atoi(buf);
+        }
+
+        // SMT siblings share a core, identify it by its first CPU
+        if (CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu->cpu) &&
+            SDL_ParseCPUList(buf, &list, &num_list)) {
+            if (num_list > 0) {
+                core = list[0];
+            }
+            SDL_free(list);
+        }
+
+        cpu->package = CPU_MapID(packages, &topology->num_packages, package);
+        cpu->core = CPU_MapID(cores, &topology->num_physical_cores, core);
+
+        if (CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpu->cpu)) {
+            capacities[i] = SDL_atoi(buf);
+            if (capacities[i] > 0) {
+                min_capacity = min_capacity ? SDL_min(min_capacity, capacities[i]) : capacities[i];
+                max_capacity = SDL_max(max_capacity, capacities[i]);
+            }
+        }
+    }
+
+    /* Intel hybrid CPUs list the efficiency cores as a separate PMU, ARM big.LITTLE reports a lower capacity.
+       ARM chips may have more than two clusters, and only the slowest one is made of efficiency cores. */
+    if (CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/cpu_atom/cpus") &&
+        SDL_ParseCPUList(buf, &list, &num_list)) {
+        for (i = 0; i < topology->num_logical_cores; ++i) {
+            for (j = 0; j < num_list; ++j) {
+                if (cpus[i].cpu == list[j]) {
+                    cpus[i].type = SDL_CPU_CORE_EFFICIENCY;
+                    hybrid = true;
+                }
+            }
+        }
+        SDL_free(list);
+    }
+    if (!hybrid && min_capacity < max_capacity) {
+        for (i = 0; i < topology->num_logical_cores; ++i) {
+            if (capacities[i] == min_capacity) {
+                cpus[i].type = SDL_CPU_CORE_EFFICIENCY;
+            }
+        }
+    }
+
+    // NUMA nodes, if the kernel supports them
+    if (CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/node/online") &&
+        SDL_ParseCPUList(buf, &nodes, &topology->num_numa_nodes)) {
+        for (i = 0; i < topology->num_numa_nodes; ++i) {
+            char *nodelist = (char *)SDL_malloc(4096);
+            if (nodelist && CPU_ReadSysfs(nodelist, 4096, "/sys/devices/system/node/node%d/cpulist", nodes[i]) &&
+                SDL_ParseCPUList(nodelist, &list, &num_list)) {
+                int k;
+                for (j = 0; j < topology->num_logical_cores; ++j) {
+                    for (k = 0; k < num_list; ++k) {
+                        if (cpus[j].cpu == list[k]) {
+                            cpus[j].numa_node = i;
+                        }
+                    }
+                }
+                SDL_free(list);
+            }
+            SDL_free(nodelist);
+        }
+        SDL_free(nodes);
+    }
+    if (topology->num_numa_nodes <= 0) {
+        topology->num_numa_nodes = 1;
+    }
+
+    // Count physical cores by type, using the first logical CPU of each
+    for (i = 0; i < topology->num_physical_cores; ++i) {
+        for (j = 0; j < topology->num_logical_cores; ++j) {
+            if (cpus[j].core == i) {
+                if (cpus[j].type == SDL_CPU_CORE_EFFICIENCY) {
+                    ++topology->num_efficiency_cores;
+                } else {
+                    ++topology->num_performance_cores;
+                }
+                break;
+            }
+        }
+    }
+
+    // Cache sizes as seen by the first CPU
+    for (i = 0; CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/cpu/cpu0/cache/index%d/level", i); ++i) {
+        const int level = SDL_atoi(buf);
+        if (!CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/cpu/cpu0/cache/index%d/type", i) ||
+            SDL_strncmp(buf, "Instruction", 11) == 0) {
+            continue;
+        }
+        if (level == 1) {
+            topology->l1d_cache_size = CPU_ReadSysfsCacheSize(i);
+        } else if (level == 2) {
+            topology->l2_cache_size = CPU_ReadSysfsCacheSize(i);
+        } else if (level == 3) {
+            topology->l3_cache_size = CPU_ReadSysfsCacheSize(i);
+        }
+    }
+
+    SDL_free(cores);
+    return true;
+}
+#endif // SDL_PLATFORM_LINUX || SDL_PLATFORM_ANDROID
+
+static SDL_CPUTopology *CPU_CreateTopology(void)
+{
+    SDL_CPUTopology *topology;
+    SDL_LogicalCPU *cpus;
+    int *online = NULL;
+    int num_online = 0;
+    int i;
+    bool found = false;
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+    {
+        char buf[256];
+        if (CPU_ReadSysfs(buf, sizeof(buf), "/sys/devices/system/cpu/online")) {
+            SDL_ParseCPUList(buf, &online, &num_online);
+        }
+    }
+#endif
+    if (num_online <= 0) {
+        SDL_free(online);
+        online = NULL;
+        num_online = SDL_GetNumLogicalCPUCores();
+    }
+
+    topology = (SDL_CPUTopology *)SDL_calloc(1, sizeof(*topology) + num_online * sizeof(*cpus));
+    if (!topology) {
+        SDL_free(online);
+        return NULL;
+    }
+    cpus = (SDL_LogicalCPU *)(topology + 1);
+    topology->cpus = cpus;
+    topology->num_logical_cores = num_online;
+    for (i = 0; i < num_online; ++i) {
+        cpus[i].cpu = online ? online[i] : i;
+    }
+    SDL_free(online);
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+    if (CPU_GetTopologyFromSysfs(topology, cpus)) {
+        found = true;
+    }
+#endif
+
+    if (!found) {
+        // Assume every logical CPU is a separate core
+        for (i = 0; i < num_online; ++i) {
+            cpus[i].core = i;
+        }
+        topology->num_physical_cores = num_online;
+        topology->num_performance_cores = num_online;
+        topology->num_packages = 1;
+        topology->num_numa_nodes = 1;
+    }
+
+    if (!topology->l1d_cache_size && !topology->l2_cache_size) {
+        CPU_GetCacheSizesFromCPUID(topology);
+    }
+    return topology;
+}
+
+const SDL_CPUTopology *SDL_GetCPUTopology(void)
+{
+    SDL_CPUTopology *topology = (SDL_CPUTopology *)SDL_GetAtomicPointer(&SDL_CPUTopologyInfo);
+
+    if (!topology) {
+        topology = CPU_CreateTopology();
+        if (!topology) {
+            return NULL;
+        }
+        if (!SDL_CompareAndSwapAtomicPointer(&SDL_CPUTopologyInfo, NULL, topology)) {
+            // Another thread got there first
+            SDL_free(topology);
+            topology = (SDL_CPUTopology *)SDL_GetAtomicPointer(&SDL_CPUTopologyInfo);
+        }
+    }
+    return topology;
+}
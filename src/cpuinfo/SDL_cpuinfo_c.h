@@ -24,4 +24,7 @@
 
 extern void SDL_QuitCPUInfo(void);
 
+// Parse a list of CPU numbers and ranges, like "0-3,6", into an array that should be freed with SDL_free()
+extern bool SDL_ParseCPUList(const char *list, int **cpus, int *num_cpus);
+
 #endif // SDL_cpuinfo_c_h_
@@ -1282,3 +1282,27 @@
 #define SDL_hid_get_properties SDL_hid_get_properties_REAL
 #define SDL_GetPixelFormatFromGPUTextureFormat SDL_GetPixelFormatFromGPUTextureFormat_REAL
 #define SDL_GetGPUTextureFormatFromPixelFormat SDL_GetGPUTextureFormatFromPixelFormat_REAL
+#define SDL_GetAudioDeviceProperties SDL_GetAudioDeviceProperties_REAL
+#define SDL_LoadWAVStream_IO SDL_LoadWAVStream_IO_REAL
+#define SDL_LoadWAVStream SDL_LoadWAVStream_REAL
+#define SDL_GetCoalescedEventCount SDL_GetCoalescedEventCount_REAL
+#define SDL_PushEvents SDL_PushEvents_REAL
+#define SDL_GetEventLatencyHistogram SDL_GetEventLatencyHistogram_REAL
+#define SDL_ResetEventLatencyHistograms SDL_ResetEventLatencyHistograms_REAL
+#define SDL_CreateThreadPool SDL_CreateThreadPool_REAL
+#define SDL_DestroyThreadPool SDL_DestroyThreadPool_REAL
+#define SDL_CreateJobGroup SDL_CreateJobGroup_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_WaitJobGroup SDL_WaitJobGroup_REAL
+#define SDL_DestroyJobGroup SDL_DestroyJobGroup_REAL
+#define SDL_ParallelFor SDL_ParallelFor_REAL
+#define SDL_GetCPUTopology SDL_GetCPUTopology_REAL
+#define SDL_SetCurrentThreadAffinity SDL_SetCurrentThreadAffinity_REAL
+#define SDL_CreateArena SDL_CreateArena_REAL
+#define SDL_AllocateArenaMemory SDL_AllocateArenaMemory_REAL
+#define SDL_GetArenaMark SDL_GetArenaMark_REAL
+#define SDL_ResetArenaToMark SDL_ResetArenaToMark_REAL
+#define SDL_ResetArena SDL_ResetArena_REAL
+#define SDL_DestroyArena SDL_DestroyArena_REAL
+#define SDL_GetThreadArena SDL_GetThreadArena_REAL
+#define SDL_InternString SDL_InternString_REAL
@@ -1290,3 +1290,27 @@ SDL_DYNAPI_PROC(Uint32,SDL_AddAtomicU32,(SDL_AtomicU32 *a,int b),(a,b),return)
 SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_hid_get_properties,(SDL_hid_device *a),(a),return)
 SDL_DYNAPI_PROC(SDL_PixelFormat,SDL_GetPixelFormatFromGPUTextureFormat,(SDL_GPUTextureFormat a),(a),return)
 SDL_DYNAPI_PROC(SDL_GPUTextureFormat,SDL_GetGPUTextureFormatFromPixelFormat,(SDL_PixelFormat a),(a),return)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_GetAudioDeviceProperties,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_LoadWAVStream_IO,(SDL_IOStream *a,bool b,SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_LoadWAVStream,(const char *a,SDL_AudioSpec *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetCoalescedEventCount,(const SDL_Event *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_PushEvents,(SDL_Event *a,int b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetEventLatencyHistogram,(Uint32 a,SDL_EventLatencyStage b,SDL_EventLatencyHistogram *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_ResetEventLatencyHistograms,(void),(),)
+SDL_DYNAPI_PROC(SDL_ThreadPool*,SDL_CreateThreadPool,(int a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyThreadPool,(SDL_ThreadPool *a),(a),)
+SDL_DYNAPI_PROC(SDL_JobGroup*,SDL_CreateJobGroup,(SDL_ThreadPool *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SubmitJob,(SDL_JobGroup *a,SDL_JobFunction b,void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJobGroup,(SDL_JobGroup *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DestroyJobGroup,(SDL_JobGroup *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_ParallelFor,(SDL_ThreadPool *a,int b,int c,SDL_ParallelForFunction d,void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(const SDL_CPUTopology*,SDL_GetCPUTopology,(void),(),return)
+SDL_DYNAPI_PROC(bool,SDL_SetCurrentThreadAffinity,(const int *a,int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Arena*,SDL_CreateArena,(size_t a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_AllocateArenaMemory,(SDL_Arena *a,size_t b,size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_ArenaMark,SDL_GetArenaMark,(SDL_Arena *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ResetArenaToMark,(SDL_Arena *a,SDL_ArenaMark b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_ResetArena,(SDL_Arena *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DestroyArena,(SDL_Arena *a),(a),)
+SDL_DYNAPI_PROC(SDL_Arena*,SDL_GetThreadArena,(void),(),return)
+SDL_DYNAPI_PROC(const char*,SDL_InternString,(const char *a),(a),return)
@@ -26,6 +26,7 @@
 #include "SDL_eventwatch_c.h"
 #include "SDL_windowevents_c.h"
 #include "../SDL_hints_c.h"
+#include "../SDL_mempool.h"
 #include "../audio/SDL_audio_c.h"
 #include "../camera/SDL_camera_c.h"
 #include "../timer/SDL_timer_c.h"
@@ -42,6 +43,10 @@
 #include "../video/android/SDL_androidevents.h"
 #endif
 
+#ifdef SDL_PLATFORM_LINUX
+#include "../core/linux/SDL_eventwait.h"
+#endif
+
 // An arbitrary limit so we don't have unbounded growth
 #define SDL_MAX_QUEUED_EVENTS 65535
 
@@ -112,17 +117,31 @@ typedef struct
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static SDL_AtomicInt SDL_userevents;
 
+/* Temporary memory is allocated from per-thread chunks. A chunk is kept
+   alive by the thread that allocated from it and by every event that owns
+   memory in it, and is freed when the last of those lets go of it. */
+#define SDL_TEMPORARY_CHUNK_SIZE    4096
+#define SDL_TEMPORARY_MEMORY_ALIGN  16
+#define SDL_MAX_EVENT_MEMORY_CHUNKS 2
+#define SDL_TEMPORARY_MEMORY_LINKS  8 // Chunks in a list of them, for events that need more than SDL_MAX_EVENT_MEMORY_CHUNKS
+
 typedef struct SDL_TemporaryMemory
 {
-    void *memory;
-    struct SDL_TemporaryMemory *prev;
-    struct SDL_TemporaryMemory *next;
+    SDL_AtomicInt refcount;
+    size_t size;
+    size_t used;
+    bool links; // The data is a list of other chunks this one keeps alive
 } SDL_TemporaryMemory;
 
+#define SDL_TEMPORARY_CHUNK_HEADER ((sizeof(SDL_TemporaryMemory) + (SDL_TEMPORARY_MEMORY_ALIGN - 1)) & ~(size_t)(SDL_TEMPORARY_MEMORY_ALIGN - 1))
+#define SDL_TEMPORARY_CHUNK_DATA(chunk) ((Uint8 *)(chunk) + SDL_TEMPORARY_CHUNK_HEADER)
+
 typedef struct SDL_TemporaryMemoryState
 {
-    SDL_TemporaryMemory *head;
-    SDL_TemporaryMemory *tail;
+    SDL_TemporaryMemory *chunk;     // The chunk currently being allocated from
+    SDL_TemporaryMemory **released; // Chunks to let go of in SDL_FreeTemporaryMemory()
+    int num_released;
+    int max_released;
 } SDL_TemporaryMemoryState;
 
 static SDL_TLSID SDL_temporary_memory;
@@ -130,28 +149,128 @@ static SDL_TLSID SDL_temporary_memory;
 typedef struct SDL_EventEntry
 {
     SDL_Event event;
-    SDL_TemporaryMemory *memory;
+    SDL_TemporaryMemory *memory[SDL_MAX_EVENT_MEMORY_CHUNKS];
+    Uint64 queued;                      // When the event was queued, if latency is being traced
+    Uint32 id;                          // Increases with each event added to the list
+    struct SDL_EventTypeBlock *type_block;
+    struct SDL_EventTypeList *type_list; // NULL if the event isn't in the type index
+    struct SDL_EventEntry *type_prev;
+    struct SDL_EventEntry *type_next;
     struct SDL_EventEntry *prev;
     struct SDL_EventEntry *next;
 } SDL_EventEntry;
 
+/* Queued events are also linked into a list per event type, so looking for or
+   flushing specific types only has to touch the matching events. The lists are
+   kept in blocks of 256 types, like the disabled event state, with a count for
+   each block so unused ranges of types can be skipped quickly. */
+typedef struct SDL_EventTypeList
+{
+    SDL_EventEntry *head;
+    SDL_EventEntry *tail;
+    int count;
+} SDL_EventTypeList;
+
+typedef struct SDL_EventTypeBlock
+{
+    int count;
+    SDL_EventTypeList types[256];
+} SDL_EventTypeBlock;
+
+// The most event types that are merged back into queue order, more than this uses the main list.
+#define SDL_MAX_MERGED_EVENT_TYPES 8
+
 static struct
 {
     SDL_Mutex *lock;
     bool active;
     SDL_AtomicInt count;
-    int max_events_seen;
+    SDL_AtomicInt max_events_seen;
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
-    SDL_EventEntry *free;
-} SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL };
+    SDL_MemoryPool entry_pool;
+    SDL_EventTypeBlock *types[256];
+    int unindexed; // Number of queued events that aren't in the type index
+} SDL_EventQ = { NULL, false, { 0 }, { 0 }, NULL, NULL, SDL_MEMORY_POOL_INITIALIZER(sizeof(SDL_EventEntry), SDL_MAX_QUEUED_EVENTS, false), { NULL }, 0 };
+
+/* Latency histograms for each event type, see SDL_GetEventLatencyHistogram().
+   These are kept in blocks of 256 types and protected by the queue lock. */
+typedef struct SDL_EventLatency
+{
+    SDL_EventLatencyHistogram stages[2];
+} SDL_EventLatency;
+
+typedef struct
+{
+    SDL_EventLatency *types[256];
+} SDL_EventLatencyBlock;
+
+static SDL_EventLatencyBlock *SDL_event_latency[256];
+
+/* Events are pushed to this lock-free ring first, so producers on other threads
+   don't contend with each other or with the thread polling for events. The list
+   in SDL_EventQ always holds older events than the ring; anything that has to
+   look at the whole queue moves the ring's events to the list first, under the
+   queue lock. Polling for any event takes them straight from the ring while the
+   list is empty. */
+#define SDL_EVENT_RING_SIZE 1024 // Must be a power of two
+
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicU32 sequence;
+    SDL_EventEntry entry; // Only the event and its memory are used here.
+} SDL_EventRingSlot;
+
+static struct
+{
+    SDL_AtomicU32 enqueue_pos;
+    Uint8 pad1[SDL_CACHELINE_SIZE - sizeof(SDL_AtomicU32)];
+    Uint32 dequeue_pos; // Protected by SDL_EventQ.lock
+    Uint8 pad2[SDL_CACHELINE_SIZE - sizeof(Uint32)];
+    SDL_AtomicInt active;
+    SDL_AtomicInt pushing; // Number of threads currently pushing to the ring.
+    SDL_EventRingSlot *slots;
+} SDL_EventRing;
+
+static bool SDL_DequeueEventRing(SDL_EventEntry *entry);
+static void SDL_ResetEventLatency(void);
+
+// Spin briefly, then give up the timeslice, the thread we're waiting for might not be running
+static void SDL_EventRingSpinWait(int *iterations)
+{
+    if (*iterations < 32) {
+        ++*iterations;
+        SDL_CPUPauseInstruction();
+    } else {
+        SDL_Delay(0);
+    }
+}
+
+
+static void SDL_ReleaseTemporaryMemoryChunk(SDL_TemporaryMemory *chunk)
+{
+    if (SDL_AddAtomicInt(&chunk->refcount, -1) == 1) {
+        if (chunk->links) {
+            SDL_TemporaryMemory **links = (SDL_TemporaryMemory **)SDL_TEMPORARY_CHUNK_DATA(chunk);
+            size_t i;
 
+            for (i = 0; i < chunk->used / sizeof(*links); ++i) {
+                SDL_ReleaseTemporaryMemoryChunk(links[i]);
+            }
+        }
+        SDL_free(chunk);
+    }
+}
 
 static void SDL_CleanupTemporaryMemory(void *data)
 {
     SDL_TemporaryMemoryState *state = (SDL_TemporaryMemoryState *)data;
 
     SDL_FreeTemporaryMemory();
+    if (state->chunk) {
+        SDL_ReleaseTemporaryMemoryChunk(state->chunk);
+    }
+    SDL_free(state->released);
     SDL_free(state);
 }
 
@@ -178,76 +297,106 @@ static SDL_TemporaryMemoryState *SDL_GetTemporaryMemoryState(bool create)
     return state;
 }
 
-static SDL_TemporaryMemory *SDL_GetTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, const void *mem)
+// Hold on to a reference to a chunk until the next SDL_FreeTemporaryMemory()
+static bool SDL_ReleaseTemporaryMemoryLater(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *chunk)
 {
-    SDL_TemporaryMemory *entry;
-
-    // Start from the end, it's likely to have been recently allocated
-    for (entry = state->tail; entry; entry = entry->prev) {
-        if (mem == entry->memory) {
-            return entry;
+    if (state->num_released == state->max_released) {
+        const int max_released = state->max_released ? state->max_released * 2 : 16;
+        SDL_TemporaryMemory **released = (SDL_TemporaryMemory **)SDL_realloc(state->released, max_released * sizeof(*released));
+        if (!released) {
+            return false;
         }
+        state->released = released;
+        state->max_released = max_released;
     }
-    return NULL;
+    state->released[state->num_released++] = chunk;
+    return true;
 }
 
-static void SDL_LinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry)
+static SDL_TemporaryMemory *SDL_CreateTemporaryMemoryChunk(size_t size)
 {
-    entry->prev = state->tail;
-    entry->next = NULL;
-
-    if (state->tail) {
-        state->tail->next = entry;
-    } else {
-        state->head = entry;
+    SDL_TemporaryMemory *chunk = (SDL_TemporaryMemory *)SDL_malloc(SDL_TEMPORARY_CHUNK_HEADER + size);
+    if (chunk) {
+        SDL_SetAtomicInt(&chunk->refcount, 1);
+        chunk->size = size;
+        chunk->used = 0;
+        chunk->links = false;
     }
-    state->tail = entry;
+    return chunk;
 }
 
-static void SDL_UnlinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry)
+static bool SDL_IsInTemporaryMemoryChunk(const SDL_TemporaryMemory *chunk, const void *mem)
 {
-    if (state->head == entry) {
-        state->head = entry->next;
-    }
-    if (state->tail == entry) {
-        state->tail = entry->prev;
-    }
-
-    if (entry->prev) {
-        entry->prev->next = entry->next;
-    }
-    if (entry->next) {
-        entry->next->prev = entry->prev;
-    }
-
-    entry->prev = NULL;
-    entry->next = NULL;
+    const Uint8 *data = SDL_TEMPORARY_CHUNK_DATA(chunk);
+    return (const Uint8 *)mem >= data && (const Uint8 *)mem < data + chunk->used;
 }
 
-static void SDL_FreeTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry, bool free_data)
+// Find the chunk this thread allocated some temporary memory from
+static SDL_TemporaryMemory *SDL_GetTemporaryMemoryChunk(SDL_TemporaryMemoryState *state, const void *mem)
 {
-    if (free_data) {
-        SDL_free(entry->memory);
+    int i;
+
+    // Start with the current chunk, it's likely to have been recently allocated
+    if (state->chunk && SDL_IsInTemporaryMemoryChunk(state->chunk, mem)) {
+        return state->chunk;
     }
-    SDL_free(entry);
+    for (i = state->num_released; i--;) {
+        if (SDL_IsInTemporaryMemoryChunk(state->released[i], mem)) {
+            return state->released[i];
+        }
+    }
+    return NULL;
 }
 
 static void SDL_LinkTemporaryMemoryToEvent(SDL_EventEntry *event, const void *mem)
 {
     SDL_TemporaryMemoryState *state;
-    SDL_TemporaryMemory *entry;
+    SDL_TemporaryMemory *chunk, *links;
+    int i;
+
+    if (!mem) {
+        return;
+    }
 
     state = SDL_GetTemporaryMemoryState(false);
     if (!state) {
         return;
     }
 
-    entry = SDL_GetTemporaryMemoryEntry(state, mem);
-    if (entry) {
-        SDL_UnlinkTemporaryMemoryEntry(state, entry);
-        entry->next = event->memory;
-        event->memory = entry;
+    chunk = SDL_GetTemporaryMemoryChunk(state, mem);
+    if (!chunk) {
+        return;
+    }
+
+    // The event keeps the whole chunk alive, once no matter how much of its memory is in it
+    for (i = 0; i < SDL_arraysize(event->memory); ++i) {
+        if (event->memory[i] == chunk) {
+            return;
+        }
+        if (!event->memory[i]) {
+            SDL_AddAtomicInt(&chunk->refcount, 1);
+            event->memory[i] = chunk;
+            return;
+        }
+    }
+
+    /* The event's memory is spread over more chunks than it has room for, so the
+       last slot becomes a standalone list of chunks, which is chained if it fills up. */
+    links = event->memory[SDL_arraysize(event->memory) - 1];
+    if (!links->links || links->size - links->used < sizeof(chunk)) {
+        SDL_TemporaryMemory *new_links = SDL_CreateTemporaryMemoryChunk(SDL_TEMPORARY_MEMORY_LINKS * sizeof(chunk));
+        if (!new_links) {
+            return; // The event memory can't be used after all, but you probably have bigger problems if malloc failed.
+        }
+        new_links->links = true;
+        SDL_memcpy(SDL_TEMPORARY_CHUNK_DATA(new_links), &links, sizeof(links));
+        new_links->used = sizeof(links);
+        event->memory[SDL_arraysize(event->memory) - 1] = new_links;
+        links = new_links;
     }
+    SDL_AddAtomicInt(&chunk->refcount, 1);
+    SDL_memcpy(SDL_TEMPORARY_CHUNK_DATA(links) + links->used, &chunk, sizeof(chunk));
+    links->used += sizeof(chunk);
 }
 
 static void SDL_TransferSysWMMemoryToEvent(SDL_EventEntry *event)
@@ -261,7 +410,7 @@ static void SDL_TransferSysWMMemoryToEvent(SDL_EventEntry *event)
     }
 }
 
-// Transfer the event memory from the thread-local event memory list to the event
+// Transfer the event memory from the thread-local temporary memory to the event
 static void SDL_TransferTemporaryMemoryToEvent(SDL_EventEntry *event)
 {
     switch (event->event.type) {
@@ -294,81 +443,83 @@ static void SDL_TransferTemporaryMemoryToEvent(SDL_EventEntry *event)
     }
 }
 
-// Transfer the event memory from the event to the thread-local event memory list
+// Transfer the event memory from the event to the thread-local temporary memory
 static void SDL_TransferTemporaryMemoryFromEvent(SDL_EventEntry *event)
 {
     SDL_TemporaryMemoryState *state;
-    SDL_TemporaryMemory *entry, *next;
+    int i;
 
-    if (!event->memory) {
+    if (!event->memory[0]) {
         return;
     }
 
     state = SDL_GetTemporaryMemoryState(true);
-    if (!state) {
-        return;  // this is now a leak, but you probably have bigger problems if malloc failed.
-    }
-
-    for (entry = event->memory; entry; entry = next) {
-        next = entry->next;
-        SDL_LinkTemporaryMemoryEntry(state, entry);
+    for (i = 0; i < SDL_arraysize(event->memory) && event->memory[i]; ++i) {
+        if (!state || !SDL_ReleaseTemporaryMemoryLater(state, event->memory[i])) {
+            SDL_ReleaseTemporaryMemoryChunk(event->memory[i]);  // The event memory can't be used after all, but you probably have bigger problems if malloc failed.
+        }
+        event->memory[i] = NULL;
     }
-    event->memory = NULL;
 }
 
-static void *SDL_FreeLater(void *memory)
+void *SDL_AllocateTemporaryMemory(size_t size)
 {
     SDL_TemporaryMemoryState *state;
-
-    if (memory == NULL) {
-        return NULL;
-    }
-
-    // Make sure we're not adding this to the list twice
-    //SDL_assert(!SDL_ClaimTemporaryMemory(memory));
+    SDL_TemporaryMemory *chunk;
+    void *mem;
 
     state = SDL_GetTemporaryMemoryState(true);
     if (!state) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed.
+        return NULL;
     }
 
-    SDL_TemporaryMemory *entry = (SDL_TemporaryMemory *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed. We could probably pool up and reuse entries, though.
+    size = (size + (SDL_TEMPORARY_MEMORY_ALIGN - 1)) & ~(size_t)(SDL_TEMPORARY_MEMORY_ALIGN - 1);
+    if (size == 0) {
+        size = SDL_TEMPORARY_MEMORY_ALIGN;
     }
 
-    entry->memory = memory;
-
-    SDL_LinkTemporaryMemoryEntry(state, entry);
+    if (size > SDL_TEMPORARY_CHUNK_SIZE / 4) {
+        // Large allocations get a chunk of their own
+        chunk = SDL_CreateTemporaryMemoryChunk(size);
+        if (!chunk) {
+            return NULL;
+        }
+        if (!SDL_ReleaseTemporaryMemoryLater(state, chunk)) {
+            SDL_free(chunk);
+            return NULL;
+        }
+        chunk->used = size;
+        return SDL_TEMPORARY_CHUNK_DATA(chunk);
+    }
 
-    return memory;
-}
+    chunk = state->chunk;
+    if (!chunk || chunk->size - chunk->used < size) {
+        SDL_TemporaryMemory *new_chunk = SDL_CreateTemporaryMemoryChunk(SDL_TEMPORARY_CHUNK_SIZE);
+        if (!new_chunk) {
+            return NULL;
+        }
+        if (chunk && !SDL_ReleaseTemporaryMemoryLater(state, chunk)) {
+            SDL_free(new_chunk);
+            return NULL;
+        }
+        chunk = new_chunk;
+        state->chunk = chunk;
+    }
 
-void *SDL_AllocateTemporaryMemory(size_t size)
-{
-    return SDL_FreeLater(SDL_malloc(size));
+    mem = SDL_TEMPORARY_CHUNK_DATA(chunk) + chunk->used;
+    chunk->used += size;
+    return mem;
 }
 
 const char *SDL_CreateTemporaryString(const char *string)
 {
     if (string) {
-        return (const char *)SDL_FreeLater(SDL_strdup(string));
-    }
-    return NULL;
-}
-
-void *SDL_ClaimTemporaryMemory(const void *mem)
-{
-    SDL_TemporaryMemoryState *state;
-
-    state = SDL_GetTemporaryMemoryState(false);
-    if (state && mem) {
-        SDL_TemporaryMemory *entry = SDL_GetTemporaryMemoryEntry(state, mem);
-        if (entry) {
-            SDL_UnlinkTemporaryMemoryEntry(state, entry);
-            SDL_FreeTemporaryMemoryEntry(state, entry, false);
-            return (void *)mem;
+        const size_t len = SDL_strlen(string) + 1;
+        char *copy = (char *)SDL_AllocateTemporaryMemory(len);
+        if (copy) {
+            SDL_memcpy(copy, string, len);
         }
+        return copy;
     }
     return NULL;
 }
@@ -376,17 +527,26 @@ void *SDL_ClaimTemporaryMemory(const void *mem)
 void SDL_FreeTemporaryMemory(void)
 {
     SDL_TemporaryMemoryState *state;
+    int i;
 
     state = SDL_GetTemporaryMemoryState(false);
     if (!state) {
         return;
     }
 
-    while (state->head) {
-        SDL_TemporaryMemory *entry = state->head;
+    for (i = 0; i < state->num_released; ++i) {
+        SDL_ReleaseTemporaryMemoryChunk(state->released[i]);
+    }
+    state->num_released = 0;
 
-        SDL_UnlinkTemporaryMemoryEntry(state, entry);
-        SDL_FreeTemporaryMemoryEntry(state, entry, true);
+    if (state->chunk) {
+        if (SDL_GetAtomicInt(&state->chunk->refcount) == 1) {
+            // Nothing else is using the current chunk, start over at the beginning
+            state->chunk->used = 0;
+        } else {
+            SDL_ReleaseTemporaryMemoryChunk(state->chunk);
+            state->chunk = NULL;
+        }
     }
 }
 
@@ -430,6 +590,20 @@ static void SDLCALL SDL_EventLoggingChanged(void *userdata, const char *name, co
     SDL_EventLoggingVerbosity = (hint && *hint) ? SDL_clamp(SDL_atoi(hint), 0, 3) : 0;
 }
 
+static bool SDL_coalesce_motion = false;
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_coalesce_motion = SDL_GetStringBoolean(hint, false);
+}
+
+static bool SDL_trace_latency = false;
+
+static void SDLCALL SDL_LatencyTracingChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_trace_latency = SDL_GetStringBoolean(hint, false);
+}
+
 int SDL_GetEventDescription(const SDL_Event *event, char *buf, int buflen)
 {
     if (!event) {
@@ -918,36 +1092,58 @@ void SDL_StopEventLoop(void)
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
     int i;
     SDL_EventEntry *entry;
+    int iterations = 0;
 
     SDL_LockMutex(SDL_EventQ.lock);
 
     SDL_EventQ.active = false;
 
+    // Wait for anyone still pushing to the ring, and drop what they pushed
+    SDL_SetAtomicInt(&SDL_EventRing.active, 0);
+    while (SDL_GetAtomicInt(&SDL_EventRing.pushing) > 0) {
+        SDL_EventRingSpinWait(&iterations);
+    }
+    if (SDL_EventRing.slots) {
+        SDL_EventEntry dropped;
+        while (SDL_DequeueEventRing(&dropped)) {
+            SDL_TransferTemporaryMemoryFromEvent(&dropped);
+        }
+        SDL_free(SDL_EventRing.slots);
+        SDL_EventRing.slots = NULL;
+    }
+
     if (report && SDL_atoi(report)) {
+        SDL_MemoryPoolStats stats;
+
+        SDL_GetMemoryPoolStats(&SDL_EventQ.entry_pool, &stats);
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d",
-                SDL_EventQ.max_events_seen);
+                SDL_GetAtomicInt(&SDL_EventQ.max_events_seen));
+        SDL_Log("SDL EVENT QUEUE: Maximum entries allocated: %d, %d cached for reuse",
+                stats.high_water, stats.num_free);
     }
 
     // Clean out EventQ
     for (entry = SDL_EventQ.head; entry;) {
         SDL_EventEntry *next = entry->next;
         SDL_TransferTemporaryMemoryFromEvent(entry);
-        SDL_free(entry);
-        entry = next;
-    }
-    for (entry = SDL_EventQ.free; entry;) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
+        SDL_FreeMemoryPoolBlock(&SDL_EventQ.entry_pool, entry);
         entry = next;
     }
+    SDL_DestroyMemoryPool(&SDL_EventQ.entry_pool);
 
     SDL_SetAtomicInt(&SDL_EventQ.count, 0);
-    SDL_EventQ.max_events_seen = 0;
+    SDL_SetAtomicInt(&SDL_EventQ.max_events_seen, 0);
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
-    SDL_EventQ.free = NULL;
+    for (i = 0; i < SDL_arraysize(SDL_EventQ.types); ++i) {
+        SDL_free(SDL_EventQ.types[i]);
+        SDL_EventQ.types[i] = NULL;
+    }
+    SDL_EventQ.unindexed = 0;
     SDL_SetAtomicInt(&SDL_sentinel_pending, 0);
 
+    SDL_ResetEventLatency();
+
     // Clear disabled event state
     for (i = 0; i < SDL_arraysize(SDL_disabled_events); ++i) {
         SDL_free(SDL_disabled_events[i]);
@@ -997,6 +1193,22 @@ bool SDL_StartEventLoop(void)
 
     SDL_InitWindowEventWatch();
 
+    if (!SDL_EventRing.slots) {
+        SDL_EventRing.slots = (SDL_EventRingSlot *)SDL_calloc(SDL_EVENT_RING_SIZE, sizeof(*SDL_EventRing.slots));
+        if (!SDL_EventRing.slots) {
+#ifndef SDL_THREADS_DISABLED
+            SDL_UnlockMutex(SDL_EventQ.lock);
+#endif
+            return false;
+        }
+        for (Uint32 i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+            SDL_SetAtomicU32(&SDL_EventRing.slots[i].sequence, i);
+        }
+        SDL_SetAtomicU32(&SDL_EventRing.enqueue_pos, 0);
+        SDL_EventRing.dequeue_pos = 0;
+    }
+    SDL_SetAtomicInt(&SDL_EventRing.active, 1);
+
     SDL_EventQ.active = true;
 
 #ifndef SDL_THREADS_DISABLED
@@ -1005,38 +1217,108 @@ bool SDL_StartEventLoop(void)
     return true;
 }
 
-// Add an event to the event queue -- called with the queue locked
-static int SDL_AddEvent(SDL_Event *event)
+// Get an unused event entry -- called with the queue locked
+static SDL_EventEntry *SDL_AllocateEventEntry(void)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
-    int final_count;
+    return (SDL_EventEntry *)SDL_AllocMemoryPoolBlock(&SDL_EventQ.entry_pool);
+}
 
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
-    }
+// Add an entry to the list for its event type -- called with the queue locked
+static void SDL_IndexEventEntry(SDL_EventEntry *entry)
+{
+    const Uint32 type = entry->event.type;
+    SDL_EventTypeBlock *block = NULL;
+    SDL_EventTypeList *list;
 
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
+    if (type <= SDL_EVENT_LAST) {
+        block = SDL_EventQ.types[type >> 8];
+        if (!block) {
+            block = (SDL_EventTypeBlock *)SDL_calloc(1, sizeof(*block));
+            SDL_EventQ.types[type >> 8] = block;
         }
+    }
+    if (!block) {
+        // The event can still be found by walking the main list
+        entry->type_block = NULL;
+        entry->type_list = NULL;
+        ++SDL_EventQ.unindexed;
+        return;
+    }
+
+    list = &block->types[type & 0xff];
+    entry->type_block = block;
+    entry->type_list = list;
+    entry->type_prev = list->tail;
+    entry->type_next = NULL;
+    if (list->tail) {
+        list->tail->type_next = entry;
     } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
+        list->head = entry;
     }
+    list->tail = entry;
+    ++list->count;
+    ++block->count;
+}
 
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
+// Remove an entry from the list for its event type -- called with the queue locked
+static void SDL_UnindexEventEntry(SDL_EventEntry *entry)
+{
+    SDL_EventTypeList *list = entry->type_list;
+
+    if (!list) {
+        SDL_assert(SDL_EventQ.unindexed > 0);
+        --SDL_EventQ.unindexed;
+        return;
     }
 
-    SDL_copyp(&entry->event, event);
-    if (event->type == SDL_EVENT_POLL_SENTINEL) {
-        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    if (entry->type_prev) {
+        entry->type_prev->type_next = entry->type_next;
+    } else {
+        list->head = entry->type_next;
     }
-    entry->memory = NULL;
-    SDL_TransferTemporaryMemoryToEvent(entry);
+    if (entry->type_next) {
+        entry->type_next->type_prev = entry->type_prev;
+    } else {
+        list->tail = entry->type_prev;
+    }
+    --list->count;
+    --entry->type_block->count;
+}
+
+/* Returns true if the type index has every queued event -- called with the queue locked
+
+   Events that couldn't be indexed may have any type, so any range may be missing some. */
+static bool SDL_IsEventQueueIndexed(void)
+{
+    return SDL_EventQ.unindexed == 0;
+}
+
+/* Find the first event type at or after *type that has queued events, skipping
+   blocks of types that have none -- called with the queue locked */
+static SDL_EventTypeList *SDL_FindEventTypeList(Uint32 *type, Uint32 maxType)
+{
+    maxType = SDL_min(maxType, SDL_EVENT_LAST);
+    while (*type <= maxType) {
+        SDL_EventTypeBlock *block = SDL_EventQ.types[*type >> 8];
+        if (!block || block->count == 0) {
+            *type = ((*type >> 8) + 1) << 8;
+            continue;
+        }
+
+        SDL_EventTypeList *list = &block->types[*type & 0xff];
+        if (list->count > 0) {
+            return list;
+        }
+        ++*type;
+    }
+    return NULL;
+}
+
+// Append an entry to the event list -- called with the queue locked
+static void SDL_LinkEventEntry(SDL_EventEntry *entry)
+{
+    entry->id = ++SDL_last_event_id;
+    SDL_IndexEventEntry(entry);
 
     if (SDL_EventQ.tail) {
         SDL_EventQ.tail->next = entry;
@@ -1050,21 +1332,331 @@ static int SDL_AddEvent(SDL_Event *event)
         entry->prev = NULL;
         entry->next = NULL;
     }
+}
+
+static bool SDL_IsCoalescableEvent(Uint32 type)
+{
+    return type == SDL_EVENT_MOUSE_MOTION ||
+           type == SDL_EVENT_PEN_MOTION ||
+           type == SDL_EVENT_FINGER_MOTION;
+}
+
+// The number of samples merged into a motion event, see SDL_GetCoalescedEventCount()
+static Uint32 *SDL_GetCoalescedSamples(SDL_Event *event)
+{
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        return &event->motion.samples;
+    case SDL_EVENT_PEN_MOTION:
+        return &event->pmotion.samples;
+    case SDL_EVENT_FINGER_MOTION:
+        return &event->tfinger.samples;
+    default:
+        return NULL;
+    }
+}
+
+/* Merge a motion event into the last event in the queue, if that is motion
+   from the same source -- called with the queue locked */
+static bool SDL_CoalesceEvent(const SDL_Event *event)
+{
+    SDL_EventEntry *entry = SDL_EventQ.tail;
+    SDL_Event *last;
+
+    if (!entry || entry->event.type != event->type) {
+        return false;
+    }
 
+    last = &entry->event;
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        if (last->motion.windowID != event->motion.windowID ||
+            last->motion.which != event->motion.which ||
+            last->motion.state != event->motion.state) {
+            return false;
+        }
+        last->motion.x = event->motion.x;
+        last->motion.y = event->motion.y;
+        last->motion.xrel += event->motion.xrel;
+        last->motion.yrel += event->motion.yrel;
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        if (last->pmotion.windowID != event->pmotion.windowID ||
+            last->pmotion.which != event->pmotion.which ||
+            last->pmotion.pen_state != event->pmotion.pen_state) {
+            return false;
+        }
+        last->pmotion.x = event->pmotion.x;
+        last->pmotion.y = event->pmotion.y;
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        if (last->tfinger.windowID != event->tfinger.windowID ||
+            last->tfinger.touchID != event->tfinger.touchID ||
+            last->tfinger.fingerID != event->tfinger.fingerID) {
+            return false;
+        }
+        last->tfinger.x = event->tfinger.x;
+        last->tfinger.y = event->tfinger.y;
+        last->tfinger.dx += event->tfinger.dx;
+        last->tfinger.dy += event->tfinger.dy;
+        last->tfinger.pressure = event->tfinger.pressure;
+        break;
+    default:
+        return false;
+    }
+    last->common.timestamp = event->common.timestamp;
+    ++*SDL_GetCoalescedSamples(last);
+    entry->queued = SDL_trace_latency ? SDL_GetTicksNS() : 0;
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+    return true;
+}
+
+// Fill in an entry for a new event and count it
+static void SDL_PrepareEventEntry(SDL_EventEntry *entry, const SDL_Event *event)
+{
+    int final_count, max_events_seen;
+    Uint32 *samples;
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    SDL_copyp(&entry->event, event);
+    entry->queued = SDL_trace_latency ? SDL_GetTicksNS() : 0;
+    samples = SDL_GetCoalescedSamples(&entry->event);
+    if (samples) {
+        *samples = 1;
+    }
+    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    }
+    SDL_zeroa(entry->memory);
+    SDL_TransferTemporaryMemoryToEvent(entry);
+
+    // Events are pushed from many threads at once without the queue lock
     final_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    max_events_seen = SDL_GetAtomicInt(&SDL_EventQ.max_events_seen);
+    while (final_count > max_events_seen) {
+        if (SDL_CompareAndSwapAtomicInt(&SDL_EventQ.max_events_seen, max_events_seen, final_count)) {
+            break;
+        }
+        max_events_seen = SDL_GetAtomicInt(&SDL_EventQ.max_events_seen);
+    }
+}
+
+// Take the oldest event out of the ring -- called with the queue locked
+static bool SDL_DequeueEventRing(SDL_EventEntry *entry)
+{
+    const Uint32 pos = SDL_EventRing.dequeue_pos;
+    SDL_EventRingSlot *slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+
+    if (SDL_GetAtomicU32(&slot->sequence) != pos + 1) {
+        return false; // Empty, or the next event is still being written.
+    }
+
+    SDL_copyp(&entry->event, &slot->entry.event);
+    SDL_copyp(&entry->memory, &slot->entry.memory);
+    entry->queued = slot->entry.queued;
+    SDL_SetAtomicU32(&slot->sequence, pos + SDL_EVENT_RING_SIZE);
+    SDL_EventRing.dequeue_pos = pos + 1;
+    return true;
+}
+
+/* Move events from the ring to the end of the event list -- called with the queue locked
+   This stops at an event that another thread is still writing, unless wait_for_pushes is
+   set, in which case it waits for everything that has been pushed to the ring so far. */
+static void SDL_DrainEventRing(bool wait_for_pushes)
+{
+    SDL_EventEntry *entry;
+    Uint32 end;
+    int iterations = 0;
+
+    if (!SDL_EventRing.slots) {
+        return;
+    }
+
+    end = SDL_GetAtomicU32(&SDL_EventRing.enqueue_pos);
+    while ((entry = SDL_AllocateEventEntry()) != NULL) {
+        while (!SDL_DequeueEventRing(entry)) {
+            if (!wait_for_pushes || (Sint32)(SDL_EventRing.dequeue_pos - end) >= 0) {
+                SDL_FreeMemoryPoolBlock(&SDL_EventQ.entry_pool, entry);
+                return;
+            }
+            // The thread writing this slot may have been preempted, so don't spin forever
+            SDL_EventRingSpinWait(&iterations);
+        }
+        SDL_LinkEventEntry(entry);
+    }
+}
+
+// Add an event to the ring without locking, returns false if the ring is full
+static bool SDL_EnqueueEventRing(const SDL_Event *event)
+{
+    Uint32 pos = SDL_GetAtomicU32(&SDL_EventRing.enqueue_pos);
+    SDL_EventRingSlot *slot;
+
+    for (;;) {
+        slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+        const Sint32 diff = (Sint32)(SDL_GetAtomicU32(&slot->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicU32(&SDL_EventRing.enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // The ring is full
+        }
+        pos = SDL_GetAtomicU32(&SDL_EventRing.enqueue_pos);
+    }
+
+    SDL_PrepareEventEntry(&slot->entry, event);
+    SDL_SetAtomicU32(&slot->sequence, pos + 1);
+    return true;
+}
+
+// Add an event to the event list -- called with the queue locked
+static int SDL_AddEvent(const SDL_Event *event)
+{
+    SDL_EventEntry *entry;
+    const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
+
+    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_SetError("Event queue is full (%d events)", initial_count);
+        return 0;
+    }
+
+    // Keep the events in order, anything in the ring may have been pushed before this one.
+    SDL_DrainEventRing(true);
+
+    if (SDL_coalesce_motion && SDL_IsCoalescableEvent(event->type) && SDL_CoalesceEvent(event)) {
+        return 1;
+    }
+
+    entry = SDL_AllocateEventEntry();
+    if (entry == NULL) {
+        return 0;
     }
 
-    ++SDL_last_event_id;
+    SDL_PrepareEventEntry(entry, event);
+    SDL_LinkEventEntry(entry);
 
     return 1;
 }
 
+// Add an event to the event queue, without locking it if possible
+static int SDL_PushEventInternal(const SDL_Event *event)
+{
+    int added;
+
+    // Motion that might be coalesced has to look at the end of the list, so skip the ring
+    const bool coalesce = SDL_coalesce_motion && SDL_IsCoalescableEvent(event->type);
+
+    if (!coalesce && SDL_GetAtomicInt(&SDL_EventQ.count) < SDL_MAX_QUEUED_EVENTS) {
+        SDL_AddAtomicInt(&SDL_EventRing.pushing, 1);
+        if (!SDL_GetAtomicInt(&SDL_EventRing.active)) {
+            SDL_AddAtomicInt(&SDL_EventRing.pushing, -1);
+            return -1;
+        }
+        const bool pushed = SDL_EnqueueEventRing(event);
+        SDL_AddAtomicInt(&SDL_EventRing.pushing, -1);
+        if (pushed) {
+            return 1;
+        }
+    }
+
+    // The ring is full (or so is the queue), go through the list instead.
+    SDL_LockMutex(SDL_EventQ.lock);
+    if (SDL_EventQ.active) {
+        added = SDL_AddEvent(event);
+    } else {
+        added = -1;
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return added;
+}
+
+static void SDL_AddEventLatency(SDL_EventLatencyHistogram *histogram, Uint64 latency)
+{
+    const Uint64 us = latency / SDL_NS_PER_US;
+    int bucket;
+
+    if (us == 0) {
+        bucket = 0;
+    } else if (us >= ((Uint64)1 << (SDL_EVENT_LATENCY_BUCKETS - 2))) {
+        bucket = SDL_EVENT_LATENCY_BUCKETS - 1;
+    } else {
+        bucket = SDL_MostSignificantBitIndex32((Uint32)us) + 1;
+    }
+
+    ++histogram->count;
+    histogram->total_ns += latency;
+    if (latency > histogram->max_ns) {
+        histogram->max_ns = latency;
+    }
+    ++histogram->buckets[bucket];
+}
+
+// Record how long an event took to get to the application -- called with the queue locked
+static void SDL_RecordEventLatency(const SDL_EventEntry *entry)
+{
+    const Uint32 type = entry->event.type;
+    SDL_EventLatencyBlock *block;
+    SDL_EventLatency *latency;
+    Uint64 now;
+
+    if (!SDL_trace_latency || !entry->queued || type == SDL_EVENT_POLL_SENTINEL) {
+        return;
+    }
+
+    block = SDL_event_latency[(type >> 8) & 0xFF];
+    if (!block) {
+        block = (SDL_EventLatencyBlock *)SDL_calloc(1, sizeof(*block));
+        if (!block) {
+            return;
+        }
+        SDL_event_latency[(type >> 8) & 0xFF] = block;
+    }
+    latency = block->types[type & 0xFF];
+    if (!latency) {
+        latency = (SDL_EventLatency *)SDL_calloc(1, sizeof(*latency));
+        if (!latency) {
+            return;
+        }
+        block->types[type & 0xFF] = latency;
+    }
+
+    now = SDL_GetTicksNS();
+    SDL_AddEventLatency(&latency->stages[SDL_LATENCY_SOURCE_TO_QUEUE],
+                        (entry->queued > entry->event.common.timestamp) ? (entry->queued - entry->event.common.timestamp) : 0);
+    SDL_AddEventLatency(&latency->stages[SDL_LATENCY_QUEUE_TO_POLL],
+                        (now > entry->queued) ? (now - entry->queued) : 0);
+}
+
+// Free the latency histograms -- called with the queue locked
+static void SDL_ResetEventLatency(void)
+{
+    int i, j;
+
+    for (i = 0; i < SDL_arraysize(SDL_event_latency); ++i) {
+        SDL_EventLatencyBlock *block = SDL_event_latency[i];
+        if (block) {
+            for (j = 0; j < SDL_arraysize(block->types); ++j) {
+                SDL_free(block->types[j]);
+            }
+            SDL_free(block);
+            SDL_event_latency[i] = NULL;
+        }
+    }
+}
+
 // Remove an event from the queue -- called with the queue locked
 static void SDL_CutEvent(SDL_EventEntry *entry)
 {
     SDL_TransferTemporaryMemoryFromEvent(entry);
+    SDL_UnindexEventEntry(entry);
 
     if (entry->prev) {
         entry->prev->next = entry->next;
@@ -1086,8 +1678,7 @@ static void SDL_CutEvent(SDL_EventEntry *entry)
         SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
     }
 
-    entry->next = SDL_EventQ.free;
-    SDL_EventQ.free = entry;
+    SDL_FreeMemoryPoolBlock(&SDL_EventQ.entry_pool, entry);
     SDL_assert(SDL_GetAtomicInt(&SDL_EventQ.count) > 0);
     SDL_AddAtomicInt(&SDL_EventQ.count, -1);
 }
@@ -1110,15 +1701,85 @@ static void SDL_SendWakeupEvent(void)
 #endif
 }
 
+/* Peek at or get events in a range of types using the type index, merging the
+   lists for each type back into queue order. Returns -1 if this would mean
+   merging too many types -- called with the queue locked */
+static int SDL_PeepIndexedEvents(SDL_Event *events, int numevents, SDL_EventAction action, Uint32 minType, Uint32 maxType)
+{
+    SDL_EventEntry *heads[SDL_MAX_MERGED_EVENT_TYPES];
+    SDL_EventTypeList *list;
+    Uint32 type;
+    int i, numheads = 0, used = 0;
+
+    for (type = minType; (list = SDL_FindEventTypeList(&type, maxType)) != NULL; ++type) {
+        if (!events) {
+            used += list->count;
+        } else if (numheads == SDL_arraysize(heads)) {
+            return -1;
+        } else {
+            heads[numheads++] = list->head;
+        }
+    }
+    if (!events) {
+        return used;
+    }
+
+    while (used < numevents) {
+        SDL_EventEntry *entry;
+        int oldest = -1;
+
+        for (i = 0; i < numheads; ++i) {
+            if (heads[i] && (oldest < 0 || (Sint32)(heads[i]->id - heads[oldest]->id) < 0)) {
+                oldest = i;
+            }
+        }
+        if (oldest < 0) {
+            break;
+        }
+
+        entry = heads[oldest];
+        heads[oldest] = entry->type_next;
+        SDL_copyp(&events[used], &entry->event);
+        if (action == SDL_GETEVENT) {
+            SDL_RecordEventLatency(entry);
+            SDL_CutEvent(entry);
+        }
+        ++used;
+    }
+    return used;
+}
+
 // Lock the event queue, take a peep at it, and unlock it
 static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAction action,
                                   Uint32 minType, Uint32 maxType, bool include_sentinel)
 {
     int i, used, sentinels_expected = 0;
 
-    // Lock the event queue
     used = 0;
 
+    if (action == SDL_ADDEVENT) {
+        CHECK_PARAM(!events) {
+            return SDL_InvalidParamError("events");
+        }
+        for (i = 0; i < numevents; ++i) {
+            const int added = SDL_PushEventInternal(&events[i]);
+            if (added < 0) {
+                // The event loop isn't running
+                if (used == 0) {
+                    return -1;
+                }
+                break;
+            }
+            used += added;
+        }
+
+        if (used > 0) {
+            SDL_SendWakeupEvent();
+        }
+        return used;
+    }
+
+    // Lock the event queue
     SDL_LockMutex(SDL_EventQ.lock);
     {
         // Don't look after we've quit
@@ -1130,18 +1791,44 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
-        if (action == SDL_ADDEVENT) {
-            CHECK_PARAM(!events) {
-                SDL_UnlockMutex(SDL_EventQ.lock);
-                return SDL_InvalidParamError("events");
-            }
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
+        if (action == SDL_GETEVENT && events && !SDL_EventQ.head &&
+            minType == SDL_EVENT_FIRST && maxType == SDL_EVENT_LAST) {
+            // Nothing older in the list, take any events straight from the ring
+            SDL_EventEntry entry;
+
+            while (used < numevents && SDL_DequeueEventRing(&entry)) {
+                SDL_RecordEventLatency(&entry);
+                SDL_TransferTemporaryMemoryFromEvent(&entry);
+                SDL_assert(SDL_GetAtomicInt(&SDL_EventQ.count) > 0);
+                SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+
+                if (entry.event.type == SDL_EVENT_POLL_SENTINEL) {
+                    // Special handling for the sentinel event, see below
+                    SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
+                    if (!include_sentinel || SDL_GetAtomicInt(&SDL_sentinel_pending) > 0) {
+                        continue;
+                    }
+                }
+                SDL_copyp(&events[used], &entry.event);
+                ++used;
             }
         } else {
             SDL_EventEntry *entry, *next;
             Uint32 type;
 
+            SDL_DrainEventRing(false);
+
+            // The sentinel needs special handling below, otherwise use the type index when possible
+            if ((SDL_EVENT_POLL_SENTINEL < minType || SDL_EVENT_POLL_SENTINEL > maxType) &&
+                SDL_IsEventQueueIndexed()) {
+                used = SDL_PeepIndexedEvents(events, numevents, action, minType, maxType);
+                if (used >= 0) {
+                    SDL_UnlockMutex(SDL_EventQ.lock);
+                    return used;
+                }
+                used = 0;
+            }
+
             for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
                 next = entry->next;
                 type = entry->event.type;
@@ -1150,6 +1837,7 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
                         SDL_copyp(&events[used], &entry->event);
 
                         if (action == SDL_GETEVENT) {
+                            SDL_RecordEventLatency(entry);
                             SDL_CutEvent(entry);
                         }
                     }
@@ -1174,10 +1862,6 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
     }
     SDL_UnlockMutex(SDL_EventQ.lock);
 
-    if (used > 0 && action == SDL_ADDEVENT) {
-        SDL_SendWakeupEvent();
-    }
-
     return used;
 }
 int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_EventAction action,
@@ -1198,11 +1882,17 @@ bool SDL_HasEvents(Uint32 minType, Uint32 maxType)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         if (SDL_EventQ.active) {
-            for (SDL_EventEntry *entry = SDL_EventQ.head; entry; entry = entry->next) {
-                const Uint32 type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    found = true;
-                    break;
+            SDL_DrainEventRing(false);
+            if (SDL_IsEventQueueIndexed()) {
+                Uint32 type = minType;
+                found = (SDL_FindEventTypeList(&type, maxType) != NULL);
+            } else {
+                for (SDL_EventEntry *entry = SDL_EventQ.head; entry; entry = entry->next) {
+                    const Uint32 type = entry->event.type;
+                    if (minType <= type && type <= maxType) {
+                        found = true;
+                        break;
+                    }
                 }
             }
         }
@@ -1212,6 +1902,57 @@ bool SDL_HasEvents(Uint32 minType, Uint32 maxType)
     return found;
 }
 
+int SDL_GetCoalescedEventCount(const SDL_Event *event)
+{
+    CHECK_PARAM(!event) {
+        SDL_InvalidParamError("event");
+        return 0;
+    }
+
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        return (int)SDL_max(event->motion.samples, 1);
+    case SDL_EVENT_PEN_MOTION:
+        return (int)SDL_max(event->pmotion.samples, 1);
+    case SDL_EVENT_FINGER_MOTION:
+        return (int)SDL_max(event->tfinger.samples, 1);
+    default:
+        return 1;
+    }
+}
+
+bool SDL_GetEventLatencyHistogram(Uint32 type, SDL_EventLatencyStage stage, SDL_EventLatencyHistogram *histogram)
+{
+    const SDL_EventLatencyBlock *block;
+
+    if (histogram) {
+        SDL_zerop(histogram);
+    }
+
+    CHECK_PARAM(stage != SDL_LATENCY_SOURCE_TO_QUEUE && stage != SDL_LATENCY_QUEUE_TO_POLL) {
+        return SDL_InvalidParamError("stage");
+    }
+    CHECK_PARAM(!histogram) {
+        return SDL_InvalidParamError("histogram");
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    block = SDL_event_latency[(type >> 8) & 0xFF];
+    if (type <= 0xFFFF && block && block->types[type & 0xFF]) {
+        SDL_copyp(histogram, &block->types[type & 0xFF]->stages[stage]);
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return true;
+}
+
+void SDL_ResetEventLatencyHistograms(void)
+{
+    SDL_LockMutex(SDL_EventQ.lock);
+    SDL_ResetEventLatency();
+    SDL_UnlockMutex(SDL_EventQ.lock);
+}
+
 void SDL_FlushEvent(Uint32 type)
 {
     SDL_FlushEvents(type, type);
@@ -1238,11 +1979,21 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            type = entry->event.type;
-            if (minType <= type && type <= maxType) {
-                SDL_CutEvent(entry);
+        SDL_DrainEventRing(false);
+        if (SDL_IsEventQueueIndexed()) {
+            SDL_EventTypeList *list;
+            for (type = minType; (list = SDL_FindEventTypeList(&type, maxType)) != NULL; ++type) {
+                while (list->head) {
+                    SDL_CutEvent(list->head);
+                }
+            }
+        } else {
+            for (entry = SDL_EventQ.head; entry; entry = next) {
+                next = entry->next;
+                type = entry->event.type;
+                if (minType <= type && type <= maxType) {
+                    SDL_CutEvent(entry);
+                }
             }
         }
     }
@@ -1510,8 +2261,11 @@ static Sint64 SDL_events_get_polling_interval(void)
 #ifndef SDL_JOYSTICK_DISABLED
     if (SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks) {
         if (SDL_JoysticksOpened()) {
-            // If we have joysticks open, we need to poll rapidly for events
-            poll_intervalNS = SDL_min(poll_intervalNS, EVENT_POLL_INTERVAL_NS);
+            // If we have joysticks open, we need to poll rapidly for events,
+            // unless they all wake us up when they have new input.
+            if (SDL_JoysticksNeedPolling()) {
+                poll_intervalNS = SDL_min(poll_intervalNS, EVENT_POLL_INTERVAL_NS);
+            }
         } else {
             // If not, just poll every few seconds to enumerate new joysticks
             poll_intervalNS = SDL_min(poll_intervalNS, ENUMERATION_POLL_INTERVAL_NS);
@@ -1534,6 +2288,17 @@ static int SDL_WaitEventTimeout_Device(SDL_VideoDevice *_this, SDL_Window *wakeu
     Sint64 loop_timeoutNS = timeoutNS;
     Sint64 poll_intervalNS = SDL_events_get_polling_interval();
 
+#ifdef SDL_PLATFORM_LINUX
+    /* Input devices that are read while pumping events can wake up the wait,
+       as long as joysticks are being updated here, otherwise nothing would
+       read their input and the wait would keep waking up. */
+#ifndef SDL_JOYSTICK_DISABLED
+    SDL_EventWait_SetEnabled(SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks);
+#else
+    SDL_EventWait_SetEnabled(false);
+#endif
+#endif
+
     for (;;) {
         int status;
         /* Pump events on entry and each time we wake to ensure:
@@ -1735,6 +2500,68 @@ static bool SDL_CallEventWatchers(SDL_Event *event)
     return SDL_DispatchEventWatchList(&SDL_event_watchers, event);
 }
 
+int SDL_PushEvents(SDL_Event *events, int numevents)
+{
+    bool *passed;
+    bool isstack;
+    Uint64 now = 0;
+    int i, used = 0;
+
+    CHECK_PARAM(!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    }
+    CHECK_PARAM(numevents < 0) {
+        SDL_InvalidParamError("numevents");
+        return -1;
+    }
+    if (numevents == 0) {
+        return 0;
+    }
+
+    passed = SDL_small_alloc(bool, numevents, &isstack);
+    if (!passed) {
+        return -1;
+    }
+
+    for (i = 0; i < numevents; ++i) {
+        if (!events[i].common.timestamp) {
+            if (!now) {
+                now = SDL_GetTicksNS();
+            }
+            events[i].common.timestamp = now;
+        }
+    }
+
+    // Run the filter and watchers over all the events in one pass
+    SDL_DispatchEventWatchListEvents(&SDL_event_watchers, events, numevents, passed);
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    if (SDL_EventQ.active) {
+        for (i = 0; i < numevents; ++i) {
+            if (passed[i]) {
+                if (!SDL_AddEvent(&events[i])) {
+                    if (used == 0) {
+                        used = -1; // Nothing could be added, the error has been set
+                    }
+                    break;
+                }
+                ++used;
+            }
+        }
+    } else {
+        used = -1;
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    SDL_small_free(passed, isstack);
+
+    if (used > 0) {
+        SDL_SendWakeupEvent();
+    }
+    return used;
+}
+
 bool SDL_PushEvent(SDL_Event *event)
 {
     if (!event->common.timestamp) {
@@ -1759,12 +2586,12 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_event_watchers.lock);
     {
         // Set filter and discard pending events
-        SDL_event_watchers.filter.callback = filter;
-        SDL_event_watchers.filter.userdata = userdata;
+        SDL_SetEventWatchListFilter(&SDL_event_watchers, filter, userdata);
         if (filter) {
             // Cut all events not accepted by the filter
             SDL_LockMutex(SDL_EventQ.lock);
             {
+                SDL_DrainEventRing(false);
                 for (event = SDL_EventQ.head; event; event = next) {
                     next = event->next;
                     if (!filter(userdata, &event->event)) {
@@ -1780,21 +2607,7 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 
 bool SDL_GetEventFilter(SDL_EventFilter *filter, void **userdata)
 {
-    SDL_EventWatcher event_ok;
-
-    SDL_LockMutex(SDL_event_watchers.lock);
-    {
-        event_ok = SDL_event_watchers.filter;
-    }
-    SDL_UnlockMutex(SDL_event_watchers.lock);
-
-    if (filter) {
-        *filter = event_ok.callback;
-    }
-    if (userdata) {
-        *userdata = event_ok.userdata;
-    }
-    return event_ok.callback ? true : false;
+    return SDL_GetEventWatchListFilter(&SDL_event_watchers, filter, userdata);
 }
 
 bool SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
@@ -1812,6 +2625,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing(false);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1962,6 +2776,8 @@ bool SDL_InitEvents(void)
     SDL_AddHintCallback(SDL_HINT_AUTO_UPDATE_SENSORS, SDL_AutoUpdateSensorsChanged, NULL);
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_LATENCY_TRACING, SDL_LatencyTracingChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_InitMainThreadCallbacks();
     if (!SDL_StartEventLoop()) {
@@ -1980,6 +2796,8 @@ void SDL_QuitEvents(void)
     SDL_StopEventLoop();
     SDL_QuitMainThreadCallbacks();
     SDL_RemoveHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_LATENCY_TRACING, SDL_LatencyTracingChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
     SDL_RemoveHintCallback(SDL_HINT_AUTO_UPDATE_JOYSTICKS, SDL_AutoUpdateJoysticksChanged, NULL);
@@ -22,6 +22,146 @@
 
 #include "SDL_eventwatch_c.h"
 
+/* Event watchers are dispatched without locking, from an immutable snapshot
+   of the watcher list. Changes to the list are made under list->lock by
+   publishing a new snapshot, and the old one is retired until no dispatch
+   can still be using it.
+
+   Each snapshot counts its own users, and a retired snapshot is freed as
+   soon as it has none, so removing a watcher only has to wait for the
+   dispatches that might still call it. list->readers only covers the
+   moment between loading the current snapshot and counting a use of it,
+   and removals waiting on retired snapshots; nothing is freed while it is
+   non-zero. */
+
+// How many event watcher dispatches the current thread is in the middle of
+static SDL_TLSID SDL_event_watch_depth;
+
+/* Free retired snapshots that nothing is using any more -- called with the list locked
+   A snapshot without users might still be about to gain one while readers is non-zero,
+   so that is checked first. */
+static void SDL_ReclaimEventWatchSnapshots(SDL_EventWatchList *list)
+{
+    SDL_EventWatchSnapshot **prev;
+    SDL_EventWatchSnapshot *snapshot;
+
+    if (!list->retired || SDL_GetAtomicInt(&list->readers) > 0) {
+        return;
+    }
+
+    prev = &list->retired;
+    while ((snapshot = *prev) != NULL) {
+        if (SDL_GetAtomicInt(&snapshot->users) == 0) {
+            *prev = snapshot->next_retired;
+            SDL_free(snapshot);
+            SDL_AddAtomicInt(&list->num_retired, -1);
+        } else {
+            prev = &snapshot->next_retired;
+        }
+    }
+}
+
+// Clean up retired snapshots if nobody is changing the list right now
+static void SDL_TryReclaimEventWatchSnapshots(SDL_EventWatchList *list)
+{
+    if (SDL_GetAtomicInt(&list->num_retired) > 0 && SDL_TryLockMutex(list->lock)) {
+        SDL_ReclaimEventWatchSnapshots(list);
+        SDL_UnlockMutex(list->lock);
+    }
+}
+
+static void SDL_LeaveEventWatchReaders(SDL_EventWatchList *list)
+{
+    if (SDL_AddAtomicInt(&list->readers, -1) == 1) {
+        SDL_TryReclaimEventWatchSnapshots(list);
+    }
+}
+
+static SDL_EventWatchSnapshot *SDL_AcquireEventWatchSnapshot(SDL_EventWatchList *list)
+{
+    SDL_EventWatchSnapshot *snapshot;
+
+    SDL_AddAtomicInt(&list->readers, 1);
+    snapshot = (SDL_EventWatchSnapshot *)SDL_GetAtomicPointer(&list->snapshot);
+    if (snapshot) {
+        SDL_AddAtomicInt(&snapshot->users, 1);
+    }
+    SDL_LeaveEventWatchReaders(list);
+    return snapshot;
+}
+
+static void SDL_ReleaseEventWatchSnapshot(SDL_EventWatchList *list, SDL_EventWatchSnapshot *snapshot)
+{
+    if (snapshot && SDL_AddAtomicInt(&snapshot->users, -1) == 1) {
+        // This might have been the last use of a retired snapshot
+        SDL_TryReclaimEventWatchSnapshots(list);
+    }
+}
+
+static void SDL_EnterEventWatchDispatch(void)
+{
+    const intptr_t depth = (intptr_t)SDL_GetTLS(&SDL_event_watch_depth);
+    SDL_SetTLS(&SDL_event_watch_depth, (void *)(depth + 1), NULL);
+}
+
+static void SDL_LeaveEventWatchDispatch(void)
+{
+    const intptr_t depth = (intptr_t)SDL_GetTLS(&SDL_event_watch_depth);
+    SDL_SetTLS(&SDL_event_watch_depth, (void *)(depth - 1), NULL);
+}
+
+/* Make a copy of the current snapshot with room for extra watchers, leaving
+   out the watcher at index skip -- called with the list locked */
+static SDL_EventWatchSnapshot *SDL_CopyEventWatchSnapshot(SDL_EventWatchList *list, int extra, int skip)
+{
+    SDL_EventWatchSnapshot *current = (SDL_EventWatchSnapshot *)SDL_GetAtomicPointer(&list->snapshot);
+    SDL_EventWatchSnapshot *snapshot;
+    const int count = current ? current->count : 0;
+    int i;
+
+    snapshot = (SDL_EventWatchSnapshot *)SDL_malloc(sizeof(*snapshot) + (count + extra) * sizeof(snapshot->watchers[0]));
+    if (!snapshot) {
+        return NULL;
+    }
+
+    SDL_SetAtomicInt(&snapshot->users, 0);
+    snapshot->next_retired = NULL;
+    snapshot->count = 0;
+    if (current) {
+        snapshot->filter = current->filter;
+        for (i = 0; i < count; ++i) {
+            if (i != skip) {
+                SDL_EventWatcher *watcher = &snapshot->watchers[snapshot->count++];
+                watcher->callback = current->watchers[i].callback;
+                watcher->userdata = current->watchers[i].userdata;
+                SDL_SetAtomicInt(&watcher->removed, 0);
+            }
+        }
+    } else {
+        SDL_zero(snapshot->filter);
+    }
+    return snapshot;
+}
+
+// Make a snapshot the current one and retire the old one -- called with the list locked
+static void SDL_PublishEventWatchSnapshot(SDL_EventWatchList *list, SDL_EventWatchSnapshot *snapshot)
+{
+    SDL_EventWatchSnapshot *old = (SDL_EventWatchSnapshot *)SDL_GetAtomicPointer(&list->snapshot);
+
+    if (snapshot && !snapshot->filter.callback && snapshot->count == 0) {
+        // Dispatching can skip everything when there's nothing to call
+        SDL_free(snapshot);
+        snapshot = NULL;
+    }
+    SDL_SetAtomicPointer(&list->snapshot, snapshot);
+
+    if (old) {
+        old->next_retired = list->retired;
+        list->retired = old;
+        SDL_AddAtomicInt(&list->num_retired, 1);
+    }
+    SDL_ReclaimEventWatchSnapshots(list);
+}
 
 bool SDL_InitEventWatchList(SDL_EventWatchList *list)
 {
@@ -36,59 +176,122 @@ bool SDL_InitEventWatchList(SDL_EventWatchList *list)
 
 void SDL_QuitEventWatchList(SDL_EventWatchList *list)
 {
+    SDL_free(SDL_GetAtomicPointer(&list->snapshot));
+    SDL_SetAtomicPointer(&list->snapshot, NULL);
+    while (list->retired) {
+        SDL_EventWatchSnapshot *snapshot = list->retired;
+        list->retired = snapshot->next_retired;
+        SDL_free(snapshot);
+    }
+    SDL_SetAtomicInt(&list->num_retired, 0);
+    SDL_SetAtomicInt(&list->readers, 0);
+
     if (list->lock) {
         SDL_DestroyMutex(list->lock);
         list->lock = NULL;
     }
-    if (list->watchers) {
-        SDL_free(list->watchers);
-        list->watchers = NULL;
-        list->count = 0;
-    }
-    SDL_zero(list->filter);
 }
 
 bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event)
 {
-    SDL_EventWatcher *filter = &list->filter;
+    SDL_EventWatchSnapshot *snapshot;
+    bool result = true;
+    int i;
 
-    if (!filter->callback && list->count == 0) {
+    if (!SDL_GetAtomicPointer(&list->snapshot)) {
         return true;
     }
 
-    SDL_LockMutex(list->lock);
-    {
-        // Make sure we only dispatch the current watcher list
-        int i, count = list->count;
+    snapshot = SDL_AcquireEventWatchSnapshot(list);
+    if (snapshot) {
+        SDL_EnterEventWatchDispatch();
+        if (snapshot->filter.callback && !snapshot->filter.callback(snapshot->filter.userdata, event)) {
+            result = false;
+        } else {
+            for (i = 0; i < snapshot->count; ++i) {
+                SDL_EventWatcher *watcher = &snapshot->watchers[i];
+                if (!SDL_GetAtomicInt(&watcher->removed)) {
+                    watcher->callback(watcher->userdata, event);
+                }
+            }
+        }
+        SDL_LeaveEventWatchDispatch();
+    }
+    SDL_ReleaseEventWatchSnapshot(list, snapshot);
 
-        if (filter->callback && !filter->callback(filter->userdata, event)) {
-            SDL_UnlockMutex(list->lock);
-            return false;
+    return result;
+}
+
+void SDL_DispatchEventWatchListEvents(SDL_EventWatchList *list, SDL_Event *events, int numevents, bool *passed)
+{
+    SDL_EventWatchSnapshot *snapshot;
+    int i, j;
+
+    for (i = 0; i < numevents; ++i) {
+        passed[i] = true;
+    }
+    if (!SDL_GetAtomicPointer(&list->snapshot)) {
+        return;
+    }
+
+    snapshot = SDL_AcquireEventWatchSnapshot(list);
+    if (!snapshot) {
+        return;
+    }
+
+    SDL_EnterEventWatchDispatch();
+    for (i = 0; i < numevents; ++i) {
+        SDL_Event *event = &events[i];
+
+        if (snapshot->filter.callback && !snapshot->filter.callback(snapshot->filter.userdata, event)) {
+            passed[i] = false;
+            continue;
         }
 
-        list->dispatching = true;
-        for (i = 0; i < count; ++i) {
-            if (!list->watchers[i].removed) {
-                list->watchers[i].callback(list->watchers[i].userdata, event);
+        for (j = 0; j < snapshot->count; ++j) {
+            SDL_EventWatcher *watcher = &snapshot->watchers[j];
+            if (!SDL_GetAtomicInt(&watcher->removed)) {
+                watcher->callback(watcher->userdata, event);
             }
         }
-        list->dispatching = false;
-
-        if (list->removed) {
-            for (i = list->count; i--;) {
-                if (list->watchers[i].removed) {
-                    --list->count;
-                    if (i < list->count) {
-                        SDL_memmove(&list->watchers[i], &list->watchers[i + 1], (list->count - i) * sizeof(list->watchers[i]));
-                    }
-                }
-            }
-            list->removed = false;
+    }
+    SDL_LeaveEventWatchDispatch();
+    SDL_ReleaseEventWatchSnapshot(list, snapshot);
+}
+
+void SDL_SetEventWatchListFilter(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
+{
+    SDL_LockMutex(list->lock);
+    {
+        SDL_EventWatchSnapshot *snapshot = SDL_CopyEventWatchSnapshot(list, 0, -1);
+        if (snapshot) {
+            snapshot->filter.callback = filter;
+            snapshot->filter.userdata = userdata;
+            SDL_PublishEventWatchSnapshot(list, snapshot);
         }
     }
     SDL_UnlockMutex(list->lock);
+}
 
-    return true;
+bool SDL_GetEventWatchListFilter(SDL_EventWatchList *list, SDL_EventFilter *filter, void **userdata)
+{
+    SDL_EventWatchSnapshot *snapshot = SDL_AcquireEventWatchSnapshot(list);
+    SDL_EventFilter callback = NULL;
+    void *data = NULL;
+
+    if (snapshot) {
+        callback = snapshot->filter.callback;
+        data = snapshot->filter.userdata;
+    }
+    SDL_ReleaseEventWatchSnapshot(list, snapshot);
+
+    if (filter) {
+        *filter = callback;
+    }
+    if (userdata) {
+        *userdata = data;
+    }
+    return callback ? true : false;
 }
 
 bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
@@ -97,18 +300,13 @@ bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, voi
 
     SDL_LockMutex(list->lock);
     {
-        SDL_EventWatcher *watchers;
-
-        watchers = (SDL_EventWatcher *)SDL_realloc(list->watchers, (list->count + 1) * sizeof(*watchers));
-        if (watchers) {
-            SDL_EventWatcher *watcher;
-
-            list->watchers = watchers;
-            watcher = &list->watchers[list->count];
+        SDL_EventWatchSnapshot *snapshot = SDL_CopyEventWatchSnapshot(list, 1, -1);
+        if (snapshot) {
+            SDL_EventWatcher *watcher = &snapshot->watchers[snapshot->count++];
             watcher->callback = filter;
             watcher->userdata = userdata;
-            watcher->removed = false;
-            ++list->count;
+            SDL_SetAtomicInt(&watcher->removed, 0);
+            SDL_PublishEventWatchSnapshot(list, snapshot);
         } else {
             result = false;
         }
@@ -120,24 +318,57 @@ bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, voi
 
 void SDL_RemoveEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
 {
+    SDL_EventWatchSnapshot *retired = NULL;
+
     SDL_LockMutex(list->lock);
     {
-        int i;
-
-        for (i = 0; i < list->count; ++i) {
-            if (list->watchers[i].callback == filter && list->watchers[i].userdata == userdata) {
-                if (list->dispatching) {
-                    list->watchers[i].removed = true;
-                    list->removed = true;
-                } else {
-                    --list->count;
-                    if (i < list->count) {
-                        SDL_memmove(&list->watchers[i], &list->watchers[i + 1], (list->count - i) * sizeof(list->watchers[i]));
+        SDL_EventWatchSnapshot *current = (SDL_EventWatchSnapshot *)SDL_GetAtomicPointer(&list->snapshot);
+        SDL_EventWatchSnapshot *snapshot;
+        int i, j;
+
+        for (i = 0; current && i < current->count; ++i) {
+            if (current->watchers[i].callback == filter && current->watchers[i].userdata == userdata) {
+                break;
+            }
+        }
+
+        if (current && i < current->count) {
+            /* Dispatches already in progress might be using this or an older
+               snapshot, make sure they don't call the watcher any more. */
+            SDL_SetAtomicInt(&current->watchers[i].removed, 1);
+            for (snapshot = list->retired; snapshot; snapshot = snapshot->next_retired) {
+                for (j = 0; j < snapshot->count; ++j) {
+                    if (snapshot->watchers[j].callback == filter && snapshot->watchers[j].userdata == userdata) {
+                        SDL_SetAtomicInt(&snapshot->watchers[j].removed, 1);
                     }
                 }
-                break;
+            }
+
+            snapshot = SDL_CopyEventWatchSnapshot(list, 0, i);
+            if (snapshot) {
+                SDL_PublishEventWatchSnapshot(list, snapshot);
+            }
+
+            retired = list->retired;
+            if (retired) {
+                // Keep the retired snapshots alive while we wait for them below
+                SDL_AddAtomicInt(&list->readers, 1);
             }
         }
     }
     SDL_UnlockMutex(list->lock);
+
+    if (retired) {
+        /* A dispatch on another thread may be in the middle of calling the watcher,
+           wait for it to finish so the caller can safely free the userdata. This
+           isn't possible if the watcher is being removed from inside a dispatch. */
+        if ((intptr_t)SDL_GetTLS(&SDL_event_watch_depth) == 0) {
+            for (; retired; retired = retired->next_retired) {
+                while (SDL_GetAtomicInt(&retired->users) > 0) {
+                    SDL_Delay(0);
+                }
+            }
+        }
+        SDL_LeaveEventWatchReaders(list);
+    }
 }
@@ -24,22 +24,33 @@ typedef struct SDL_EventWatcher
 {
     SDL_EventFilter callback;
     void *userdata;
-    bool removed;
+    SDL_AtomicInt removed;
 } SDL_EventWatcher;
 
-typedef struct SDL_EventWatchList
+typedef struct SDL_EventWatchSnapshot
 {
-    SDL_Mutex *lock;
+    SDL_AtomicInt users;
+    struct SDL_EventWatchSnapshot *next_retired;
     SDL_EventWatcher filter;
-    SDL_EventWatcher *watchers;
     int count;
-    bool dispatching;
-    bool removed;
+    SDL_EventWatcher watchers[1];
+} SDL_EventWatchSnapshot;
+
+typedef struct SDL_EventWatchList
+{
+    SDL_Mutex *lock;
+    void *snapshot; // The current SDL_EventWatchSnapshot, accessed atomically
+    SDL_AtomicInt readers;
+    SDL_EventWatchSnapshot *retired;
+    SDL_AtomicInt num_retired;
 } SDL_EventWatchList;
 
 
 extern bool SDL_InitEventWatchList(SDL_EventWatchList *list);
 extern void SDL_QuitEventWatchList(SDL_EventWatchList *list);
 extern bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event);
+extern void SDL_DispatchEventWatchListEvents(SDL_EventWatchList *list, SDL_Event *events, int numevents, bool *passed);
+extern void SDL_SetEventWatchListFilter(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
+extern bool SDL_GetEventWatchListFilter(SDL_EventWatchList *list, SDL_EventFilter *filter, void **userdata);
 extern bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
 extern void SDL_RemoveEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
@@ -25,6 +25,7 @@
 #include "SDL_events_c.h"
 #include "SDL_keymap_c.h"
 #include "../video/SDL_sysvideo.h"
+#include "../SDL_hints_c.h"
 
 #if 0
 #define DEBUG_KEYBOARD
@@ -62,6 +63,7 @@ static int SDL_keyboard_count;
 static SDL_KeyboardID *SDL_keyboards;
 static SDL_HashTable *SDL_keyboard_names;
 static bool SDL_keyboard_quitting;
+static SDL_CachedHint SDL_keyboard_allow_alt_tab = SDL_CACHED_HINT_INIT(SDL_HINT_ALLOW_ALT_TAB_WHILE_GRABBED);
 
 static void SDLCALL SDL_KeycodeOptionsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
@@ -643,7 +645,7 @@ static bool SDL_SendKeyboardKeyInternal(Uint64 timestamp, Uint32 flags, SDL_Keyb
         keyboard->focus &&
         (keyboard->focus->flags & SDL_WINDOW_KEYBOARD_GRABBED) &&
         (keyboard->focus->flags & SDL_WINDOW_FULLSCREEN) &&
-        SDL_GetHintBoolean(SDL_HINT_ALLOW_ALT_TAB_WHILE_GRABBED, true)) {
+        SDL_GetCachedHintBoolean(&SDL_keyboard_allow_alt_tab, true)) {
         /* We will temporarily forfeit our grab by minimizing our window,
            allowing the user to escape the application */
         SDL_MinimizeWindow(keyboard->focus);
@@ -22,6 +22,24 @@
 #include "SDL_internal.h"
 #include "SDL_sysasyncio.h"
 #include "SDL_asyncio_c.h"
+#include "../SDL_mempool.h"
+
+// Tasks are created by the app and released from whichever thread collects their results
+static SDL_MemoryPool SDL_asyncio_task_pool = SDL_MEMORY_POOL_INITIALIZER(sizeof(SDL_AsyncIOTask), 64, true);
+
+static SDL_AsyncIOTask *AllocAsyncIOTask(void)
+{
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *)SDL_AllocMemoryPoolBlock(&SDL_asyncio_task_pool);
+    if (task) {
+        SDL_zerop(task);
+    }
+    return task;
+}
+
+static void FreeAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_FreeMemoryPoolBlock(&SDL_asyncio_task_pool, task);
+}
 
 static const char *AsyncFileModeValid(const char *mode)
 {
@@ -98,7 +116,7 @@ static bool RequestAsyncIO(bool reading, SDL_AsyncIO *asyncio, void *ptr, Uint64
         return SDL_InvalidParamError("queue");
     }
 
-    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*task));
+    SDL_AsyncIOTask *task = AllocAsyncIOTask();
     if (!task) {
         return false;
     }
@@ -113,7 +131,7 @@ static bool RequestAsyncIO(bool reading, SDL_AsyncIO *asyncio, void *ptr, Uint64
 
     SDL_LockMutex(asyncio->lock);
     if (asyncio->closing) {
-        SDL_free(task);
+        FreeAsyncIOTask(task);
         SDL_UnlockMutex(asyncio->lock);
         return SDL_SetError("SDL_AsyncIO is closing, can't start new tasks");
     }
@@ -127,7 +145,7 @@ static bool RequestAsyncIO(bool reading, SDL_AsyncIO *asyncio, void *ptr, Uint64
         SDL_LockMutex(asyncio->lock);
         LINKED_LIST_UNLINK(task, asyncio);
         SDL_UnlockMutex(asyncio->lock);
-        SDL_free(task);
+        FreeAsyncIOTask(task);
         task = NULL;
     }
 
@@ -159,7 +177,7 @@ bool SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, bool flush, SDL_AsyncIOQueue *queue,
         return SDL_SetError("Already closing");
     }
 
-    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*task));
+    SDL_AsyncIOTask *task = AllocAsyncIOTask();
     if (task) {
         task->asyncio = asyncio;
         task->type = SDL_ASYNCIO_TASK_CLOSE;
@@ -176,7 +194,7 @@ bool SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, bool flush, SDL_AsyncIOQueue *queue,
                 // uhoh, maybe they can try again later...?
                 SDL_AddAtomicInt(&queue->tasks_inflight, -1);
                 LINKED_LIST_UNLINK(task, asyncio);
-                SDL_free(task);
+                FreeAsyncIOTask(task);
                 task = asyncio->closing = NULL;
             }
         }
@@ -246,7 +264,7 @@ static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *out
     }
 
     SDL_AddAtomicInt(&task->queue->tasks_inflight, -1);
-    SDL_free(task);
+    FreeAsyncIOTask(task);
 
     return retval;
 }
@@ -298,6 +316,7 @@ void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
 void SDL_QuitAsyncIO(void)
 {
     SDL_SYS_QuitAsyncIO();
+    SDL_DestroyMemoryPool(&SDL_asyncio_task_pool);
 }
 
 bool SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata)
@@ -880,6 +880,28 @@ bool SDL_JoysticksOpened(void)
     return opened;
 }
 
+bool SDL_JoysticksNeedPolling(void)
+{
+    bool result = false;
+
+    SDL_LockJoysticks();
+    {
+        for (SDL_Joystick *joystick = SDL_joysticks; joystick; joystick = joystick->next) {
+            // Timed rumble and LED changes are handled while updating, so those need polling too
+            if (!joystick->can_wakeup || joystick->delayed_guide_button ||
+                joystick->rumble_expiration || joystick->rumble_resend ||
+                joystick->trigger_rumble_expiration || joystick->trigger_rumble_resend ||
+                joystick->led_expiration) {
+                result = true;
+                break;
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return result;
+}
+
 bool SDL_JoystickHandledByAnotherDriver(struct SDL_JoystickDriver *driver, Uint16 vendor_id, Uint16 product_id, Uint16 version, const char *name)
 {
     int i;
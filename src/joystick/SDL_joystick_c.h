@@ -53,6 +53,9 @@ extern void SDL_AssertJoysticksLocked(void) SDL_ASSERT_CAPABILITY(SDL_joystick_l
 // Function to return whether there are any joysticks opened by the application
 extern bool SDL_JoysticksOpened(void);
 
+// Function to return whether any opened joysticks need to be polled for new input
+extern bool SDL_JoysticksNeedPolling(void);
+
 // Function to determine whether a device is currently detected by this driver
 extern bool SDL_JoystickHandledByAnotherDriver(struct SDL_JoystickDriver *driver, Uint16 vendor_id, Uint16 product_id, Uint16 version, const char *name);
 
@@ -126,6 +126,7 @@ struct SDL_Joystick
     int battery_percent _guarded;
 
     bool delayed_guide_button _guarded;      // true if this device has the guide button event delayed
+    bool can_wakeup _guarded;                // true if new input wakes up SDL_WaitEvent(), so it doesn't need polling
 
     SDL_SensorID accel_sensor _guarded;
     SDL_Sensor *accel _guarded;
@@ -43,6 +43,7 @@
 
 #include "../../events/SDL_events_c.h"
 #include "../../core/linux/SDL_evdev.h"
+#include "../../core/linux/SDL_eventwait.h"
 #include "../SDL_sysjoystick.h"
 #include "../SDL_joystick_c.h"
 #include "../usb_ids.h"
@@ -1056,6 +1057,11 @@ static bool LINUX_JoystickInit(void)
 
             // Force a scan to build the initial device list
             SDL_UDEV_Scan();
+
+            // Wake up SDL_WaitEvent() when devices are added or removed
+            if (SDL_UDEV_GetMonitorFD() >= 0) {
+                SDL_EventWait_AddFD(SDL_UDEV_GetMonitorFD());
+            }
         } else {
             SDL_LogDebug(SDL_LOG_CATEGORY_INPUT,
                          "udev init failed, disabling udev integration");
@@ -1089,6 +1095,8 @@ static bool LINUX_JoystickInit(void)
                 SDL_LogWarn(SDL_LOG_CATEGORY_INPUT,
                             "Unable to add inotify watch, falling back to polling: %s",
                             strerror(errno));
+            } else {
+                SDL_EventWait_AddFD(inotify_fd);
             }
         }
 #endif // HAVE_INOTIFY
@@ -1498,9 +1506,13 @@ static bool PrepareJoystickHwdata(SDL_Joystick *joystick, SDL_joylist_item *item
     if (fd < 0) {
         return SDL_SetError("Unable to open %s", item->path);
     }
+    joystick->hwdata->monotonic_clock = SDL_EVDEV_SetEventClock(fd);
     // If opening sensor fail, continue with buttons and axes only
     if (item_sensor) {
         fd_sensor = open(item_sensor->path, O_RDONLY | O_CLOEXEC, 0);
+        if (fd_sensor >= 0) {
+            joystick->hwdata->sensor_monotonic_clock = SDL_EVDEV_SetEventClock(fd_sensor);
+        }
     }
 
     joystick->hwdata->fd = fd;
@@ -1615,6 +1627,9 @@ static bool LINUX_JoystickOpen(SDL_Joystick *joystick, int device_index)
     // mark joystick as fresh and ready
     joystick->hwdata->fresh = true;
 
+    // New input is read while pumping events, so let it wake up SDL_WaitEvent()
+    joystick->can_wakeup = SDL_EventWait_AddFD(joystick->hwdata->fd);
+
     if (joystick->hwdata->has_gyro) {
         SDL_PrivateJoystickAddSensor(joystick, SDL_SENSOR_GYRO, 0.0f);
     }
@@ -1711,8 +1726,13 @@ static bool LINUX_JoystickSetSensorsEnabled(SDL_Joystick *joystick, bool enabled
             return SDL_SetError("Couldn't open sensor file %s.", joystick->hwdata->item_sensor->path);
         }
         fcntl(joystick->hwdata->fd_sensor, F_SETFL, O_NONBLOCK);
+        joystick->hwdata->sensor_monotonic_clock = SDL_EVDEV_SetEventClock(joystick->hwdata->fd_sensor);
+        if (joystick->can_wakeup) {
+            joystick->can_wakeup = SDL_EventWait_AddFD(joystick->hwdata->fd_sensor);
+        }
     } else {
         SDL_assert(joystick->hwdata->fd_sensor >= 0);
+        SDL_EventWait_RemoveFD(joystick->hwdata->fd_sensor);
         close(joystick->hwdata->fd_sensor);
         joystick->hwdata->fd_sensor = -1;
     }
@@ -1941,7 +1961,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
 #ifdef DEBUG_INPUT_EVENTS
                 SDL_Log("Key 0x%.2x %s", code, event->value ? "PRESSED" : "RELEASED");
 #endif
-                SDL_SendJoystickButton(SDL_EVDEV_GetEventTimestamp(event), joystick,
+                SDL_SendJoystickButton(SDL_EVDEV_GetEventTimestamp(event, joystick->hwdata->monotonic_clock), joystick,
                                           joystick->hwdata->key_map[code],
                                           (event->value != 0));
                 break;
@@ -1960,7 +1980,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
 #ifdef DEBUG_INPUT_EVENTS
                         SDL_Log("Axis 0x%.2x = %d", code, event->value);
 #endif
-                        HandleHat(SDL_EVDEV_GetEventTimestamp(event), joystick, hat_index, code % 2, event->value);
+                        HandleHat(SDL_EVDEV_GetEventTimestamp(event, joystick->hwdata->monotonic_clock), joystick, hat_index, code % 2, event->value);
                         break;
                     }
                     SDL_FALLTHROUGH;
@@ -1969,7 +1989,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
                     SDL_Log("Axis 0x%.2x = %d", code, event->value);
 #endif
                     event->value = AxisCorrect(joystick, code, event->value);
-                    SDL_SendJoystickAxis(SDL_EVDEV_GetEventTimestamp(event), joystick,
+                    SDL_SendJoystickAxis(SDL_EVDEV_GetEventTimestamp(event, joystick->hwdata->monotonic_clock), joystick,
                                             joystick->hwdata->abs_map[code],
                                             event->value);
                     break;
@@ -2012,7 +2032,11 @@ static void HandleInputEvents(SDL_Joystick *joystick)
 
     if (errno == ENODEV) {
         // We have to wait until the JoystickDetect callback to remove this
-        joystick->hwdata->gone = true;
+        if (!joystick->hwdata->gone) {
+            // The dead device would otherwise wake up SDL_WaitEvent() until it's closed
+            SDL_EventWait_RemoveFD(joystick->hwdata->fd);
+            joystick->hwdata->gone = true;
+        }
         errno = 0;
     }
 
@@ -2082,7 +2106,7 @@ static void HandleInputEvents(SDL_Joystick *joystick)
                             joystick->hwdata->recovering_from_dropped_sensor = false;
                             PollAllSensors(SDL_GetTicksNS(), joystick); // try to sync up to current state now
                         } else {
-                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event);
+                            Uint64 timestamp = SDL_EVDEV_GetEventTimestamp(event, joystick->hwdata->sensor_monotonic_clock);
                             SDL_SendJoystickSensor(timestamp, joystick, SDL_SENSOR_GYRO,
                                                    SDL_US_TO_NS(joystick->hwdata->sensor_tick),
                                                    joystick->hwdata->gyro_data, 3);
@@ -2104,7 +2128,10 @@ static void HandleInputEvents(SDL_Joystick *joystick)
 
     if (errno == ENODEV) {
         // We have to wait until the JoystickDetect callback to remove this
-        joystick->hwdata->sensor_gone = true;
+        if (!joystick->hwdata->sensor_gone) {
+            SDL_EventWait_RemoveFD(joystick->hwdata->fd_sensor);
+            joystick->hwdata->sensor_gone = true;
+        }
     }
 }
 
@@ -2192,9 +2219,11 @@ static void LINUX_JoystickClose(SDL_Joystick *joystick)
             joystick->hwdata->effect.id = -1;
         }
         if (joystick->hwdata->fd >= 0) {
+            SDL_EventWait_RemoveFD(joystick->hwdata->fd);
             close(joystick->hwdata->fd);
         }
         if (joystick->hwdata->fd_sensor >= 0) {
+            SDL_EventWait_RemoveFD(joystick->hwdata->fd_sensor);
             close(joystick->hwdata->fd_sensor);
         }
         if (joystick->hwdata->item) {
@@ -2223,6 +2252,7 @@ static void LINUX_JoystickQuit(void)
     SDL_AssertJoysticksLocked();
 
     if (inotify_fd >= 0) {
+        SDL_EventWait_RemoveFD(inotify_fd);
         close(inotify_fd);
         inotify_fd = -1;
     }
@@ -2243,6 +2273,9 @@ static void LINUX_JoystickQuit(void)
 
 #ifdef SDL_USE_LIBUDEV
     if (enumeration_method == ENUMERATION_LIBUDEV) {
+        if (SDL_UDEV_GetMonitorFD() >= 0) {
+            SDL_EventWait_RemoveFD(SDL_UDEV_GetMonitorFD());
+        }
         SDL_UDEV_DelCallback(joystick_udev_callback);
         SDL_UDEV_Quit();
     }
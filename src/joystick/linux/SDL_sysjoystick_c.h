@@ -37,6 +37,8 @@ struct joystick_hwdata
     struct SDL_sensorlist_item *item_sensor;
     SDL_GUID guid;
     char *fname; // Used in haptic subsystem
+    bool monotonic_clock;        // Events on fd are timestamped with CLOCK_MONOTONIC
+    bool sensor_monotonic_clock; // Events on fd_sensor are timestamped with CLOCK_MONOTONIC
 
     bool ff_rumble;
     bool ff_sine;
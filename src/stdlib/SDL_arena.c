@@ -0,0 +1,237 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+// A linear allocator, handing out memory from a chain of blocks
+
+#define SDL_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+typedef struct SDL_ArenaBlock
+{
+    struct SDL_ArenaBlock *next;
+    SDL_ArenaMark start; // the arena position of the first byte in this block
+    size_t size;
+} SDL_ArenaBlock;
+
+#define ARENA_BLOCK_DATA(block) ((Uint8 *)((block) + 1))
+
+struct SDL_Arena
+{
+    size_t block_size;
+    SDL_ArenaBlock *head;
+    SDL_ArenaBlock *current; // NULL until the first allocation
+    size_t used;             // bytes used in the current block
+};
+
+static SDL_TLSID SDL_thread_arena;
+
+SDL_Arena *SDL_CreateArena(size_t block_size)
+{
+    SDL_Arena *arena = (SDL_Arena *)SDL_calloc(1, sizeof(*arena));
+    if (!arena) {
+        return NULL;
+    }
+    arena->block_size = block_size ? block_size : SDL_ARENA_DEFAULT_BLOCK_SIZE;
+    return arena;
+}
+
+// Make the block after the current one current, adding a new block if that one isn't big enough
+static SDL_ArenaBlock *AdvanceArena(SDL_Arena *arena, size_t min_size)
+{
+    SDL_ArenaBlock *prev = arena->current;
+    SDL_ArenaBlock *block = prev ? prev->next : arena->head;
+
+    if (!block || block->size < min_size) {
+        const size_t size = SDL_max(arena->block_size, min_size);
+        size_t total;
+        SDL_ArenaBlock *new_block;
+
+        if (!SDL_size_add_check_overflow(size, sizeof(*new_block), &total)) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        new_block = (SDL_ArenaBlock *)SDL_malloc(total);
+        if (!new_block) {
+            return NULL;
+        }
+        new_block->size = size;
+
+        // Smaller blocks after this one are kept for later
+        new_block->next = block;
+        if (prev) {
+            prev->next = new_block;
+        } else {
+            arena->head = new_block;
+        }
+        block = new_block;
+    }
+
+    block->start = prev ? (prev->start + prev->size) : 0;
+    arena->current = block;
+    arena->used = 0;
+    return block;
+}
+
+static size_t GetArenaPadding(const SDL_ArenaBlock *block, size_t used, size_t alignment)
+{
+    const uintptr_t address = (uintptr_t)(ARENA_BLOCK_DATA(block) + used);
+    return (size_t)((alignment - (address & (alignment - 1))) & (alignment - 1));
+}
+
+void *SDL_AllocateArenaMemory(SDL_Arena *arena, size_t size, size_t alignment)
+{
+    SDL_ArenaBlock *block;
+    size_t padding = 0;
+    void *result;
+
+    CHECK_PARAM(!arena) {
+        SDL_InvalidParamError("arena");
+        return NULL;
+    }
+
+    if (alignment == 0) {
+        alignment = SDL_GetSIMDAlignment();
+    }
+    CHECK_PARAM((alignment & (alignment - 1)) != 0) {
+        SDL_InvalidParamError("alignment");
+        return NULL;
+    }
+
+    if (!size) {
+        size = 1;
+    }
+
+    block = arena->current;
+    if (block) {
+        const size_t remaining = block->size - arena->used;
+        padding = GetArenaPadding(block, arena->used, alignment);
+        if (padding > remaining || size > remaining - padding) {
+            block = NULL;
+        }
+    }
+    if (!block) {
+        size_t min_size;
+        if (!SDL_size_add_check_overflow(size, alignment - 1, &min_size)) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        block = AdvanceArena(arena, min_size);
+        if (!block) {
+            return NULL;
+        }
+        padding = GetArenaPadding(block, 0, alignment);
+    }
+
+    result = ARENA_BLOCK_DATA(block) + arena->used + padding;
+    arena->used += padding + size;
+    return result;
+}
+
+SDL_ArenaMark SDL_GetArenaMark(SDL_Arena *arena)
+{
+    CHECK_PARAM(!arena) {
+        SDL_InvalidParamError("arena");
+        return 0;
+    }
+
+    if (!arena->current) {
+        return 0;
+    }
+    return arena->current->start + arena->used;
+}
+
+void SDL_ResetArenaToMark(SDL_Arena *arena, SDL_ArenaMark mark)
+{
+    SDL_ArenaBlock *block;
+
+    CHECK_PARAM(!arena) {
+        SDL_InvalidParamError("arena");
+        return;
+    }
+
+    // Nothing to release if nothing was allocated after the mark
+    if (!arena->current || mark == arena->current->start + arena->used) {
+        SDL_assert(arena->current || mark == 0);
+        return;
+    }
+
+    // Blocks up to the current one cover consecutive positions
+    for (block = arena->head; block; block = block->next) {
+        if (mark <= block->start + block->size) {
+            arena->current = block;
+            arena->used = (size_t)(mark - block->start);
+            return;
+        }
+        if (block == arena->current) {
+            break;
+        }
+    }
+    SDL_assert(!"Arena mark is past the current position");
+}
+
+void SDL_ResetArena(SDL_Arena *arena)
+{
+    CHECK_PARAM(!arena) {
+        SDL_InvalidParamError("arena");
+        return;
+    }
+
+    if (arena->head) {
+        arena->head->start = 0;
+    }
+    arena->current = arena->head;
+    arena->used = 0;
+}
+
+void SDL_DestroyArena(SDL_Arena *arena)
+{
+    SDL_ArenaBlock *block;
+
+    if (!arena) {
+        return;
+    }
+
+    block = arena->head;
+    while (block) {
+        SDL_ArenaBlock *next = block->next;
+        SDL_free(block);
+        block = next;
+    }
+    SDL_free(arena);
+}
+
+static void SDLCALL SDL_DestroyThreadArena(void *arena)
+{
+    SDL_DestroyArena((SDL_Arena *)arena);
+}
+
+SDL_Arena *SDL_GetThreadArena(void)
+{
+    SDL_Arena *arena = (SDL_Arena *)SDL_GetTLS(&SDL_thread_arena);
+    if (!arena) {
+        arena = SDL_CreateArena(0);
+        if (arena && !SDL_SetTLS(&SDL_thread_arena, arena, SDL_DestroyThreadArena)) {
+            SDL_DestroyArena(arena);
+            arena = NULL;
+        }
+    }
+    return arena;
+}
@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_malloc_c.h"
+
 /* This file contains portable memory management functions for SDL */
 
 #ifndef HAVE_MALLOC
@@ -33,6 +35,16 @@
 #define USE_LOCKS 1
 #define USE_DL_PREFIX
 
+/* Spread allocations over several heaps, so threads don't all contend for the
+   single dlmalloc lock. Build with SDL_MALLOC_THREAD_ARENAS=0 to turn this off. */
+#ifndef SDL_MALLOC_THREAD_ARENAS
+#define SDL_MALLOC_THREAD_ARENAS 1
+#endif
+#if SDL_MALLOC_THREAD_ARENAS
+#define MSPACES 1
+#define FOOTERS 1
+#endif
+
 /*
   This is a version (aka dlmalloc) of malloc/free/realloc written by
   Doug Lea and released to the public domain, as explained at
@@ -6335,6 +6347,192 @@ static void * SDLCALL real_malloc(size_t s) { return malloc(s); }
 static void * SDLCALL real_calloc(size_t n, size_t s) { return calloc(n, s); }
 static void * SDLCALL real_realloc(void *p, size_t s) { return realloc(p,s); }
 static void   SDLCALL real_free(void *p) { free(p); }
+#elif SDL_MALLOC_THREAD_ARENAS
+/* Each thread hashes to a home arena, an mspace with its own spinlock. If the
+   home arena is busy, the next free one is used instead. Footers tell us which
+   arena a block came from, and frees of blocks whose arena is busy are pushed
+   onto a lock-free list that the arena drains the next time it's locked. */
+#define SDL_MALLOC_NUM_ARENAS 8
+
+typedef struct SDL_MallocArena
+{
+    SDL_SpinLock lock;
+    mspace space;
+    bool failed;
+    void *remote_frees;
+    int allocations;
+    SDL_AtomicInt num_remote_frees;
+    SDL_AtomicInt num_contended;
+} SDL_MallocArena;
+
+static union
+{
+    SDL_MallocArena arena;
+    char padding[SDL_CACHELINE_SIZE];
+} SDL_malloc_arenas[SDL_MALLOC_NUM_ARENAS];
+
+SDL_COMPILE_TIME_ASSERT(malloc_arena_size, sizeof(SDL_MallocArena) <= SDL_CACHELINE_SIZE);
+
+static void SDL_DrainMallocArena(SDL_MallocArena *arena)
+{
+    void *mem = SDL_SetAtomicPointer(&arena->remote_frees, NULL);
+    while (mem) {
+        void *next = *(void **)mem;
+        mspace_free(arena->space, mem);
+        --arena->allocations;
+        mem = next;
+    }
+}
+
+// Lock the calling thread's arena, or NULL if it can't be used and the global heap should be used instead
+static SDL_MallocArena *SDL_LockMallocArena(void)
+{
+    const Uint64 id = (Uint64)SDL_GetCurrentThreadID();
+    const int home = (int)(((id * 0x9E3779B97F4A7C15ULL) >> 32) % SDL_MALLOC_NUM_ARENAS);
+    SDL_MallocArena *arena = NULL;
+    int i;
+
+    for (i = 0; i < SDL_MALLOC_NUM_ARENAS; ++i) {
+        SDL_MallocArena *candidate = &SDL_malloc_arenas[(home + i) % SDL_MALLOC_NUM_ARENAS].arena;
+        if (SDL_TryLockSpinlock(&candidate->lock)) {
+            arena = candidate;
+            break;
+        }
+    }
+    if (!arena) {
+        arena = &SDL_malloc_arenas[home].arena;
+        SDL_LockSpinlock(&arena->lock);
+    }
+    if (i > 0) {
+        SDL_AddAtomicInt(&SDL_malloc_arenas[home].arena.num_contended, 1);
+    }
+
+    if (!arena->space) {
+        if (!arena->failed) {
+            arena->space = create_mspace(0, 0);
+            arena->failed = !arena->space;
+        }
+        if (!arena->space) {
+            SDL_UnlockSpinlock(&arena->lock);
+            return NULL;
+        }
+    }
+    SDL_DrainMallocArena(arena);
+    return arena;
+}
+
+// Find the arena a block was allocated from, or NULL if it came from the global heap
+static SDL_MallocArena *SDL_GetMallocArenaFor(void *mem)
+{
+    const mstate m = get_mstate_for(mem2chunk(mem));
+    int i;
+
+    for (i = 0; i < SDL_MALLOC_NUM_ARENAS; ++i) {
+        SDL_MallocArena *arena = &SDL_malloc_arenas[i].arena;
+        if (arena->space && (mstate)arena->space == m) {
+            return arena;
+        }
+    }
+    return NULL;
+}
+
+static void * SDLCALL real_malloc(size_t s)
+{
+    SDL_MallocArena *arena = SDL_LockMallocArena();
+    void *mem;
+
+    if (!arena) {
+        return dlmalloc(s);
+    }
+    mem = mspace_malloc(arena->space, s);
+    if (mem) {
+        ++arena->allocations;
+    }
+    SDL_UnlockSpinlock(&arena->lock);
+    return mem;
+}
+
+static void * SDLCALL real_calloc(size_t n, size_t s)
+{
+    SDL_MallocArena *arena = SDL_LockMallocArena();
+    void *mem;
+
+    if (!arena) {
+        return dlcalloc(n, s);
+    }
+    mem = mspace_calloc(arena->space, n, s);
+    if (mem) {
+        ++arena->allocations;
+    }
+    SDL_UnlockSpinlock(&arena->lock);
+    return mem;
+}
+
+static void * SDLCALL real_realloc(void *p, size_t s)
+{
+    SDL_MallocArena *arena;
+    void *mem;
+
+    if (!p) {
+        return real_malloc(s);
+    }
+
+    // Blocks are resized in the arena that owns them
+    arena = SDL_GetMallocArenaFor(p);
+    if (!arena) {
+        return dlrealloc(p, s);
+    }
+    SDL_LockSpinlock(&arena->lock);
+    SDL_DrainMallocArena(arena);
+    mem = mspace_realloc(arena->space, p, s);
+    SDL_UnlockSpinlock(&arena->lock);
+    return mem;
+}
+
+static void SDLCALL real_free(void *p)
+{
+    SDL_MallocArena *arena;
+
+    if (!p) {
+        return;
+    }
+
+    arena = SDL_GetMallocArenaFor(p);
+    if (!arena) {
+        dlfree(p);
+    } else if (SDL_TryLockSpinlock(&arena->lock)) {
+        SDL_DrainMallocArena(arena);
+        mspace_free(arena->space, p);
+        --arena->allocations;
+        SDL_UnlockSpinlock(&arena->lock);
+    } else {
+        // The arena is busy, let its owner free this later
+        void *head;
+        do {
+            head = SDL_GetAtomicPointer(&arena->remote_frees);
+            *(void **)p = head;
+        } while (!SDL_CompareAndSwapAtomicPointer(&arena->remote_frees, head, p));
+        SDL_AddAtomicInt(&arena->num_remote_frees, 1);
+    }
+}
+
+bool SDL_GetMallocArenaStats(int index, SDL_MallocArenaStats *stats)
+{
+    SDL_MallocArena *arena;
+
+    if (index < 0 || index >= SDL_MALLOC_NUM_ARENAS) {
+        return false;
+    }
+
+    arena = &SDL_malloc_arenas[index].arena;
+    SDL_LockSpinlock(&arena->lock);
+    stats->footprint = arena->space ? mspace_footprint(arena->space) : 0;
+    stats->allocations = arena->allocations;
+    SDL_UnlockSpinlock(&arena->lock);
+    stats->remote_frees = SDL_GetAtomicInt(&arena->num_remote_frees);
+    stats->contended = SDL_GetAtomicInt(&arena->num_contended);
+    return true;
+}
 #else
 #define real_malloc dlmalloc
 #define real_calloc dlcalloc
@@ -6342,6 +6540,13 @@ static void   SDLCALL real_free(void *p) { free(p); }
 #define real_free dlfree
 #endif
 
+#if !defined(SDL_MALLOC_THREAD_ARENAS) || !SDL_MALLOC_THREAD_ARENAS
+bool SDL_GetMallocArenaStats(int index, SDL_MallocArenaStats *stats)
+{
+    return false;
+}
+#endif
+
 // mark the allocator entry points as KEEPALIVE so we can call these from JavaScript.
 // otherwise they could could get so aggressively inlined that their symbols
 // don't exist at all in the final binary!
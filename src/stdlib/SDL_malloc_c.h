@@ -0,0 +1,38 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_malloc_c_h_
+#define SDL_malloc_c_h_
+
+// Statistics for one of the per-thread heaps used by the built-in allocator
+typedef struct SDL_MallocArenaStats
+{
+    size_t footprint;   // bytes of memory obtained from the system
+    int allocations;    // blocks currently allocated
+    int remote_frees;   // frees deferred because the arena was busy
+    int contended;      // times a thread found this arena busy and went elsewhere
+} SDL_MallocArenaStats;
+
+// Get statistics for an arena, returns false if there's no such arena or SDL isn't using its own allocator
+extern bool SDL_GetMallocArenaStats(int index, SDL_MallocArenaStats *stats);
+
+#endif // SDL_malloc_c_h_
@@ -86,6 +86,92 @@ static SDL_AtomicInt s_lock;
     } while (true)
 #define UNLOCK_ALLOCATOR() do { SDL_SetAtomicInt(&s_lock, 0); } while (0)
 
+static void SDLTest_InitStackSymbols(void)
+{
+    static bool initialized = false;
+
+    if (initialized) {
+        return;
+    }
+    initialized = true;
+
+#ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
+    do {
+        /* Don't use SDL_GetHint: SDL_malloc is off limits. */
+        const char *env_trackmem = SDL_getenv_unsafe("SDL_TRACKMEM_SYMBOL_NAMES");
+        if (env_trackmem) {
+            if (SDL_strcasecmp(env_trackmem, "1") == 0 || SDL_strcasecmp(env_trackmem, "yes") == 0 || SDL_strcasecmp(env_trackmem, "true") == 0) {
+                s_unwind_symbol_names = true;
+            } else if (SDL_strcasecmp(env_trackmem, "0") == 0 || SDL_strcasecmp(env_trackmem, "no") == 0 || SDL_strcasecmp(env_trackmem, "false") == 0) {
+                s_unwind_symbol_names = false;
+            }
+        }
+    } while (0);
+
+#elif defined(SDL_PLATFORM_WIN32)
+    do {
+        dyn_dbghelp.module = SDL_LoadObject("dbghelp.dll");
+        if (!dyn_dbghelp.module) {
+            goto dbghelp_failed;
+        }
+        dyn_dbghelp.pSymInitialize = (void *)SDL_LoadFunction(dyn_dbghelp.module, "SymInitialize");
+        dyn_dbghelp.pSymFromAddr = (void *)SDL_LoadFunction(dyn_dbghelp.module, "SymFromAddr");
+        dyn_dbghelp.pSymGetLineFromAddr64 = (void *)SDL_LoadFunction(dyn_dbghelp.module, "SymGetLineFromAddr64");
+        if (!dyn_dbghelp.pSymInitialize || !dyn_dbghelp.pSymFromAddr || !dyn_dbghelp.pSymGetLineFromAddr64) {
+            goto dbghelp_failed;
+        }
+        if (!dyn_dbghelp.pSymInitialize(GetCurrentProcess(), NULL, TRUE)) {
+            goto dbghelp_failed;
+        }
+        break;
+dbghelp_failed:
+        if (dyn_dbghelp.module) {
+            SDL_UnloadObject(dyn_dbghelp.module);
+            dyn_dbghelp.module = NULL;
+        }
+    } while (0);
+#endif
+}
+
+/* Describe a frame of a captured stack trace, this may return "???" if symbols aren't available */
+static void SDLTest_DescribeStackFrame(Uint64 pc, char *description, size_t maxlen)
+{
+    SDL_strlcpy(description, "???", maxlen);
+
+#if defined(HAVE_LIBUNWIND_H) && !defined(SDLTEST_UNWIND_NO_PROC_NAME_BY_IP)
+    {
+        char name[256] = "???";
+        unw_word_t offset = 0;
+        unw_get_proc_name_by_ip(unw_local_addr_space, pc, name, sizeof(name), &offset, NULL);
+        (void)SDL_snprintf(description, maxlen, "%s+0x%llx", name, (long long unsigned int)offset);
+    }
+#elif defined(SDL_PLATFORM_WIN32)
+    {
+        DWORD64 dwDisplacement = 0;
+        char symbol_buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(TCHAR)];
+        PSYMBOL_INFO pSymbol = (PSYMBOL_INFO)symbol_buffer;
+        DWORD lineColumn = 0;
+        pSymbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+        pSymbol->MaxNameLen = MAX_SYM_NAME;
+        IMAGEHLP_LINE64 dbg_line;
+        dbg_line.SizeOfStruct = sizeof(dbg_line);
+        dbg_line.FileName = "";
+        dbg_line.LineNumber = 0;
+
+        if (dyn_dbghelp.module) {
+            if (!dyn_dbghelp.pSymFromAddr(GetCurrentProcess(), pc, &dwDisplacement, pSymbol)) {
+                SDL_strlcpy(pSymbol->Name, "???", MAX_SYM_NAME);
+                dwDisplacement = 0;
+            }
+            dyn_dbghelp.pSymGetLineFromAddr64(GetCurrentProcess(), (DWORD64)pc, &lineColumn, &dbg_line);
+        }
+        SDL_snprintf(description, maxlen, "%s+0x%I64x %s:%u", pSymbol->Name, dwDisplacement, dbg_line.FileName, (Uint32)dbg_line.LineNumber);
+    }
+#else
+    (void)pc;
+#endif
+}
+
 static unsigned int get_allocation_bucket(void *mem)
 {
     CrcUint32 crc_value;
@@ -300,42 +386,7 @@ void SDLTest_TrackAllocations(void)
     } else if (s_previous_allocations != 0) {
         SDL_Log("SDLTest_TrackAllocations(): There are %d previous allocations, disabling free() validation", s_previous_allocations);
     }
-#ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
-    do {
-        /* Don't use SDL_GetHint: SDL_malloc is off limits. */
-        const char *env_trackmem = SDL_getenv_unsafe("SDL_TRACKMEM_SYMBOL_NAMES");
-        if (env_trackmem) {
-            if (SDL_strcasecmp(env_trackmem, "1") == 0 || SDL_strcasecmp(env_trackmem, "yes") == 0 || SDL_strcasecmp(env_trackmem, "true") == 0) {
-                s_unwind_symbol_names = true;
-            } else if (SDL_strcasecmp(env_trackmem, "0") == 0 || SDL_strcasecmp(env_trackmem, "no") == 0 || SDL_strcasecmp(env_trackmem, "false") == 0) {
-                s_unwind_symbol_names = false;
-            }
-        }
-    } while (0);
-
-#elif defined(SDL_PLATFORM_WIN32)
-    do {
-        dyn_dbghelp.module = SDL_LoadObject("dbghelp.dll");
-        if (!dyn_dbghelp.module) {
-            goto dbghelp_failed;
-        }
-        dyn_dbghelp.pSymInitialize = (void *)SDL_LoadFunction(dyn_dbghelp.module, "SymInitialize");
-        dyn_dbghelp.pSymFromAddr = (void *)SDL_LoadFunction(dyn_dbghelp.module, "SymFromAddr");
-        dyn_dbghelp.pSymGetLineFromAddr64 = (void *)SDL_LoadFunction(dyn_dbghelp.module, "SymGetLineFromAddr64");
-        if (!dyn_dbghelp.pSymInitialize || !dyn_dbghelp.pSymFromAddr || !dyn_dbghelp.pSymGetLineFromAddr64) {
-            goto dbghelp_failed;
-        }
-        if (!dyn_dbghelp.pSymInitialize(GetCurrentProcess(), NULL, TRUE)) {
-            goto dbghelp_failed;
-        }
-        break;
-dbghelp_failed:
-        if (dyn_dbghelp.module) {
-            SDL_UnloadObject(dyn_dbghelp.module);
-            dyn_dbghelp.module = NULL;
-        }
-    } while (0);
-#endif
+    SDLTest_InitStackSymbols();
 
     SDL_GetMemoryFunctions(&SDL_malloc_orig,
                            &SDL_calloc_orig,
@@ -399,41 +450,12 @@ void SDLTest_LogAllocations(void)
                 if (!entry->stack[stack_index]) {
                     break;
                 }
-#ifdef HAVE_LIBUNWIND_H
-                {
 #ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
-                    if (s_unwind_symbol_names) {
-                        (void)SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s", entry->stack_names[stack_index]);
-                    }
-#else
-                    char name[256] = "???";
-                    unw_word_t offset = 0;
-                    unw_get_proc_name_by_ip(unw_local_addr_space, entry->stack[stack_index], name, sizeof(name), &offset, NULL);
-                    (void)SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s+0x%llx", name, (long long unsigned int)offset);
-#endif
-                }
-#elif defined(SDL_PLATFORM_WIN32)
-                {
-                    DWORD64 dwDisplacement = 0;
-                    char symbol_buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(TCHAR)];
-                    PSYMBOL_INFO pSymbol = (PSYMBOL_INFO)symbol_buffer;
-                    DWORD lineColumn = 0;
-                    pSymbol->SizeOfStruct = sizeof(SYMBOL_INFO);
-                    pSymbol->MaxNameLen = MAX_SYM_NAME;
-                    IMAGEHLP_LINE64 dbg_line;
-                    dbg_line.SizeOfStruct = sizeof(dbg_line);
-                    dbg_line.FileName = "";
-                    dbg_line.LineNumber = 0;
-
-                    if (dyn_dbghelp.module) {
-                        if (!dyn_dbghelp.pSymFromAddr(GetCurrentProcess(), entry->stack[stack_index], &dwDisplacement, pSymbol)) {
-                            SDL_strlcpy(pSymbol->Name, "???", MAX_SYM_NAME);
-                            dwDisplacement = 0;
-                        }
-                        dyn_dbghelp.pSymGetLineFromAddr64(GetCurrentProcess(), (DWORD64)entry->stack[stack_index], &lineColumn, &dbg_line);
-                    }
-                    SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s+0x%I64x %s:%u", pSymbol->Name, dwDisplacement, dbg_line.FileName, (Uint32)dbg_line.LineNumber);
+                if (s_unwind_symbol_names) {
+                    (void)SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s", entry->stack_names[stack_index]);
                 }
+#else
+                SDLTest_DescribeStackFrame(entry->stack[stack_index], stack_entry_description, sizeof(stack_entry_description));
 #endif
                 (void)SDL_snprintf(line, sizeof(line), "\t0x%" SDL_PRIx64 ": %s\n", entry->stack[stack_index], stack_entry_description);
 
@@ -456,3 +478,554 @@ void SDLTest_LogAllocations(void)
     SDL_Log("%s", message);
     SDL_free_orig(message);
 }
+
+/* This is a sampling heap profiler, meant to be cheap enough to leave running
+   in a long session.
+
+   Each allocation counts down the number of bytes left until the next
+   sample, and sampled allocations record a stack trace. On average one
+   allocation is recorded per sample interval, and each sample is weighted
+   by the number of bytes it stands for, which gives an unbiased estimate of
+   the live heap. Frees only look up their pointer when a sample might be in
+   the same bucket, so the cost for unsampled allocations is a couple of
+   atomic operations.
+*/
+
+#define HEAP_PROFILE_DEFAULT_INTERVAL   (512 * 1024)
+#define HEAP_PROFILE_STACK_DEPTH        16
+#define HEAP_PROFILE_COUNTDOWN_SLOTS    16
+#define HEAP_PROFILE_SAMPLE_BUCKETS     4096
+#define HEAP_PROFILE_SITE_BUCKETS       1024
+
+typedef struct SDL_heap_profile_site
+{
+    Uint32 hash;
+    const char *tag;
+    int depth;
+    Uint64 stack[HEAP_PROFILE_STACK_DEPTH];
+    double live_bytes;
+    double live_count;
+    double total_bytes;
+    double total_count;
+    struct SDL_heap_profile_site *next;
+} SDL_heap_profile_site;
+
+typedef struct SDL_heap_profile_sample
+{
+    void *mem;
+    double weight;  /* The estimated number of bytes this sample stands for */
+    double count;   /* The estimated number of allocations this sample stands for */
+    SDL_heap_profile_site *site;
+    struct SDL_heap_profile_sample *next;
+} SDL_heap_profile_sample;
+
+typedef struct SDL_heap_profile_countdown
+{
+    SDL_AtomicInt bytes_left;
+    char pad[64 - sizeof(SDL_AtomicInt)];
+} SDL_heap_profile_countdown;
+
+static SDL_malloc_func s_heap_malloc_orig = NULL;
+static SDL_calloc_func s_heap_calloc_orig = NULL;
+static SDL_realloc_func s_heap_realloc_orig = NULL;
+static SDL_free_func s_heap_free_orig = NULL;
+static SDL_AtomicInt s_heap_active;
+static SDL_SpinLock s_heap_lock;
+static Uint32 s_heap_interval;
+static Uint64 s_heap_random;
+static SDL_TLSID s_heap_tag;
+static SDL_heap_profile_countdown s_heap_countdown[HEAP_PROFILE_COUNTDOWN_SLOTS];
+static SDL_heap_profile_sample *s_heap_samples[HEAP_PROFILE_SAMPLE_BUCKETS];
+static SDL_AtomicInt s_heap_sample_counts[HEAP_PROFILE_SAMPLE_BUCKETS];
+static SDL_heap_profile_site *s_heap_sites[HEAP_PROFILE_SITE_BUCKETS];
+
+static Uint32 SDLTest_HeapSampleBucket(const void *mem)
+{
+    return (Uint32)(((Uint64)(uintptr_t)mem >> 4) * 0x9E3779B97F4A7C15ULL >> 52);
+}
+
+/* Choose the countdown slot for the current thread, mixing the ID since thread IDs are often aligned addresses */
+static Uint32 SDLTest_HeapCountdownSlot(void)
+{
+    Uint64 id = (Uint64)SDL_GetCurrentThreadID();
+
+    id ^= id >> 33;
+    id *= 0xFF51AFD7ED558CCDULL;
+    id ^= id >> 33;
+    return (Uint32)(id % HEAP_PROFILE_COUNTDOWN_SLOTS);
+}
+
+/* Choose the number of bytes until the next sample, exponentially distributed around the interval -- called with the lock held */
+static int SDLTest_NextHeapSampleDistance(void)
+{
+    double u = (SDL_rand_bits_r(&s_heap_random) >> 8) / 16777216.0;
+    double distance = -SDL_log(1.0 - u) * s_heap_interval;
+
+    return (int)SDL_clamp(distance, 1.0, (double)SDL_MAX_SINT32);
+}
+
+static int SDLTest_CaptureHeapProfileStack(Uint64 *stack, int max_depth)
+{
+    int depth = 0;
+
+#ifdef HAVE_LIBUNWIND_H
+    unw_cursor_t cursor;
+    unw_context_t context;
+
+    unw_getcontext(&context);
+    unw_init_local(&cursor, &context);
+
+    /* Skip the profiler functions */
+    unw_step(&cursor);
+    unw_step(&cursor);
+    while (depth < max_depth && unw_step(&cursor) > 0) {
+        unw_word_t pc;
+        unw_get_reg(&cursor, UNW_REG_IP, &pc);
+        stack[depth++] = pc;
+    }
+#elif defined(SDL_PLATFORM_WIN32)
+    PVOID frames[HEAP_PROFILE_STACK_DEPTH];
+    int i;
+
+    depth = CaptureStackBackTrace(3, (ULONG)SDL_min(max_depth, (int)SDL_arraysize(frames)), frames, NULL);
+    for (i = 0; i < depth; ++i) {
+        stack[i] = (Uint64)(uintptr_t)frames[i];
+    }
+#else
+    (void)stack;
+    (void)max_depth;
+#endif
+    return depth;
+}
+
+static void SDLTest_SampleHeapAllocation(void *mem, size_t size)
+{
+    SDL_heap_profile_site *site;
+    SDL_heap_profile_sample *sample;
+    Uint64 stack[HEAP_PROFILE_STACK_DEPTH];
+    const char *tag = (const char *)SDL_GetTLS(&s_heap_tag);
+    int depth = SDLTest_CaptureHeapProfileStack(stack, SDL_arraysize(stack));
+    Uint32 hash = 0, bucket;
+    double weight;
+    int i;
+
+    for (i = 0; i < depth; ++i) {
+        hash = (hash ^ (Uint32)(stack[i] ^ (stack[i] >> 32))) * 0x01000193;
+    }
+    hash ^= (Uint32)(uintptr_t)tag;
+
+    /* An allocation of size bytes is sampled with probability 1 - e^(-size / interval) */
+    weight = (double)size / (1.0 - SDL_exp(-(double)size / s_heap_interval));
+
+    sample = (SDL_heap_profile_sample *)s_heap_malloc_orig(sizeof(*sample));
+    if (!sample) {
+        return;
+    }
+
+    SDL_LockSpinlock(&s_heap_lock);
+    if (!SDL_GetAtomicInt(&s_heap_active)) {
+        SDL_UnlockSpinlock(&s_heap_lock);
+        s_heap_free_orig(sample);
+        return;
+    }
+
+    bucket = hash % HEAP_PROFILE_SITE_BUCKETS;
+    for (site = s_heap_sites[bucket]; site; site = site->next) {
+        if (site->hash == hash && site->tag == tag && site->depth == depth &&
+            SDL_memcmp(site->stack, stack, depth * sizeof(*stack)) == 0) {
+            break;
+        }
+    }
+    if (!site) {
+        site = (SDL_heap_profile_site *)s_heap_calloc_orig(1, sizeof(*site));
+        if (!site) {
+            SDL_UnlockSpinlock(&s_heap_lock);
+            s_heap_free_orig(sample);
+            return;
+        }
+        site->hash = hash;
+        site->tag = tag;
+        site->depth = depth;
+        SDL_memcpy(site->stack, stack, depth * sizeof(*stack));
+        site->next = s_heap_sites[bucket];
+        s_heap_sites[bucket] = site;
+    }
+    site->live_bytes += weight;
+    site->live_count += weight / size;
+    site->total_bytes += weight;
+    site->total_count += weight / size;
+
+    bucket = SDLTest_HeapSampleBucket(mem);
+    sample->mem = mem;
+    sample->weight = weight;
+    sample->count = weight / size;
+    sample->site = site;
+    sample->next = s_heap_samples[bucket];
+    s_heap_samples[bucket] = sample;
+    SDL_AddAtomicInt(&s_heap_sample_counts[bucket], 1);
+    SDL_UnlockSpinlock(&s_heap_lock);
+}
+
+static void SDLTest_CountHeapAllocation(void *mem, size_t size)
+{
+    SDL_heap_profile_countdown *countdown;
+    int amount;
+
+    if (!SDL_GetAtomicInt(&s_heap_active) || size == 0) {
+        return;
+    }
+
+    countdown = &s_heap_countdown[SDLTest_HeapCountdownSlot()];
+    amount = (int)SDL_min(size, (size_t)SDL_MAX_SINT32);
+    if (SDL_AddAtomicInt(&countdown->bytes_left, -amount) - amount > 0) {
+        return;
+    }
+
+    SDL_LockSpinlock(&s_heap_lock);
+    SDL_SetAtomicInt(&countdown->bytes_left, SDLTest_NextHeapSampleDistance());
+    SDL_UnlockSpinlock(&s_heap_lock);
+
+    SDLTest_SampleHeapAllocation(mem, size);
+}
+
+static void SDLTest_UncountHeapAllocation(void *mem)
+{
+    SDL_heap_profile_sample *sample, *prev = NULL;
+    Uint32 bucket = SDLTest_HeapSampleBucket(mem);
+
+    if (SDL_GetAtomicInt(&s_heap_sample_counts[bucket]) == 0) {
+        return;
+    }
+
+    SDL_LockSpinlock(&s_heap_lock);
+    for (sample = s_heap_samples[bucket]; sample; prev = sample, sample = sample->next) {
+        if (sample->mem == mem) {
+            if (prev) {
+                prev->next = sample->next;
+            } else {
+                s_heap_samples[bucket] = sample->next;
+            }
+            SDL_AddAtomicInt(&s_heap_sample_counts[bucket], -1);
+            break;
+        }
+    }
+    if (sample) {
+        SDL_heap_profile_site *site = sample->site;
+        site->live_bytes -= sample->weight;
+        site->live_count -= sample->count;
+    }
+    SDL_UnlockSpinlock(&s_heap_lock);
+
+    if (sample) {
+        s_heap_free_orig(sample);
+    }
+}
+
+static void * SDLCALL SDLTest_ProfiledMalloc(size_t size)
+{
+    void *mem = s_heap_malloc_orig(size);
+    if (mem) {
+        SDLTest_CountHeapAllocation(mem, size);
+    }
+    return mem;
+}
+
+static void * SDLCALL SDLTest_ProfiledCalloc(size_t nmemb, size_t size)
+{
+    void *mem = s_heap_calloc_orig(nmemb, size);
+    if (mem) {
+        SDLTest_CountHeapAllocation(mem, nmemb * size);
+    }
+    return mem;
+}
+
+static void * SDLCALL SDLTest_ProfiledRealloc(void *ptr, size_t size)
+{
+    void *mem;
+
+    /* Forget the old pointer first, another thread may get it as soon as it's freed */
+    if (ptr) {
+        SDLTest_UncountHeapAllocation(ptr);
+    }
+    mem = s_heap_realloc_orig(ptr, size);
+    if (mem) {
+        SDLTest_CountHeapAllocation(mem, size);
+    }
+    return mem;
+}
+
+static void SDLCALL SDLTest_ProfiledFree(void *ptr)
+{
+    if (ptr) {
+        SDLTest_UncountHeapAllocation(ptr);
+    }
+    s_heap_free_orig(ptr);
+}
+
+bool SDLTest_StartHeapProfiler(Uint32 sample_interval)
+{
+    int i;
+
+    if (!s_heap_malloc_orig) {
+        SDLTest_InitStackSymbols();
+
+        SDL_GetMemoryFunctions(&s_heap_malloc_orig,
+                               &s_heap_calloc_orig,
+                               &s_heap_realloc_orig,
+                               &s_heap_free_orig);
+
+        if (!SDL_SetMemoryFunctions(SDLTest_ProfiledMalloc,
+                                    SDLTest_ProfiledCalloc,
+                                    SDLTest_ProfiledRealloc,
+                                    SDLTest_ProfiledFree)) {
+            s_heap_malloc_orig = NULL;
+            return false;
+        }
+    }
+
+    SDLTest_StopHeapProfiler();
+
+    SDL_LockSpinlock(&s_heap_lock);
+    s_heap_interval = sample_interval ? sample_interval : HEAP_PROFILE_DEFAULT_INTERVAL;
+    s_heap_random = SDL_GetPerformanceCounter();
+    for (i = 0; i < SDL_arraysize(s_heap_countdown); ++i) {
+        SDL_SetAtomicInt(&s_heap_countdown[i].bytes_left, SDLTest_NextHeapSampleDistance());
+    }
+    SDL_SetAtomicInt(&s_heap_active, 1);
+    SDL_UnlockSpinlock(&s_heap_lock);
+
+    return true;
+}
+
+void SDLTest_StopHeapProfiler(void)
+{
+    SDL_heap_profile_sample *samples = NULL;
+    SDL_heap_profile_site *sites = NULL;
+    int i;
+
+    /* The allocation functions stay installed, they're cheap when the profiler isn't active */
+    SDL_LockSpinlock(&s_heap_lock);
+    SDL_SetAtomicInt(&s_heap_active, 0);
+    for (i = 0; i < SDL_arraysize(s_heap_samples); ++i) {
+        while (s_heap_samples[i]) {
+            SDL_heap_profile_sample *sample = s_heap_samples[i];
+            s_heap_samples[i] = sample->next;
+            sample->next = samples;
+            samples = sample;
+        }
+        SDL_SetAtomicInt(&s_heap_sample_counts[i], 0);
+    }
+    for (i = 0; i < SDL_arraysize(s_heap_sites); ++i) {
+        while (s_heap_sites[i]) {
+            SDL_heap_profile_site *site = s_heap_sites[i];
+            s_heap_sites[i] = site->next;
+            site->next = sites;
+            sites = site;
+        }
+    }
+    SDL_UnlockSpinlock(&s_heap_lock);
+
+    while (samples) {
+        SDL_heap_profile_sample *next = samples->next;
+        s_heap_free_orig(samples);
+        samples = next;
+    }
+    while (sites) {
+        SDL_heap_profile_site *next = sites->next;
+        s_heap_free_orig(sites);
+        sites = next;
+    }
+}
+
+void SDLTest_SetHeapProfilerTag(const char *tag)
+{
+    SDL_SetTLS(&s_heap_tag, (void *)tag, NULL);
+}
+
+/* Guess which subsystem an allocation came from, using the outermost SDL function in its stack trace that we recognize */
+static const char *SDLTest_GuessHeapProfileSubsystem(const SDL_heap_profile_site *site)
+{
+    static const struct
+    {
+        const char *keyword;
+        const char *subsystem;
+    } subsystems[] = {
+        { "Audio", "audio" },
+        { "WAV", "audio" },
+        { "Camera", "camera" },
+        { "Gamepad", "joystick" },
+        { "Joystick", "joystick" },
+        { "HIDAPI", "hidapi" },
+        { "hid_", "hidapi" },
+        { "Sensor", "sensor" },
+        { "Haptic", "haptic" },
+        { "GPU", "gpu" },
+        { "Render", "render" },
+        { "Texture", "render" },
+        { "Window", "video" },
+        { "Video", "video" },
+        { "Display", "video" },
+        { "Surface", "video" },
+        { "GL_", "video" },
+        { "Vulkan", "video" },
+        { "Metal", "video" },
+        { "Clipboard", "video" },
+        { "Event", "events" },
+        { "Timer", "timer" },
+        { "IO", "io" },
+        { "Storage", "storage" },
+        { "Propert", "properties" },
+        { "Hint", "hints" },
+        { "Tray", "tray" },
+        { "Dialog", "dialog" },
+        { "Process", "process" },
+    };
+    bool symbols = false, in_sdl = false;
+    int i, j;
+
+    for (i = site->depth - 1; i >= 0; --i) {
+        char name[256], *offset;
+
+        SDLTest_DescribeStackFrame(site->stack[i], name, sizeof(name));
+        if (SDL_strncmp(name, "???", 3) == 0) {
+            continue;
+        }
+        symbols = true;
+        if (SDL_strncmp(name, "SDL_", 4) != 0) {
+            continue;
+        }
+        in_sdl = true;
+        offset = SDL_strchr(name, '+');
+        if (offset) {
+            *offset = '\0';
+        }
+        for (j = 0; j < SDL_arraysize(subsystems); ++j) {
+            if (SDL_strstr(name, subsystems[j].keyword)) {
+                return subsystems[j].subsystem;
+            }
+        }
+    }
+    if (in_sdl) {
+        return "SDL";
+    }
+    return symbols ? "app" : "unknown";
+}
+
+static int SDLCALL SDLTest_CompareHeapProfileSites(const void *a, const void *b)
+{
+    const SDL_heap_profile_site *A = (const SDL_heap_profile_site *)a;
+    const SDL_heap_profile_site *B = (const SDL_heap_profile_site *)b;
+
+    if (A->live_bytes != B->live_bytes) {
+        return (A->live_bytes > B->live_bytes) ? -1 : 1;
+    }
+    return 0;
+}
+
+bool SDLTest_WriteHeapProfile(SDL_IOStream *dst, bool closeio)
+{
+    SDL_heap_profile_site *sites = NULL, *site;
+    struct
+    {
+        const char *name;
+        double bytes;
+        double count;
+    } totals[32];
+    int num_sites = 0, num_totals = 0;
+    double live_bytes = 0.0, live_count = 0.0;
+    bool result = false;
+    int i, j;
+
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (!s_heap_malloc_orig || !SDL_GetAtomicInt(&s_heap_active)) {
+        SDL_SetError("The heap profiler isn't running");
+        goto done;
+    }
+
+    /* Take a snapshot of the sites, we can't hold the lock while writing since that may allocate memory */
+    SDL_LockSpinlock(&s_heap_lock);
+    for (i = 0; i < SDL_arraysize(s_heap_sites); ++i) {
+        for (site = s_heap_sites[i]; site; site = site->next) {
+            ++num_sites;
+        }
+    }
+    sites = (SDL_heap_profile_site *)s_heap_malloc_orig(SDL_max(num_sites, 1) * sizeof(*sites));
+    if (sites) {
+        num_sites = 0;
+        for (i = 0; i < SDL_arraysize(s_heap_sites); ++i) {
+            for (site = s_heap_sites[i]; site; site = site->next) {
+                if (site->live_count >= 0.5) {
+                    sites[num_sites++] = *site;
+                }
+            }
+        }
+    }
+    SDL_UnlockSpinlock(&s_heap_lock);
+
+    if (!sites) {
+        SDL_OutOfMemory();
+        goto done;
+    }
+    SDL_qsort(sites, num_sites, sizeof(*sites), SDLTest_CompareHeapProfileSites);
+
+    for (i = 0; i < num_sites; ++i) {
+        site = &sites[i];
+        if (!site->tag) {
+            site->tag = SDLTest_GuessHeapProfileSubsystem(site);
+        }
+        for (j = 0; j < num_totals; ++j) {
+            if (SDL_strcmp(totals[j].name, site->tag) == 0) {
+                break;
+            }
+        }
+        if (j == num_totals && num_totals < SDL_arraysize(totals)) {
+            totals[j].name = site->tag;
+            totals[j].bytes = 0.0;
+            totals[j].count = 0.0;
+            ++num_totals;
+        }
+        if (j < num_totals) {
+            totals[j].bytes += site->live_bytes;
+            totals[j].count += site->live_count;
+        }
+        live_bytes += site->live_bytes;
+        live_count += site->live_count;
+    }
+
+    if (!SDL_IOprintf(dst, "Heap profile, sampled every %" SDL_PRIu32 " bytes on average\n", s_heap_interval) ||
+        !SDL_IOprintf(dst, "Live: %.0f bytes in %.0f allocations (estimated)\n\nBy subsystem:\n", live_bytes, live_count)) {
+        goto done;
+    }
+    for (i = 0; i < num_totals; ++i) {
+        if (!SDL_IOprintf(dst, "  %s: %.0f bytes in %.0f allocations\n", totals[i].name, totals[i].bytes, totals[i].count)) {
+            goto done;
+        }
+    }
+    for (i = 0; i < num_sites; ++i) {
+        site = &sites[i];
+        if (!SDL_IOprintf(dst, "\nSite %d [%s]: %.0f bytes in %.0f allocations live, %.0f bytes in %.0f allocations total\n",
+                          i, site->tag, site->live_bytes, site->live_count, site->total_bytes, site->total_count)) {
+            goto done;
+        }
+        for (j = 0; j < site->depth; ++j) {
+            char description[256];
+
+            SDLTest_DescribeStackFrame(site->stack[j], description, sizeof(description));
+            if (!SDL_IOprintf(dst, "\t0x%" SDL_PRIx64 ": %s\n", site->stack[j], description)) {
+                goto done;
+            }
+        }
+    }
+    result = true;
+
+done:
+    if (sites) {
+        s_heap_free_orig(sites);
+    }
+    if (closeio && !SDL_CloseIO(dst)) {
+        result = false;
+    }
+    return result;
+}
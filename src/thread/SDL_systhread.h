@@ -46,6 +46,9 @@ extern void SDL_SYS_SetupThread(const char *name);
 // This function sets the current thread priority
 extern bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority);
 
+// This function restricts the current thread to a set of CPUs
+extern bool SDL_SYS_SetThreadAffinity(const int *cpus, int num_cpus);
+
 /* This function waits for the thread to finish and frees any data
    allocated by SDL_SYS_CreateThread()
  */
@@ -25,6 +25,7 @@
 #include "SDL_thread_c.h"
 #include "SDL_systhread.h"
 #include "../SDL_error_c.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 // The storage is local to the thread, but the IDs are global for the process
 
@@ -321,6 +322,13 @@ void SDL_RunThread(SDL_Thread *thread)
     // Perform any system-dependent setup - this function may not fail
     SDL_SYS_SetupThread(thread->name);
 
+    // Move to the requested CPUs, this is best effort
+    if (thread->affinity) {
+        SDL_SYS_SetThreadAffinity(thread->affinity, thread->num_affinity);
+        SDL_free(thread->affinity);
+        thread->affinity = NULL;
+    }
+
     // Get the thread id
     thread->threadid = SDL_GetCurrentThreadID();
 
@@ -356,16 +364,24 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     const char *name = SDL_GetStringProperty(props, SDL_PROP_THREAD_CREATE_NAME_STRING, NULL);
     const size_t stacksize = (size_t) SDL_GetNumberProperty(props, SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER, 0);
     void *userdata = SDL_GetPointerProperty(props, SDL_PROP_THREAD_CREATE_USERDATA_POINTER, NULL);
+    const char *affinity = SDL_GetStringProperty(props, SDL_PROP_THREAD_CREATE_AFFINITY_STRING, NULL);
+    int *cpus = NULL;
+    int num_cpus = 0;
 
     if (!fn) {
         SDL_SetError("Thread entry function is NULL");
         return NULL;
     }
 
+    if (affinity && !SDL_ParseCPUList(affinity, &cpus, &num_cpus)) {
+        return NULL;
+    }
+
     SDL_InitMainThread();
 
     SDL_Thread *thread = (SDL_Thread *)SDL_calloc(1, sizeof(*thread));
     if (!thread) {
+        SDL_free(cpus);
         return NULL;
     }
     thread->status = -1;
@@ -375,6 +391,7 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     if (name) {
         thread->name = SDL_strdup(name);
         if (!thread->name) {
+            SDL_free(cpus);
             SDL_free(thread);
             return NULL;
         }
@@ -383,6 +400,12 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     thread->userfunc = fn;
     thread->userdata = userdata;
     thread->stacksize = stacksize;
+    if (num_cpus > 0) {
+        thread->affinity = cpus;
+        thread->num_affinity = num_cpus;
+    } else {
+        SDL_free(cpus);
+    }
 
     SDL_SetObjectValid(thread, SDL_OBJECT_TYPE_THREAD, true);
 
@@ -390,6 +413,7 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     if (!SDL_SYS_CreateThread(thread, pfnBeginThread, pfnEndThread)) {
         // Oops, failed.  Gotta free everything
         SDL_SetObjectValid(thread, SDL_OBJECT_TYPE_THREAD, false);
+        SDL_free(thread->affinity);
         SDL_free(thread->name);
         SDL_free(thread);
         thread = NULL;
@@ -454,6 +478,25 @@ bool SDL_SetCurrentThreadPriority(SDL_ThreadPriority priority)
     return SDL_SYS_SetThreadPriority(priority);
 }
 
+bool SDL_SetCurrentThreadAffinity(const int *cpus, int num_cpus)
+{
+    int i;
+
+    CHECK_PARAM(!cpus) {
+        return SDL_InvalidParamError("cpus");
+    }
+    CHECK_PARAM(num_cpus <= 0) {
+        return SDL_InvalidParamError("num_cpus");
+    }
+    for (i = 0; i < num_cpus; ++i) {
+        CHECK_PARAM(cpus[i] < 0) {
+            return SDL_InvalidParamError("cpus");
+        }
+    }
+
+    return SDL_SYS_SetThreadAffinity(cpus, num_cpus);
+}
+
 void SDL_WaitThread(SDL_Thread *thread, int *status)
 {
     if (!ThreadValid(thread)) {
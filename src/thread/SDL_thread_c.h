@@ -54,6 +54,8 @@ struct SDL_Thread
     SDL_error errbuf;
     char *name;
     size_t stacksize; // 0 for default, >0 for user-specified stack size.
+    int *affinity; // CPUs to run on, or NULL for any
+    int num_affinity;
     int(SDLCALL *userfunc)(void *);
     void *userdata;
     void *data;
@@ -80,6 +82,9 @@ typedef struct
 extern void SDL_InitTLSData(void);
 extern void SDL_QuitTLSData(void);
 
+// Destroy the thread pool shared with the application
+extern void SDL_QuitThreadPools(void);
+
 /* Generic TLS support.
    This is only intended as a fallback if getting real thread-local
    storage fails or isn't supported on this platform.
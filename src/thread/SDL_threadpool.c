@@ -0,0 +1,550 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_thread_c.h"
+
+/* Each worker has its own queue of jobs. A worker takes the newest job from
+ * its own queue, which is usually the one it just submitted and has warm
+ * caches, and when that is empty it steals the oldest job from another
+ * worker's queue. Threads outside the pool submit jobs to the workers' queues
+ * in turn, and threads waiting for a job group run jobs while they wait.
+ */
+
+typedef struct SDL_Job
+{
+    SDL_JobFunction func;
+    void *userdata;
+    SDL_JobGroup *group;
+    struct SDL_Job *next; // Only used in the free list
+} SDL_Job;
+
+typedef struct SDL_JobQueue
+{
+    SDL_SpinLock lock;
+    SDL_Job **jobs; // A ring of jobs, the oldest is at `head`
+    int head;
+    int count;
+    int size;
+} SDL_JobQueue;
+
+typedef struct SDL_ThreadPoolWorker
+{
+    SDL_ThreadPool *pool;
+    SDL_Thread *thread;
+    int index;
+    SDL_JobQueue queue;
+
+    // Padding to keep the workers' queues on separate cache lines
+    char cache_pad[SDL_CACHELINE_SIZE];
+} SDL_ThreadPoolWorker;
+
+struct SDL_ThreadPool
+{
+    SDL_ThreadPoolWorker *workers;
+    int num_workers;
+    SDL_AtomicInt queued;     // Jobs that are queued and haven't been taken yet
+    SDL_AtomicInt sleeping;   // Threads that are waiting on `cond`
+    SDL_AtomicInt next_queue; // The next queue to submit to from outside the pool
+    SDL_AtomicInt active;
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    SDL_SpinLock free_lock;
+    SDL_Job *free_jobs;
+};
+
+struct SDL_JobGroup
+{
+    SDL_ThreadPool *pool;
+    SDL_AtomicInt remaining;
+};
+
+typedef struct SDL_ParallelForState
+{
+    SDL_ParallelForFunction func;
+    void *userdata;
+    int count;
+    int grain;
+    SDL_AtomicInt next;
+} SDL_ParallelForState;
+
+static SDL_TLSID SDL_current_worker;
+static SDL_InitState SDL_shared_pool_init;
+static SDL_ThreadPool *SDL_shared_pool;
+
+static bool SDL_PushJob(SDL_JobQueue *queue, SDL_Job *job)
+{
+    bool result = true;
+
+    SDL_LockSpinlock(&queue->lock);
+    if (queue->count == queue->size) {
+        const int size = queue->size ? (queue->size * 2) : 64;
+        SDL_Job **jobs = (SDL_Job **)SDL_malloc(size * sizeof(*jobs));
+        if (jobs) {
+            int i;
+            for (i = 0; i < queue->count; ++i) {
+                jobs[i] = queue->jobs[(queue->head + i) % queue->size];
+            }
+            SDL_free(queue->jobs);
+            queue->jobs = jobs;
+            queue->head = 0;
+            queue->size = size;
+        } else {
+            result = false;
+        }
+    }
+    if (result) {
+        queue->jobs[(queue->head + queue->count) % queue->size] = job;
+        ++queue->count;
+    }
+    SDL_UnlockSpinlock(&queue->lock);
+
+    return result;
+}
+
+// Take the newest job, for the queue's own worker
+static SDL_Job *SDL_PopJob(SDL_JobQueue *queue)
+{
+    SDL_Job *job = NULL;
+
+    SDL_LockSpinlock(&queue->lock);
+    if (queue->count > 0) {
+        --queue->count;
+        job = queue->jobs[(queue->head + queue->count) % queue->size];
+    }
+    SDL_UnlockSpinlock(&queue->lock);
+
+    return job;
+}
+
+// Take the oldest job, for any other thread
+static SDL_Job *SDL_StealJob(SDL_JobQueue *queue)
+{
+    SDL_Job *job = NULL;
+
+    SDL_LockSpinlock(&queue->lock);
+    if (queue->count > 0) {
+        job = queue->jobs[queue->head];
+        queue->head = (queue->head + 1) % queue->size;
+        --queue->count;
+    }
+    SDL_UnlockSpinlock(&queue->lock);
+
+    return job;
+}
+
+static SDL_ThreadPoolWorker *SDL_GetCurrentWorker(SDL_ThreadPool *pool)
+{
+    SDL_ThreadPoolWorker *worker = (SDL_ThreadPoolWorker *)SDL_GetTLS(&SDL_current_worker);
+    if (worker && worker->pool == pool) {
+        return worker;
+    }
+    return NULL;
+}
+
+static SDL_Job *SDL_TakeJob(SDL_ThreadPool *pool, SDL_ThreadPoolWorker *self)
+{
+    SDL_Job *job = NULL;
+    int i, start;
+
+    if (SDL_GetAtomicInt(&pool->queued) <= 0) {
+        return NULL;
+    }
+
+    if (self) {
+        job = SDL_PopJob(&self->queue);
+        start = self->index + 1;
+    } else {
+        start = SDL_GetAtomicInt(&pool->next_queue);
+    }
+    for (i = 0; !job && i < pool->num_workers; ++i) {
+        SDL_ThreadPoolWorker *victim = &pool->workers[(start + i) % pool->num_workers];
+        if (victim != self) {
+            job = SDL_StealJob(&victim->queue);
+        }
+    }
+    if (job) {
+        SDL_AddAtomicInt(&pool->queued, -1);
+    }
+    return job;
+}
+
+static void SDL_FinishJob(SDL_ThreadPool *pool, SDL_JobGroup *group)
+{
+    // The group may be destroyed as soon as it's done, so don't touch it after this
+    if (SDL_AddAtomicInt(&group->remaining, -1) == 1) {
+        SDL_LockMutex(pool->lock);
+        SDL_BroadcastCondition(pool->cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+static void SDL_RunJob(SDL_ThreadPool *pool, SDL_Job *job)
+{
+    SDL_JobGroup *group = job->group;
+
+    job->func(job->userdata);
+
+    SDL_LockSpinlock(&pool->free_lock);
+    job->next = pool->free_jobs;
+    pool->free_jobs = job;
+    SDL_UnlockSpinlock(&pool->free_lock);
+
+    SDL_FinishJob(pool, group);
+}
+
+static int SDLCALL SDL_ThreadPoolWorkerThread(void *data)
+{
+    SDL_ThreadPoolWorker *worker = (SDL_ThreadPoolWorker *)data;
+    SDL_ThreadPool *pool = worker->pool;
+    SDL_Job *job;
+    bool active;
+
+    SDL_SetTLS(&SDL_current_worker, worker, NULL);
+
+    for (;;) {
+        job = SDL_TakeJob(pool, worker);
+        if (job) {
+            SDL_RunJob(pool, job);
+            continue;
+        }
+
+        // Go to sleep until there's more work, finishing any queued jobs before quitting
+        SDL_LockMutex(pool->lock);
+        SDL_AddAtomicInt(&pool->sleeping, 1);
+        active = SDL_GetAtomicInt(&pool->active) != 0;
+        if (active && SDL_GetAtomicInt(&pool->queued) <= 0) {
+            SDL_WaitCondition(pool->cond, pool->lock);
+        }
+        SDL_AddAtomicInt(&pool->sleeping, -1);
+        SDL_UnlockMutex(pool->lock);
+
+        if (!active && SDL_GetAtomicInt(&pool->queued) <= 0) {
+            break;
+        }
+    }
+    return 0;
+}
+
+SDL_ThreadPool *SDL_CreateThreadPool(int num_threads)
+{
+    SDL_ThreadPool *pool;
+    int i;
+
+    CHECK_PARAM(num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+
+#ifdef SDL_THREADS_DISABLED
+    // Jobs are run as they're submitted
+    num_threads = 0;
+#else
+    if (num_threads == 0) {
+        num_threads = SDL_GetNumLogicalCPUCores();
+    }
+#endif
+
+    pool = (SDL_ThreadPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+    SDL_SetAtomicInt(&pool->active, 1);
+
+    if (num_threads > 0) {
+        pool->lock = SDL_CreateMutex();
+        pool->cond = SDL_CreateCondition();
+        pool->workers = (SDL_ThreadPoolWorker *)SDL_calloc(num_threads, sizeof(*pool->workers));
+        if (!pool->lock || !pool->cond || !pool->workers) {
+            SDL_DestroyThreadPool(pool);
+            return NULL;
+        }
+
+        for (i = 0; i < num_threads; ++i) {
+            SDL_ThreadPoolWorker *worker = &pool->workers[i];
+            worker->pool = pool;
+            worker->index = i;
+        }
+
+        // Jobs use a callback into the app, so we can't set a limited stack size here.
+        for (i = 0; i < num_threads; ++i) {
+            SDL_ThreadPoolWorker *worker = &pool->workers[i];
+            worker->thread = SDL_CreateThread(SDL_ThreadPoolWorkerThread, "SDLWorker", worker);
+            if (!worker->thread) {
+                SDL_DestroyThreadPool(pool);
+                return NULL;
+            }
+            ++pool->num_workers;
+        }
+    }
+    return pool;
+}
+
+void SDL_DestroyThreadPool(SDL_ThreadPool *pool)
+{
+    SDL_Job *job;
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_LockMutex(pool->lock);
+    SDL_SetAtomicInt(&pool->active, 0);
+    SDL_BroadcastCondition(pool->cond);
+    SDL_UnlockMutex(pool->lock);
+
+    for (i = 0; i < pool->num_workers; ++i) {
+        SDL_WaitThread(pool->workers[i].thread, NULL);
+    }
+    if (pool->workers) {
+        for (i = 0; i < pool->num_workers; ++i) {
+            SDL_assert(pool->workers[i].queue.count == 0);
+            SDL_free(pool->workers[i].queue.jobs);
+        }
+        SDL_free(pool->workers);
+    }
+
+    while (pool->free_jobs) {
+        job = pool->free_jobs;
+        pool->free_jobs = job->next;
+        SDL_free(job);
+    }
+
+    SDL_DestroyCondition(pool->cond);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool);
+}
+
+static SDL_ThreadPool *SDL_GetSharedThreadPool(void)
+{
+    if (SDL_ShouldInit(&SDL_shared_pool_init)) {
+        SDL_shared_pool = SDL_CreateThreadPool(0);
+        SDL_SetInitialized(&SDL_shared_pool_init, (SDL_shared_pool != NULL));
+    }
+    if (!SDL_shared_pool) {
+        SDL_SetError("Couldn't create the shared thread pool");
+    }
+    return SDL_shared_pool;
+}
+
+void SDL_QuitThreadPools(void)
+{
+    if (!SDL_ShouldQuit(&SDL_shared_pool_init)) {
+        return;
+    }
+
+    SDL_DestroyThreadPool(SDL_shared_pool);
+    SDL_shared_pool = NULL;
+
+    SDL_SetInitialized(&SDL_shared_pool_init, false);
+}
+
+SDL_JobGroup *SDL_CreateJobGroup(SDL_ThreadPool *pool)
+{
+    SDL_JobGroup *group;
+
+    if (!pool) {
+        pool = SDL_GetSharedThreadPool();
+        if (!pool) {
+            return NULL;
+        }
+    }
+
+    group = (SDL_JobGroup *)SDL_calloc(1, sizeof(*group));
+    if (!group) {
+        return NULL;
+    }
+    group->pool = pool;
+    return group;
+}
+
+bool SDL_SubmitJob(SDL_JobGroup *group, SDL_JobFunction func, void *userdata)
+{
+    SDL_ThreadPool *pool;
+    SDL_ThreadPoolWorker *worker;
+    SDL_JobQueue *queue;
+    SDL_Job *job;
+
+    CHECK_PARAM(!group) {
+        return SDL_InvalidParamError("group");
+    }
+    CHECK_PARAM(!func) {
+        return SDL_InvalidParamError("func");
+    }
+
+    pool = group->pool;
+    if (pool->num_workers == 0) {
+        func(userdata);
+        return true;
+    }
+
+    SDL_LockSpinlock(&pool->free_lock);
+    job = pool->free_jobs;
+    if (job) {
+        pool->free_jobs = job->next;
+    }
+    SDL_UnlockSpinlock(&pool->free_lock);
+
+    if (!job) {
+        job = (SDL_Job *)SDL_malloc(sizeof(*job));
+        if (!job) {
+            return false;
+        }
+    }
+    job->func = func;
+    job->userdata = userdata;
+    job->group = group;
+
+    worker = SDL_GetCurrentWorker(pool);
+    if (worker) {
+        queue = &worker->queue;
+    } else {
+        const int index = (int)((unsigned int)SDL_AddAtomicInt(&pool->next_queue, 1) % (unsigned int)pool->num_workers);
+        queue = &pool->workers[index].queue;
+    }
+
+    SDL_AddAtomicInt(&group->remaining, 1);
+    if (!SDL_PushJob(queue, job)) {
+        SDL_free(job);
+        SDL_FinishJob(pool, group);
+        return false;
+    }
+    SDL_AddAtomicInt(&pool->queued, 1);
+
+    if (SDL_GetAtomicInt(&pool->sleeping) > 0) {
+        SDL_LockMutex(pool->lock);
+        SDL_SignalCondition(pool->cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+    return true;
+}
+
+void SDL_WaitJobGroup(SDL_JobGroup *group)
+{
+    SDL_ThreadPool *pool;
+    SDL_ThreadPoolWorker *worker;
+    SDL_Job *job;
+
+    if (!group) {
+        return;
+    }
+
+    pool = group->pool;
+    worker = SDL_GetCurrentWorker(pool);
+    while (SDL_GetAtomicInt(&group->remaining) > 0) {
+        // Help out while we wait
+        job = SDL_TakeJob(pool, worker);
+        if (job) {
+            SDL_RunJob(pool, job);
+            continue;
+        }
+
+        SDL_LockMutex(pool->lock);
+        SDL_AddAtomicInt(&pool->sleeping, 1);
+        if (SDL_GetAtomicInt(&group->remaining) > 0 && SDL_GetAtomicInt(&pool->queued) <= 0) {
+            SDL_WaitCondition(pool->cond, pool->lock);
+        }
+        SDL_AddAtomicInt(&pool->sleeping, -1);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+void SDL_DestroyJobGroup(SDL_JobGroup *group)
+{
+    if (!group) {
+        return;
+    }
+
+    SDL_WaitJobGroup(group);
+    SDL_free(group);
+}
+
+static void SDLCALL SDL_RunParallelFor(void *data)
+{
+    SDL_ParallelForState *state = (SDL_ParallelForState *)data;
+    int start, end;
+
+    for (;;) {
+        start = SDL_GetAtomicInt(&state->next);
+        if (start >= state->count) {
+            break;
+        }
+        end = (state->count - start > state->grain) ? (start + state->grain) : state->count;
+        if (SDL_CompareAndSwapAtomicInt(&state->next, start, end)) {
+            state->func(state->userdata, start, end);
+        }
+    }
+}
+
+bool SDL_ParallelFor(SDL_ThreadPool *pool, int count, int grain, SDL_ParallelForFunction func, void *userdata)
+{
+    SDL_ParallelForState state;
+    SDL_JobGroup group;
+    int i, num_jobs;
+
+    CHECK_PARAM(count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    CHECK_PARAM(grain < 0) {
+        return SDL_InvalidParamError("grain");
+    }
+    CHECK_PARAM(!func) {
+        return SDL_InvalidParamError("func");
+    }
+
+    if (count == 0) {
+        return true;
+    }
+
+    if (!pool) {
+        pool = SDL_GetSharedThreadPool();
+        if (!pool) {
+            return false;
+        }
+    }
+
+    if (grain == 0) {
+        // Split the work into a few pieces per thread, so they can even out
+        grain = SDL_max(count / ((pool->num_workers + 1) * 4), 1);
+    }
+
+    state.func = func;
+    state.userdata = userdata;
+    state.count = count;
+    state.grain = grain;
+    SDL_SetAtomicInt(&state.next, 0);
+
+    group.pool = pool;
+    SDL_SetAtomicInt(&group.remaining, 0);
+
+    // The calling thread takes a share of the work too
+    num_jobs = SDL_min(pool->num_workers, (count / grain) + ((count % grain) ? 1 : 0) - 1);
+    for (i = 0; i < num_jobs; ++i) {
+        if (!SDL_SubmitJob(&group, SDL_RunParallelFor, &state)) {
+            break;
+        }
+    }
+    SDL_RunParallelFor(&state);
+    SDL_WaitJobGroup(&group);
+
+    return true;
+}
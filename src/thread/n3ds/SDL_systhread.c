@@ -118,6 +118,11 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority sdl_priority)
     return true;
 }
 
+bool SDL_SYS_SetThreadAffinity(const int *cpus, int num_cpus)
+{
+    return SDL_Unsupported();
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     Result res = threadJoin(thread->handle, U64_MAX);
@@ -32,6 +32,7 @@
 #include <errno.h>
 
 #ifdef SDL_PLATFORM_LINUX
+#include <sched.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sys/syscall.h>
@@ -282,6 +283,28 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
 #endif // #if SDL_PLATFORM_RISCOS
 }
 
+bool SDL_SYS_SetThreadAffinity(const int *cpus, int num_cpus)
+{
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+    cpu_set_t set;
+    int i;
+
+    CPU_ZERO(&set);
+    for (i = 0; i < num_cpus; ++i) {
+        if (cpus[i] >= CPU_SETSIZE) {
+            return SDL_SetError("CPU %d is out of range", cpus[i]);
+        }
+        CPU_SET(cpus[i], &set);
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+        return SDL_SetError("sched_setaffinity() failed: %s", strerror(errno));
+    }
+    return true;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     pthread_join(thread->handle, 0);
@@ -183,6 +183,23 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
     return true;
 }
 
+bool SDL_SYS_SetThreadAffinity(const int *cpus, int num_cpus)
+{
+    DWORD_PTR mask = 0;
+    int i;
+
+    for (i = 0; i < num_cpus; ++i) {
+        if (cpus[i] >= (int)(sizeof(mask) * 8)) {
+            return SDL_SetError("CPU %d is out of range", cpus[i]);
+        }
+        mask |= ((DWORD_PTR)1) << cpus[i];
+    }
+    if (!SetThreadAffinityMask(GetCurrentThread(), mask)) {
+        return WIN_SetError("SetThreadAffinityMask()");
+    }
+    return true;
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     WaitForSingleObjectEx(thread->handle, INFINITE, FALSE);
@@ -21,6 +21,8 @@
 #include "SDL_internal.h"
 
 #include "SDL_timer_c.h"
+#include "../SDL_hashtable.h"
+#include "../SDL_mempool.h"
 #include "../thread/SDL_systhread.h"
 
 // #define DEBUG_TIMERS
@@ -35,24 +37,19 @@ typedef struct SDL_Timer
     void *userdata;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 sequence; // Timers scheduled for the same time run in the order they were queued
+    Uint64 dispatched; // When the timer was handed to a worker thread
     SDL_AtomicInt canceled;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    SDL_TimerID timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-// The timers are kept in a sorted list
+// The timers are kept in a binary heap, ordered by scheduling time
 typedef struct
 {
     // Data used by the main thread
     SDL_InitState init;
     SDL_Thread *thread;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap; // Maps timer IDs to timers, protected by timermap_lock
     SDL_Mutex *timermap_lock;
 
     // Padding to separate cache lines between threads
@@ -62,11 +59,24 @@ typedef struct
     SDL_SpinLock lock;
     SDL_Semaphore *sem;
     SDL_Timer *pending;
-    SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    // List of timers - this is only touched by the timer thread
-    SDL_Timer *timers;
+    // Timer structures are allocated from any thread and freed by the timer and worker threads
+    SDL_MemoryPool timer_pool;
+
+    // Timers waiting for a worker thread to run their callback, see SDL_HINT_TIMER_WORKER_THREADS
+    SDL_Thread **workers;
+    int num_workers;
+    SDL_Mutex *ready_lock;
+    SDL_Condition *ready_cond;
+    SDL_Timer *ready_head;
+    SDL_Timer *ready_tail;
+
+    // Heap of timers - this is only touched by the timer thread
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint64 sequence;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -77,24 +87,158 @@ static SDL_TimerData SDL_timer_data;
  * Timers are removed by simply setting a canceled flag
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+// Free a timer that won't run again -- called without the data lock held
+static void SDL_ReleaseTimer(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    const SDL_Timer *mapped = NULL;
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+    // Once the timer is out of the map, SDL_RemoveTimer() can't reach it anymore
+    SDL_LockMutex(data->timermap_lock);
+    if (SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, (const void **)&mapped) && mapped == timer) {
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID);
+    }
+    SDL_UnlockMutex(data->timermap_lock);
+
+    SDL_FreeMemoryPoolBlock(&data->timer_pool, timer);
+}
+
+static bool SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
+{
+    if (a->scheduled != b->scheduled) {
+        return a->scheduled < b->scheduled;
+    }
+    return a->sequence < b->sequence;
+}
+
+static bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    int i;
+
+    if (data->num_timers == data->max_timers) {
+        const int max_timers = data->max_timers ? (data->max_timers * 2) : 64;
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return false;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    timer->sequence = data->sequence++;
+
+    // Sift the new timer up from the bottom of the heap
+    i = data->num_timers++;
+    while (i > 0) {
+        const int parent = (i - 1) / 2;
+        if (!SDL_TimerBefore(timer, data->timers[parent])) {
             break;
         }
+        data->timers[i] = data->timers[parent];
+        i = parent;
     }
+    data->timers[i] = timer;
+    return true;
+}
 
-    // Insert the timer here!
-    if (prev) {
-        prev->next = timer;
+static SDL_Timer *SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer *first = data->timers[0];
+    SDL_Timer *last = data->timers[--data->num_timers];
+    const int count = data->num_timers;
+    int i = 0;
+
+    // Sift the last timer down from the top of the heap
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && SDL_TimerBefore(data->timers[child + 1], data->timers[child])) {
+            ++child;
+        }
+        if (!SDL_TimerBefore(data->timers[child], last)) {
+            break;
+        }
+        data->timers[i] = data->timers[child];
+        i = child;
+    }
+    if (count > 0) {
+        data->timers[i] = last;
+    }
+    return first;
+}
+
+static Uint64 SDL_CallTimer(SDL_Timer *timer)
+{
+    if (timer->callback_ms) {
+        return SDL_MS_TO_NS(timer->callback_ms(timer->userdata, timer->timerID, (Uint32)SDL_NS_TO_MS(timer->interval)));
+    } else {
+        return timer->callback_ns(timer->userdata, timer->timerID, timer->interval);
+    }
+}
+
+/* When there are worker threads, the timer thread hands them timers that are
+ * due and carries on scheduling. A timer is out of the heap until its worker
+ * hands it back through the pending list, so it never runs concurrently with
+ * itself.
+ */
+static void SDL_DispatchTimer(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_LockMutex(data->ready_lock);
+    timer->next = NULL;
+    if (data->ready_tail) {
+        data->ready_tail->next = timer;
     } else {
-        data->timers = timer;
+        data->ready_head = timer;
     }
-    timer->next = curr;
+    data->ready_tail = timer;
+    SDL_SignalCondition(data->ready_cond);
+    SDL_UnlockMutex(data->ready_lock);
+}
+
+static int SDLCALL SDL_TimerWorkerThread(void *_data)
+{
+    SDL_TimerData *data = (SDL_TimerData *)_data;
+    SDL_Timer *timer;
+    Uint64 interval;
+
+    for (;;) {
+        SDL_LockMutex(data->ready_lock);
+        while (!data->ready_head && SDL_GetAtomicInt(&data->active)) {
+            SDL_WaitCondition(data->ready_cond, data->ready_lock);
+        }
+        if (!SDL_GetAtomicInt(&data->active)) {
+            SDL_UnlockMutex(data->ready_lock);
+            break;
+        }
+        timer = data->ready_head;
+        data->ready_head = timer->next;
+        if (!data->ready_head) {
+            data->ready_tail = NULL;
+        }
+        SDL_UnlockMutex(data->ready_lock);
+
+        if (SDL_GetAtomicInt(&timer->canceled)) {
+            interval = 0;
+        } else {
+            interval = SDL_CallTimer(timer);
+        }
+
+        if (interval > 0) {
+            // Hand the timer back to the timer thread to reschedule it
+            SDL_LockSpinlock(&data->lock);
+            timer->interval = interval;
+            timer->scheduled = timer->dispatched + interval;
+            timer->next = data->pending;
+            data->pending = timer;
+            SDL_UnlockSpinlock(&data->lock);
+
+            SDL_SignalSemaphore(data->sem);
+        } else {
+            SDL_ReleaseTimer(data, timer);
+        }
+    }
+    return 0;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -102,8 +246,6 @@ static int SDLCALL SDL_TimerThread(void *_data)
     SDL_TimerData *data = (SDL_TimerData *)_data;
     SDL_Timer *pending;
     SDL_Timer *current;
-    SDL_Timer *freelist_head = NULL;
-    SDL_Timer *freelist_tail = NULL;
     Uint64 tick, now, interval, delay;
 
     /* Threaded timer loop:
@@ -112,78 +254,76 @@ static int SDLCALL SDL_TimerThread(void *_data)
      *  3. Wait until next dispatch time or new timer arrives
      */
     for (;;) {
-        // Pending and freelist maintenance
+        // Get any timers ready to be queued
         SDL_LockSpinlock(&data->lock);
-        {
-            // Get any timers ready to be queued
-            pending = data->pending;
-            data->pending = NULL;
-
-            // Make any unused timer structures available
-            if (freelist_head) {
-                freelist_tail->next = data->freelist;
-                data->freelist = freelist_head;
-            }
-        }
+        pending = data->pending;
+        data->pending = NULL;
         SDL_UnlockSpinlock(&data->lock);
 
-        // Sort the pending timers into our list
+        // Sort the pending timers into our heap
         while (pending) {
             current = pending;
+            if (!SDL_AddTimerInternal(data, current)) {
+                break;
+            }
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
         }
-        freelist_head = NULL;
-        freelist_tail = NULL;
 
         // Check to see if we're still running, after maintenance
         if (!SDL_GetAtomicInt(&data->active)) {
             break;
         }
 
-        // Initial delay if there are no timers
-        delay = (Uint64)-1;
+        if (pending) {
+            // We're out of memory, try again in a bit
+            SDL_LockSpinlock(&data->lock);
+            {
+                current = pending;
+                while (current->next) {
+                    current = current->next;
+                }
+                current->next = data->pending;
+                data->pending = pending;
+            }
+            SDL_UnlockSpinlock(&data->lock);
+            delay = SDL_MS_TO_NS(1);
+        } else {
+            // Initial delay if there are no timers
+            delay = (Uint64)-1;
+        }
 
         tick = SDL_GetTicksNS();
 
         // Process all the pending timers for this tick
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
             if (tick < current->scheduled) {
                 // Scheduled for the future, wait a bit
-                delay = (current->scheduled - tick);
+                delay = SDL_min(delay, current->scheduled - tick);
                 break;
             }
 
             // We're going to do something with this timer
-            data->timers = current->next;
+            SDL_RemoveFirstTimer(data);
 
             if (SDL_GetAtomicInt(&current->canceled)) {
                 interval = 0;
+            } else if (data->num_workers > 0) {
+                current->dispatched = tick;
+                SDL_DispatchTimer(data, current);
+                continue;
             } else {
-                if (current->callback_ms) {
-                    interval = SDL_MS_TO_NS(current->callback_ms(current->userdata, current->timerID, (Uint32)SDL_NS_TO_MS(current->interval)));
-                } else {
-                    interval = current->callback_ns(current->userdata, current->timerID, current->interval);
-                }
+                interval = SDL_CallTimer(current);
             }
 
             if (interval > 0) {
-                // Reschedule this timer
+                // Reschedule this timer, there's room in the heap since we just took it out
                 current->interval = interval;
                 current->scheduled = tick + interval;
                 SDL_AddTimerInternal(data, current);
             } else {
-                if (!freelist_head) {
-                    freelist_head = current;
-                }
-                if (freelist_tail) {
-                    freelist_tail->next = current;
-                }
-                freelist_tail = current;
-
-                SDL_SetAtomicInt(&current->canceled, 1);
+                SDL_ReleaseTimer(data, current);
             }
         }
 
@@ -209,6 +349,8 @@ static int SDLCALL SDL_TimerThread(void *_data)
 bool SDL_InitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
+    const char *hint;
+    int i, num_workers = 0;
 
     if (!SDL_ShouldInit(&data->init)) {
         return true;
@@ -219,13 +361,49 @@ bool SDL_InitTimers(void)
         goto error;
     }
 
+    data->timermap = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    if (!data->timermap) {
+        goto error;
+    }
+
     data->sem = SDL_CreateSemaphore(0);
     if (!data->sem) {
         goto error;
     }
 
+    SDL_InitMemoryPool(&data->timer_pool, sizeof(SDL_Timer), 64, true);
+
     SDL_SetAtomicInt(&data->active, true);
 
+    hint = SDL_GetHint(SDL_HINT_TIMER_WORKER_THREADS);
+    if (hint) {
+        num_workers = SDL_max(SDL_atoi(hint), 0);
+    }
+    if (num_workers > 0) {
+        data->ready_lock = SDL_CreateMutex();
+        if (!data->ready_lock) {
+            goto error;
+        }
+
+        data->ready_cond = SDL_CreateCondition();
+        if (!data->ready_cond) {
+            goto error;
+        }
+
+        data->workers = (SDL_Thread **)SDL_calloc(num_workers, sizeof(*data->workers));
+        if (!data->workers) {
+            goto error;
+        }
+
+        for (i = 0; i < num_workers; ++i) {
+            data->workers[i] = SDL_CreateThread(SDL_TimerWorkerThread, "SDLTimerWorker", data);
+            if (!data->workers[i]) {
+                goto error;
+            }
+            ++data->num_workers;
+        }
+    }
+
     // Timer threads use a callback into the app, so we can't set a limited stack size here.
     data->thread = SDL_CreateThread(SDL_TimerThread, "SDLTimer", data);
     if (!data->thread) {
@@ -245,7 +423,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (!SDL_ShouldQuit(&data->init)) {
         return;
@@ -260,26 +438,55 @@ void SDL_QuitTimers(void)
         data->thread = NULL;
     }
 
+    // Shutdown the worker threads, they may still hand timers back to the pending list
+    if (data->workers) {
+        SDL_LockMutex(data->ready_lock);
+        SDL_BroadcastCondition(data->ready_cond);
+        SDL_UnlockMutex(data->ready_lock);
+        for (i = 0; i < data->num_workers; ++i) {
+            SDL_WaitThread(data->workers[i], NULL);
+        }
+        SDL_free(data->workers);
+        data->workers = NULL;
+        data->num_workers = 0;
+    }
+    while (data->ready_head) {
+        timer = data->ready_head;
+        data->ready_head = timer->next;
+        SDL_FreeMemoryPoolBlock(&data->timer_pool, timer);
+    }
+    data->ready_tail = NULL;
+    if (data->ready_cond) {
+        SDL_DestroyCondition(data->ready_cond);
+        data->ready_cond = NULL;
+    }
+    if (data->ready_lock) {
+        SDL_DestroyMutex(data->ready_lock);
+        data->ready_lock = NULL;
+    }
+
     if (data->sem) {
         SDL_DestroySemaphore(data->sem);
         data->sem = NULL;
     }
 
     // Clean up the timer entries
-    while (data->timers) {
-        timer = data->timers;
-        data->timers = timer->next;
-        SDL_free(timer);
+    for (i = 0; i < data->num_timers; ++i) {
+        SDL_FreeMemoryPoolBlock(&data->timer_pool, data->timers[i]);
     }
-    while (data->freelist) {
-        timer = data->freelist;
-        data->freelist = timer->next;
-        SDL_free(timer);
+    SDL_free(data->timers);
+    data->timers = NULL;
+    data->num_timers = 0;
+    data->max_timers = 0;
+    while (data->pending) {
+        timer = data->pending;
+        data->pending = timer->next;
+        SDL_FreeMemoryPoolBlock(&data->timer_pool, timer);
     }
-    while (data->timermap) {
-        entry = data->timermap;
-        data->timermap = entry->next;
-        SDL_free(entry);
+    SDL_DestroyMemoryPool(&data->timer_pool);
+    if (data->timermap) {
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
     }
 
     if (data->timermap_lock) {
@@ -299,7 +506,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    bool added;
 
     CHECK_PARAM(!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
@@ -310,20 +517,9 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
         return 0;
     }
 
-    SDL_LockSpinlock(&data->lock);
-    timer = data->freelist;
-    if (timer) {
-        data->freelist = timer->next;
-    }
-    SDL_UnlockSpinlock(&data->lock);
-
-    if (timer) {
-        SDL_RemoveTimer(timer->timerID);
-    } else {
-        timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
-        if (!timer) {
-            return 0;
-        }
+    timer = (SDL_Timer *)SDL_AllocMemoryPoolBlock(&data->timer_pool);
+    if (!timer) {
+        return 0;
     }
     timer->timerID = SDL_GetNextObjectID();
     timer->callback_ms = callback_ms;
@@ -333,18 +529,13 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
     SDL_SetAtomicInt(&timer->canceled, 0);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        SDL_free(timer);
-        return 0;
-    }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
     SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
+    added = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer, false);
     SDL_UnlockMutex(data->timermap_lock);
+    if (!added) {
+        SDL_FreeMemoryPoolBlock(&data->timer_pool, timer);
+        return 0;
+    }
 
     // Add the timer to the pending list for the timer thread
     SDL_LockSpinlock(&data->lock);
@@ -355,7 +546,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     // Wake up the timer thread if necessary
     SDL_SignalSemaphore(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
 }
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
@@ -371,35 +562,25 @@ SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *
 bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_Timer *timer = NULL;
     bool canceled = false;
 
     CHECK_PARAM(!id) {
         return SDL_InvalidParamError("id");
     }
 
-    // Find the timer
+    /* Find the timer, and cancel it while holding the lock, since the timer
+       may be released as soon as it's no longer in the map. */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
+    if (data->timermap && SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, (const void **)&timer)) {
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
+        if (!SDL_GetAtomicInt(&timer->canceled)) {
+            SDL_SetAtomicInt(&timer->canceled, 1);
+            canceled = true;
         }
     }
     SDL_UnlockMutex(data->timermap_lock);
 
-    if (entry) {
-        if (!SDL_GetAtomicInt(&entry->timer->canceled)) {
-            SDL_SetAtomicInt(&entry->timer->canceled, 1);
-            canceled = true;
-        }
-        SDL_free(entry);
-    }
     if (canceled) {
         return true;
     } else {
@@ -200,7 +200,9 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
     left_pad_w_init = left_pad_w;                                                     \
     right_pad_w_init = right_pad_w;                                                   \
     dst_gap = dst_pitch - 4 * dst_w;                                                  \
-    middle_init = dst_w - left_pad_w - right_pad_w;
+    middle_init = dst_w - left_pad_w - right_pad_w;                                   \
+    fp_sum_h += (Sint64)row_start * fp_step_h;                                        \
+    dst = (Uint32 *)((Uint8 *)dst + (size_t)row_start * dst_pitch);
 
 #define BILINEAR___HEIGHT                                              \
     int index_h, frac_h0, frac_h1, middle;                             \
@@ -327,11 +329,11 @@ static SDL_INLINE void INTERPOL_BILINEAR(const Uint32 *s0, const Uint32 *s1, int
     INTERPOL(tmp, tmp + 1, frac_w0, frac_w1, dst);
 }
 
-static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = row_start; i < row_end; i++) {
 
         BILINEAR___HEIGHT
 
@@ -447,11 +449,11 @@ static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32
     *dst = _mm_cvtsi128_si32(e0);
 }
 
-static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = row_start; i < row_end; i++) {
         int nb_block2;
         __m128i v_frac_h0;
         __m128i v_frac_h1;
@@ -611,11 +613,11 @@ static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1
     *dst = vget_lane_u32(CAST_uint32x2_t e0, 0);
 }
 
-static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = row_start; i < row_end; i++) {
         int nb_block4;
         uint8x8_t v_frac_h0, v_frac_h1;
 
@@ -829,9 +831,54 @@ static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitc
 }
 #endif
 
+typedef bool (*SDL_StretchRowsFunction)(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end);
+
+typedef struct SDL_StretchRowsData
+{
+    SDL_StretchRowsFunction func;
+    const Uint32 *src;
+    int src_w, src_h, src_pitch;
+    Uint32 *dst;
+    int dst_w, dst_h, dst_pitch;
+} SDL_StretchRowsData;
+
+/* Large stretches are split into bands of about this many destination pixels,
+   which are scaled in parallel on the shared thread pool. */
+#define SDL_STRETCH_BAND_PIXELS (64 * 1024)
+
+static void SDLCALL SDL_StretchRowRange(void *userdata, int start, int end)
+{
+    const SDL_StretchRowsData *data = (const SDL_StretchRowsData *)userdata;
+
+    data->func(data->src, data->src_w, data->src_h, data->src_pitch, data->dst, data->dst_w, data->dst_h, data->dst_pitch, start, end);
+}
+
+static bool SDL_StretchRows(SDL_StretchRowsFunction func, const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+{
+    SDL_StretchRowsData data;
+    const int grain = SDL_max(SDL_STRETCH_BAND_PIXELS / dst_w, 1);
+
+    if (dst_h > grain && SDL_GetNumLogicalCPUCores() > 1) {
+        data.func = func;
+        data.src = src;
+        data.src_w = src_w;
+        data.src_h = src_h;
+        data.src_pitch = src_pitch;
+        data.dst = dst;
+        data.dst_w = dst_w;
+        data.dst_h = dst_h;
+        data.dst_pitch = dst_pitch;
+        if (SDL_ParallelFor(NULL, dst_h, grain, SDL_StretchRowRange, &data)) {
+            return true;
+        }
+        // The shared thread pool isn't available, scale everything on this thread
+    }
+    return func(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, 0, dst_h);
+}
+
 bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
 {
-    bool result = false;
+    SDL_StretchRowsFunction func = scale_mat;
     int src_w = srcrect->w;
     int src_h = srcrect->h;
     int dst_w = dstrect->w;
@@ -841,23 +888,20 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
     Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
 
+    // Pick the scaler here, the bands may be scaled on other threads
 #ifdef SDL_NEON_INTRINSICS
-    if (!result && hasNEON()) {
-        result = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (hasNEON()) {
+        func = scale_mat_NEON;
     }
 #endif
 
 #ifdef SDL_SSE2_INTRINSICS
-    if (!result && hasSSE2()) {
-        result = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (func == scale_mat && hasSSE2()) {
+        func = scale_mat_SSE;
     }
 #endif
 
-    if (!result) {
-        result = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
-    }
-
-    return result;
+    return SDL_StretchRows(func, src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
 }
 
 #define SDL_SCALE_NEAREST__START          \
@@ -870,7 +914,8 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     incy = ((Uint64)src_h << 16) / dst_h; \
     incx = ((Uint64)src_w << 16) / dst_w; \
     dst_gap = dst_pitch - bpp * dst_w;    \
-    posy = incy / 2;
+    posy = incy / 2 + incy * row_start;   \
+    dst = (Uint32 *)((Uint8 *)dst + (size_t)row_start * dst_pitch);
 
 #define SDL_SCALE_NEAREST__HEIGHT                                         \
     srcy = (posy >> 16);                                                  \
@@ -879,11 +924,11 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     posx = incx / 2;                                                      \
     n = dst_w;
 
-static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end)
 {
     Uint32 bpp = 1;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = row_start; i < row_end; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -898,11 +943,11 @@ static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end)
 {
     Uint32 bpp = 2;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = row_start; i < row_end; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint16 *src;
@@ -917,11 +962,11 @@ static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end)
 {
     Uint32 bpp = 3;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = row_start; i < row_end; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -938,11 +983,11 @@ static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int row_start, int row_end)
 {
     Uint32 bpp = 4;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = row_start; i < row_end; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint32 *src;
@@ -971,12 +1016,12 @@ bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *s, const SDL_Rect *srcrect,
     Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * dst_pitch);
 
     if (bpp == 4) {
-        return scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return SDL_StretchRows(scale_mat_nearest_4, src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
     } else if (bpp == 3) {
-        return scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return SDL_StretchRows(scale_mat_nearest_3, src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
     } else if (bpp == 2) {
-        return scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return SDL_StretchRows(scale_mat_nearest_2, src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
     } else {
-        return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return SDL_StretchRows(scale_mat_nearest_1, src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
     }
 }
@@ -5966,7 +5966,9 @@ bool SDL_ShowSimpleMessageBox(SDL_MessageBoxFlags flags, const char *title, cons
 
 bool SDL_ShouldAllowTopmost(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_WINDOW_ALLOW_TOPMOST, true);
+    static SDL_CachedHint allow_topmost = SDL_CACHED_HINT_INIT(SDL_HINT_WINDOW_ALLOW_TOPMOST);
+
+    return SDL_GetCachedHintBoolean(&allow_topmost, true);
 }
 
 bool SDL_ShowWindowSystemMenu(SDL_Window *window, int x, int y)
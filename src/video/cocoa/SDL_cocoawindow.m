@@ -30,6 +30,7 @@
 #include "../../events/SDL_touch_c.h"
 #include "../../events/SDL_windowevents_c.h"
 #include "../SDL_sysvideo.h"
+#include "../../SDL_hints_c.h"
 
 #include "SDL_cocoamouse.h"
 #include "SDL_cocoaopengl.h"
@@ -545,10 +546,13 @@ static void ScheduleContextUpdates(SDL_CocoaWindowData *data)
 #endif // SDL_VIDEO_OPENGL
 }
 
-// !!! FIXME: this should use a hint callback.
+static SDL_CachedHint ctrl_click_emulate_right_click = SDL_CACHED_HINT_INIT(SDL_HINT_MAC_CTRL_CLICK_EMULATE_RIGHT_CLICK);
+static SDL_CachedHint mouse_focus_clickthrough = SDL_CACHED_HINT_INIT(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH);
+static SDL_CachedHint mac_mouse_focus_clickthrough = SDL_CACHED_HINT_INIT("SDL_MAC_MOUSE_FOCUS_CLICKTHROUGH");
+
 static bool GetHintCtrlClickEmulateRightClick(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_MAC_CTRL_CLICK_EMULATE_RIGHT_CLICK, false);
+    return SDL_GetCachedHintBoolean(&ctrl_click_emulate_right_click, false);
 }
 
 static NSUInteger GetWindowWindowedStyle(SDL_Window *window)
@@ -2136,10 +2140,10 @@ static void Cocoa_SendMouseButtonClicks(SDL_Mouse *mouse, NSEvent *theEvent, SDL
 {
     if (_sdlWindow->flags & SDL_WINDOW_POPUP_MENU) {
         return YES;
-    } else if (SDL_GetHint(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH)) {
-        return SDL_GetHintBoolean(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+    } else if (SDL_IsCachedHintSet(&mouse_focus_clickthrough)) {
+        return SDL_GetCachedHintBoolean(&mouse_focus_clickthrough, false);
     } else {
-        return SDL_GetHintBoolean("SDL_MAC_MOUSE_FOCUS_CLICKTHROUGH", false);
+        return SDL_GetCachedHintBoolean(&mac_mouse_focus_clickthrough, false);
     }
 }
 
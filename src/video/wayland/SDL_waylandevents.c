@@ -24,11 +24,15 @@
 #ifdef SDL_VIDEO_DRIVER_WAYLAND
 
 #include "../../core/unix/SDL_poll.h"
+#ifdef SDL_PLATFORM_LINUX
+#include "../../core/linux/SDL_eventwait.h"
+#endif
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_scancode_tables_c.h"
 #include "../../events/SDL_keysym_to_keycode_c.h"
 #include "../../core/linux/SDL_system_theme.h"
 #include "../SDL_sysvideo.h"
+#include "../../SDL_hints_c.h"
 
 #include "SDL_waylandvideo.h"
 #include "SDL_waylandevents_c.h"
@@ -88,6 +92,8 @@
 // Focus clickthrough timeout
 #define WAYLAND_FOCUS_CLICK_TIMEOUT_NS SDL_MS_TO_NS(10)
 
+static SDL_CachedHint mouse_focus_clickthrough = SDL_CACHED_HINT_INIT(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH);
+
 // Scoped function declarations
 static void Wayland_SeatUpdateKeyboardGrab(SDL_WaylandSeat *seat);
 
@@ -473,7 +479,16 @@ int Wayland_WaitEventTimeout(SDL_VideoDevice *_this, Sint64 timeoutNS)
      * If the default queue is empty, it will prepare us for our SDL_IOReady() call. */
     if (WAYLAND_wl_display_prepare_read(d->display) == 0) {
         // Use SDL_IOR_NO_RETRY to ensure SIGINT will break us out of our wait
+#ifdef SDL_PLATFORM_LINUX
+        int err = SDL_EventWait_IOReady(WAYLAND_wl_display_get_fd(d->display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
+        if (err == SDL_EVENTWAIT_INPUT_READY) {
+            // Input from another device is ready, let the event core pump it
+            WAYLAND_wl_display_cancel_read(d->display);
+            return 1;
+        }
+#else
         int err = SDL_IOReady(WAYLAND_wl_display_get_fd(d->display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
+#endif
         if (err > 0) {
             // There are new events available to read
             WAYLAND_wl_display_read_events(d->display);
@@ -926,7 +941,7 @@ static void pointer_handle_button_common(SDL_WaylandSeat *seat, uint32_t serial,
         if (window->last_focus_event_time_ns) {
             if (state == WL_POINTER_BUTTON_STATE_PRESSED &&
                 (SDL_GetTicksNS() - window->last_focus_event_time_ns) < WAYLAND_FOCUS_CLICK_TIMEOUT_NS) {
-                ignore_click = !SDL_GetHintBoolean(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+                ignore_click = !SDL_GetCachedHintBoolean(&mouse_focus_clickthrough, false);
             }
 
             window->last_focus_event_time_ns = 0;
@@ -28,6 +28,7 @@
 #include "../../events/scancodes_windows.h"
 #include "../../main/SDL_main_callbacks.h"
 #include "../../core/windows/SDL_hid.h"
+#include "../../SDL_hints_c.h"
 
 // Dropfile support
 #include <shellapi.h>
@@ -233,10 +234,12 @@ static SDL_Scancode WindowsScanCodeToSDLScanCode(LPARAM lParam, WPARAM wParam, U
 }
 
 #if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+static SDL_CachedHint mouse_focus_clickthrough = SDL_CACHED_HINT_INIT(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH);
+
 static bool WIN_ShouldIgnoreFocusClick(SDL_WindowData *data)
 {
     return !SDL_WINDOW_IS_POPUP(data->window) &&
-           !SDL_GetHintBoolean(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+           !SDL_GetCachedHintBoolean(&mouse_focus_clickthrough, false);
 }
 
 static void WIN_CheckWParamMouseButton(Uint64 timestamp, bool bwParamMousePressed, Uint32 mouseFlags, bool bSwapButtons, SDL_WindowData *data, Uint8 button, SDL_MouseID mouseID)
@@ -394,9 +397,11 @@ static void WIN_UpdateFocus(SDL_Window *window, bool expect_focus, DWORD pos)
 }
 #endif // !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
 
+static SDL_CachedHint close_on_alt_f4 = SDL_CACHED_HINT_INIT(SDL_HINT_WINDOWS_CLOSE_ON_ALT_F4);
+
 static bool ShouldGenerateWindowCloseOnAltF4(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_WINDOWS_CLOSE_ON_ALT_F4, true);
+    return SDL_GetCachedHintBoolean(&close_on_alt_f4, true);
 }
 
 static bool ShouldClearWindowOnEraseBackground(SDL_WindowData *data)
@@ -41,7 +41,11 @@
 #include "../../events/SDL_mouse_c.h"
 #include "../../events/SDL_touch_c.h"
 #include "../../core/linux/SDL_system_theme.h"
+#ifdef SDL_PLATFORM_LINUX
+#include "../../core/linux/SDL_eventwait.h"
+#endif
 #include "../SDL_sysvideo.h"
+#include "../../SDL_hints_c.h"
 
 #include <stdio.h>
 
@@ -92,6 +96,8 @@ typedef struct
     Atom type;
 } SDL_x11Prop;
 
+static SDL_CachedHint mouse_focus_clickthrough = SDL_CACHED_HINT_INIT(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH);
+
 /* Reads property
    Must call X11_XFree on results
  */
@@ -1153,7 +1159,7 @@ void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, S
         if (windowdata->last_focus_event_time) {
             const int X11_FOCUS_CLICK_TIMEOUT = 10;
             if (SDL_GetTicks() < (windowdata->last_focus_event_time + X11_FOCUS_CLICK_TIMEOUT)) {
-                ignore_click = !SDL_GetHintBoolean(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+                ignore_click = !SDL_GetCachedHintBoolean(&mouse_focus_clickthrough, false);
             }
             windowdata->last_focus_event_time = 0;
         }
@@ -2240,7 +2246,15 @@ int X11_WaitEventTimeout(SDL_VideoDevice *_this, Sint64 timeoutNS)
         return 0;
     } else {
         // Use SDL_IOR_NO_RETRY to ensure SIGINT will break us out of our wait
+#ifdef SDL_PLATFORM_LINUX
+        int err = SDL_EventWait_IOReady(ConnectionNumber(display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
+        if (err == SDL_EVENTWAIT_INPUT_READY) {
+            // Input from another device is ready, let the event core pump it
+            return 1;
+        }
+#else
         int err = SDL_IOReady(ConnectionNumber(display), SDL_IOR_READ | SDL_IOR_NO_RETRY, timeoutNS);
+#endif
         if (err > 0) {
             if (!X11_PollEvent(display, &xevent)) {
                 /* Someone may have beat us to reading the fd. Return 1 here to
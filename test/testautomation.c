@@ -44,10 +44,12 @@ static SDLTest_TestSuiteReference *testSuites[] = {
     &sdltestTestSuite,
     &stdlibTestSuite,
     &surfaceTestSuite,
+    &threadpoolTestSuite,
     &timeTestSuite,
     &timerTestSuite,
     &videoTestSuite,
     &blitTestSuite,
+    &timerWorkersTestSuite, /* restarts SDL, run last */
     &subsystemsTestSuite, /* run last, not interfere with other test environment */
     NULL
 };
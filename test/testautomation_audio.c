@@ -1460,6 +1460,432 @@ cleanup:
 
     return status;
 }
+
+/**
+ * Check the statistics reported through audio stream and device properties.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ * \sa SDL_GetAudioDeviceProperties
+ */
+static int SDLCALL audio_streamAndDeviceStatistics(void *arg)
+{
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    SDL_PropertiesID props;
+    SDL_AudioDeviceID devid;
+    Uint8 buffer[1024];
+    int result;
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_S16;
+    spec.channels = 2;
+    spec.freq = 44100;
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertPass("Call to SDL_CreateAudioStream()");
+    if (!SDLTest_AssertCheck(stream != NULL, "Validate stream != NULL")) {
+        return TEST_ABORTED;
+    }
+
+    SDL_memset(buffer, 0, sizeof(buffer));
+    SDL_PutAudioStreamData(stream, buffer, sizeof(buffer));
+    SDL_PutAudioStreamData(stream, buffer, sizeof(buffer));
+    result = SDL_GetAudioStreamData(stream, buffer, sizeof(buffer));
+    SDLTest_AssertCheck(result == sizeof(buffer), "Expected SDL_GetAudioStreamData to return %d, got %d", (int)sizeof(buffer), result);
+    result = SDL_GetAudioStreamData(stream, buffer, sizeof(buffer));
+    SDLTest_AssertCheck(result == sizeof(buffer), "Expected SDL_GetAudioStreamData to return %d, got %d", (int)sizeof(buffer), result);
+    result = SDL_GetAudioStreamData(stream, buffer, sizeof(buffer));
+    SDLTest_AssertCheck(result == 0, "Expected SDL_GetAudioStreamData to return 0, got %d", result);
+
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertPass("Call to SDL_GetAudioStreamProperties()");
+    SDLTest_AssertCheck(props != 0, "Validate props != 0");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_NUMBER, -1) == 0, "Check queued bytes is 0");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_MAX_NUMBER, -1) == 2 * sizeof(buffer), "Check queued bytes max is %d", (int)(2 * sizeof(buffer)));
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_QUEUED_BYTES_AVERAGE_NUMBER, -1) == sizeof(buffer), "Check queued bytes average is %d", (int)sizeof(buffer));
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_GET_REQUESTS_NUMBER, -1) == 3, "Check get requests is 3");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_SHORT_READS_NUMBER, -1) == 1, "Check short reads is 1");
+    SDL_DestroyAudioStream(stream);
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice()");
+    if (devid == 0) {
+        SDLTest_Log("No playback device available, skipping device statistics: %s", SDL_GetError());
+        return TEST_COMPLETED;
+    }
+
+    props = SDL_GetAudioDeviceProperties(devid);
+    SDLTest_AssertPass("Call to SDL_GetAudioDeviceProperties()");
+    SDLTest_AssertCheck(props != 0, "Validate props != 0");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_BUFFER_PERIOD_NS_NUMBER, 0) > 0, "Check buffer period is positive");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_ITERATIONS_NUMBER, -1) >= 0, "Check iterations is reported");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_UNDERRUNS_NUMBER, -1) >= 0, "Check underruns is reported");
+    SDL_CloseAudioDevice(devid);
+
+    props = SDL_GetAudioDeviceProperties(0);
+    SDLTest_AssertCheck(props == 0, "Check SDL_GetAudioDeviceProperties(0) fails");
+
+    return TEST_COMPLETED;
+}
+
+
+static void write_le16(Uint8 *dst, Uint16 value)
+{
+    dst[0] = (Uint8)(value & 0xFF);
+    dst[1] = (Uint8)(value >> 8);
+}
+
+static void write_le32(Uint8 *dst, Uint32 value)
+{
+    write_le16(dst, (Uint16)(value & 0xFFFF));
+    write_le16(dst + 2, (Uint16)(value >> 16));
+}
+
+/* Builds a WAVE file in memory with random data. ADPCM blocks get valid headers. */
+static Uint8 *build_test_wave(Uint16 formattag, Uint16 channels, Uint16 bits, Uint16 blockalign, Uint16 samplesperblock, Uint32 datalen, size_t *len)
+{
+    const Sint16 mscoeffs[14] = { 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232 };
+    const Uint32 fmtlen = (formattag == 0x0002) ? 50 : ((formattag == 0x0011) ? 20 : 16);
+    const Uint32 total = 12 + 8 + fmtlen + 8 + datalen;
+    Uint8 *wave = (Uint8 *)SDL_calloc(1, total);
+    Uint8 *fmt, *data;
+    Uint32 i, c;
+
+    if (!wave) {
+        return NULL;
+    }
+
+    SDL_memcpy(wave, "RIFF", 4);
+    write_le32(wave + 4, total - 8);
+    SDL_memcpy(wave + 8, "WAVEfmt ", 8);
+    write_le32(wave + 16, fmtlen);
+    fmt = wave + 20;
+    write_le16(fmt, formattag);
+    write_le16(fmt + 2, channels);
+    write_le32(fmt + 4, 22050);
+    write_le32(fmt + 8, 22050 * blockalign);
+    write_le16(fmt + 12, blockalign);
+    write_le16(fmt + 14, bits);
+    if (formattag == 0x0002) {
+        write_le16(fmt + 16, 32);
+        write_le16(fmt + 18, samplesperblock);
+        write_le16(fmt + 20, 7);
+        for (i = 0; i < 14; i++) {
+            write_le16(fmt + 22 + i * 2, (Uint16)mscoeffs[i]);
+        }
+    } else if (formattag == 0x0011) {
+        write_le16(fmt + 16, 2);
+        write_le16(fmt + 18, samplesperblock);
+    }
+    SDL_memcpy(fmt + fmtlen, "data", 4);
+    write_le32(fmt + fmtlen + 4, datalen);
+    data = fmt + fmtlen + 8;
+
+    for (i = 0; i < datalen; i++) {
+        data[i] = SDLTest_RandomUint8();
+    }
+
+    /* Make the block headers sane. */
+    for (i = 0; (formattag == 0x0002 || formattag == 0x0011) && i < datalen; i += blockalign) {
+        for (c = 0; c < channels; c++) {
+            if (formattag == 0x0002 && i + channels * 7 <= datalen) {
+                data[i + c] = SDLTest_RandomUint8() % 7;
+            } else if (formattag == 0x0011 && i + c * 4 + 4 <= datalen) {
+                data[i + c * 4 + 2] = SDLTest_RandomUint8() % 89;
+                data[i + c * 4 + 3] = 0;
+            }
+        }
+    }
+
+    *len = total;
+    return wave;
+}
+
+/**
+ * Check that streaming WAVE decoding gives the same data as loading the whole file.
+ *
+ * \sa SDL_LoadWAVStream_IO
+ * \sa SDL_LoadWAV_IO
+ */
+static int SDLCALL audio_loadWAVStream(void *arg)
+{
+    static const struct
+    {
+        const char *name;
+        Uint16 formattag;
+        Uint16 channels;
+        Uint16 bits;
+        Uint16 blockalign;
+        Uint16 samplesperblock;
+        Uint32 datalen;
+    } waves[] = {
+        { "16-bit PCM", 0x0001, 2, 16, 4, 0, 4 * 10000 },
+        { "24-bit PCM", 0x0001, 2, 24, 6, 0, 6 * 10000 },
+        { "mu-law", 0x0007, 1, 8, 1, 0, 12345 },
+        { "MS ADPCM", 0x0002, 2, 4, 512, 500, 512 * 20 + 100 },
+        { "IMA ADPCM", 0x0011, 2, 4, 512, 505, 512 * 20 + 100 },
+        /* Big enough to be decoded on several threads by SDL_LoadWAV_IO */
+        { "large MS ADPCM", 0x0002, 2, 4, 512, 500, 512 * 4096 + 100 },
+        { "large IMA ADPCM", 0x0011, 1, 4, 256, 505, 256 * 8192 + 100 },
+    };
+    int i;
+
+    for (i = 0; i < (int)SDL_arraysize(waves); i++) {
+        SDL_AudioSpec spec, streamspec;
+        Uint8 *audio_buf = NULL;
+        Uint32 audio_len = 0;
+        Uint8 *streamed;
+        size_t wavelen = 0;
+        int total = 0;
+        bool result;
+        Uint8 *wave = build_test_wave(waves[i].formattag, waves[i].channels, waves[i].bits, waves[i].blockalign, waves[i].samplesperblock, waves[i].datalen, &wavelen);
+        SDL_AudioStream *stream;
+
+        if (!SDLTest_AssertCheck(wave != NULL, "Built %s test file", waves[i].name)) {
+            return TEST_ABORTED;
+        }
+
+        result = SDL_LoadWAV_IO(SDL_IOFromConstMem(wave, wavelen), true, &spec, &audio_buf, &audio_len);
+        SDLTest_AssertCheck(result, "SDL_LoadWAV_IO(%s): %s", waves[i].name, result ? "ok" : SDL_GetError());
+
+        stream = SDL_LoadWAVStream_IO(SDL_IOFromConstMem(wave, wavelen), true, &streamspec);
+        SDLTest_AssertCheck(stream != NULL, "SDL_LoadWAVStream_IO(%s): %s", waves[i].name, stream ? "ok" : SDL_GetError());
+        if (!result || !stream) {
+            SDL_free(audio_buf);
+            SDL_DestroyAudioStream(stream);
+            SDL_free(wave);
+            continue;
+        }
+
+        SDLTest_AssertCheck(SDL_memcmp(&spec, &streamspec, sizeof(spec)) == 0, "Check %s stream spec matches", waves[i].name);
+
+        streamed = (Uint8 *)SDL_malloc(audio_len + 1024);
+        if (streamed) {
+            int br;
+            do {
+                br = SDL_GetAudioStreamData(stream, streamed + total, SDL_min(1000, (int)audio_len + 1024 - total));
+                if (br > 0) {
+                    total += br;
+                }
+            } while (br > 0 && total < (int)audio_len + 1024);
+
+            SDLTest_AssertCheck(total == (int)audio_len, "Check %s streamed %d bytes, got %d", waves[i].name, (int)audio_len, total);
+            SDLTest_AssertCheck(total == (int)audio_len && SDL_memcmp(streamed, audio_buf, audio_len) == 0, "Check %s streamed data matches", waves[i].name);
+            SDL_free(streamed);
+        }
+
+        SDL_DestroyAudioStream(stream);
+        SDL_free(audio_buf);
+        SDL_free(wave);
+    }
+
+    SDLTest_AssertCheck(SDL_LoadWAVStream_IO(NULL, false, NULL) == NULL, "Check SDL_LoadWAVStream_IO(NULL) fails");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check the surround to stereo and stereo to surround channel conversions.
+ *
+ * \sa SDL_ConvertAudioSamples
+ */
+static int SDLCALL audio_convertSurroundChannels(void *arg)
+{
+    /* Front, center, LFE, then each of the back and side channels as (same side, other side). */
+    static const float mix51[] = { 0.294545442f, 0.208181813f, 0.090909094f, 0.251818180f, 0.154545456f };
+    static const float mix71[] = { 0.211866662f, 0.150266662f, 0.066666670f, 0.181066677f, 0.111066669f, 0.194133341f, 0.085866667f };
+    const int frame_counts[] = { 1, 2, 3, 1001 };
+    int i, f, c;
+
+    for (i = 0; i < (int)SDL_arraysize(frame_counts); i++) {
+        const int num_frames = frame_counts[i];
+        const int surround_channels[] = { 6, 8 };
+        int s;
+
+        for (s = 0; s < (int)SDL_arraysize(surround_channels); s++) {
+            const int channels = surround_channels[s];
+            const float *mix = (channels == 6) ? mix51 : mix71;
+            SDL_AudioSpec surround_spec, stereo_spec;
+            float *surround = (float *)SDL_malloc(num_frames * channels * sizeof(float));
+            float *stereo = (float *)SDL_malloc(num_frames * 2 * sizeof(float));
+            Uint8 *dst_data = NULL;
+            int dst_len = 0;
+            bool result;
+
+            if (!surround || !stereo) {
+                SDL_free(surround);
+                SDL_free(stereo);
+                return TEST_ABORTED;
+            }
+
+            surround_spec.format = SDL_AUDIO_F32;
+            surround_spec.channels = channels;
+            surround_spec.freq = 48000;
+            stereo_spec = surround_spec;
+            stereo_spec.channels = 2;
+
+            for (f = 0; f < num_frames * channels; f++) {
+                surround[f] = SDLTest_RandomSint16() / 32768.0f;
+            }
+            for (f = 0; f < num_frames * 2; f++) {
+                stereo[f] = SDLTest_RandomSint16() / 32768.0f;
+            }
+
+            /* Downmix */
+            result = SDL_ConvertAudioSamples(&surround_spec, (const Uint8 *)surround, num_frames * channels * (int)sizeof(float), &stereo_spec, &dst_data, &dst_len);
+            SDLTest_AssertCheck(result && dst_len == num_frames * 2 * (int)sizeof(float), "Check %d channels to stereo for %d frames", channels, num_frames);
+            if (result && dst_len == num_frames * 2 * (int)sizeof(float)) {
+                const float *out = (const float *)dst_data;
+                float max_diff = 0.0f;
+
+                for (f = 0; f < num_frames; f++) {
+                    const float *in = surround + f * channels;
+                    for (c = 0; c < 2; c++) {
+                        float expected = (in[c] * mix[0]) + (in[2] * mix[1]) + (in[3] * mix[2]) + (in[4 + c] * mix[3]) + (in[5 - c] * mix[4]);
+                        if (channels == 8) {
+                            expected += (in[6 + c] * mix[5]) + (in[7 - c] * mix[6]);
+                        }
+                        max_diff = SDL_max(max_diff, SDL_fabsf(out[f * 2 + c] - expected));
+                    }
+                }
+                SDLTest_AssertCheck(max_diff < 1e-6f, "Check %d channels to stereo mix, max difference %g", channels, max_diff);
+            }
+            SDL_free(dst_data);
+            dst_data = NULL;
+
+            /* Upmix */
+            result = SDL_ConvertAudioSamples(&stereo_spec, (const Uint8 *)stereo, num_frames * 2 * (int)sizeof(float), &surround_spec, &dst_data, &dst_len);
+            SDLTest_AssertCheck(result && dst_len == num_frames * channels * (int)sizeof(float), "Check stereo to %d channels for %d frames", channels, num_frames);
+            if (result && dst_len == num_frames * channels * (int)sizeof(float)) {
+                const float *out = (const float *)dst_data;
+                bool match = true;
+
+                for (f = 0; f < num_frames; f++) {
+                    for (c = 0; c < channels; c++) {
+                        const float expected = (c < 2) ? stereo[f * 2 + c] : 0.0f;
+                        if (out[f * channels + c] != expected) {
+                            match = false;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(match, "Check stereo to %d channels keeps front channels and silences the rest", channels);
+            }
+            SDL_free(dst_data);
+
+            SDL_free(surround);
+            SDL_free(stereo);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+static void SDLCALL disk_offline_callback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    Sint64 *provided = (Sint64 *)userdata;
+    Uint8 buf[1024];
+
+    SDL_memset(buf, 0x11, sizeof(buf));
+    while (additional_amount > 0) {
+        const int len = SDL_min(additional_amount, (int)sizeof(buf));
+        SDL_PutAudioStreamData(stream, buf, len);
+        additional_amount -= len;
+        *provided += len;
+    }
+}
+
+/**
+ * Check that the disk audio driver renders and records faster than real-time in offline mode.
+ *
+ * \sa SDL_HINT_AUDIO_DISK_OFFLINE
+ */
+static int SDLCALL audio_diskOffline(void *arg)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_S16, 2, 48000 };
+    const Sint64 ten_seconds = 10 * 48000 * 4;
+    const int input_len = 48000 * 4 * 5;
+    SDL_AudioStream *stream;
+    Sint64 provided = 0;
+    Uint8 *input;
+    Uint8 *recorded;
+    Uint64 start;
+    int i, total, init_count = 0;
+    bool result;
+
+    /* The audio subsystem may have been initialized more than once, fully shut it down to switch drivers. */
+    while (SDL_WasInit(SDL_INIT_AUDIO)) {
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        init_count++;
+    }
+    SDL_SetHintWithPriority(SDL_HINT_AUDIO_DRIVER, "disk", SDL_HINT_OVERRIDE);
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_OFFLINE, "1");
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_INPUT_FILE, "sdlaudio-in.raw");
+    result = SDL_InitSubSystem(SDL_INIT_AUDIO);
+    if (!result) {
+        SDLTest_Log("Disk audio driver not available, skipping: %s", SDL_GetError());
+    }
+
+    /* Playback: ten seconds of audio should be rendered well within five seconds. */
+    stream = result ? SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, disk_offline_callback, &provided) : NULL;
+    if (stream) {
+        SDL_ResumeAudioStreamDevice(stream);
+        start = SDL_GetTicks();
+        while (SDL_GetTicks() - start < 5000) {
+            SDL_LockAudioStream(stream);
+            if (provided >= ten_seconds) {
+                SDL_UnlockAudioStream(stream);
+                break;
+            }
+            SDL_UnlockAudioStream(stream);
+            SDL_Delay(10);
+        }
+        SDL_DestroyAudioStream(stream);
+        SDLTest_AssertCheck(provided >= ten_seconds, "Check offline playback rendered 10 seconds of audio in %d ms", (int)(SDL_GetTicks() - start));
+    }
+
+    /* Recording: the whole input file should arrive quickly, then the device goes away. */
+    input = (Uint8 *)SDL_malloc(input_len);
+    recorded = (Uint8 *)SDL_malloc(input_len + 1024);
+    if (result && input && recorded) {
+        for (i = 0; i < input_len; i++) {
+            input[i] = (Uint8)(i * 7);
+        }
+        SDL_SaveFile("sdlaudio-in.raw", input, input_len);
+
+        stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_RECORDING, &spec, NULL, NULL);
+        SDLTest_AssertCheck(stream != NULL, "Check opening offline recording device: %s", stream ? "ok" : SDL_GetError());
+        if (stream) {
+            total = 0;
+            SDL_ResumeAudioStreamDevice(stream);
+            start = SDL_GetTicks();
+            while (total < input_len && SDL_GetTicks() - start < 4000) {
+                const int br = SDL_GetAudioStreamData(stream, recorded + total, input_len + 1024 - total);
+                if (br > 0) {
+                    total += br;
+                } else {
+                    SDL_Delay(10);
+                }
+            }
+            SDL_DestroyAudioStream(stream);
+            SDLTest_AssertCheck(total == input_len, "Check offline recording read %d bytes, got %d", input_len, total);
+            SDLTest_AssertCheck(total == input_len && SDL_memcmp(input, recorded, input_len) == 0, "Check offline recording data matches the input file");
+        }
+        (void)remove("sdlaudio-in.raw");
+    }
+    SDL_free(input);
+    SDL_free(recorded);
+
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    SDL_ResetHint(SDL_HINT_AUDIO_DISK_OFFLINE);
+    SDL_ResetHint(SDL_HINT_AUDIO_DISK_INPUT_FILE);
+    SDL_ResetHint(SDL_HINT_AUDIO_DRIVER);
+    while (init_count--) {
+        audioSetUp(NULL);
+    }
+
+    return result ? TEST_COMPLETED : TEST_SKIPPED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1541,13 +1967,30 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_streamAndDeviceStatistics, "audio_streamAndDeviceStatistics", "Check audio stream and device statistics properties.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_loadWAVStream, "audio_loadWAVStream", "Check streaming WAVE decoding against loading the whole file.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_convertSurroundChannels, "audio_convertSurroundChannels", "Check surround to stereo and stereo to surround conversion.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest22 = {
+    audio_diskOffline, "audio_diskOffline", "Check offline rendering and recording with the disk audio driver.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTestGetAudioFormatName,
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20,
+    &audioTest21, &audioTest22, NULL
 };
 
 /* Audio test suite (global) */
@@ -3,6 +3,7 @@
  */
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_test.h>
+#include "testautomation_memory.h"
 #include "testautomation_suites.h"
 
 /* ================= Test Case Implementation ================== */
@@ -308,6 +309,642 @@ static int SDLCALL events_mainThreadCallbacks(void *arg)
     return TEST_COMPLETED;
 }
 
+#define PUSH_THREAD_COUNT  4
+#define PUSH_THREAD_EVENTS 5000
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+static int SDLCALL PushUserEventsThread(void *userdata)
+{
+    const Sint32 thread_index = (Sint32)(intptr_t)userdata;
+    SDL_Event event;
+    int i;
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    event.user.code = thread_index;
+    for (i = 0; i < PUSH_THREAD_EVENTS; ++i) {
+        event.user.data1 = (void *)(intptr_t)i;
+        while (!SDL_PushEvent(&event)) {
+            SDL_Delay(1); /* The queue is full, let the main thread catch up */
+        }
+    }
+    return 0;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+/**
+ * Test that events pushed from several threads all arrive, in order for each thread.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PeepEvents
+ */
+static int SDLCALL events_pushFromThreads(void *arg)
+{
+    SDL_Event events[64];
+    int next[PUSH_THREAD_COUNT];
+    int i, n, received = 0;
+    bool in_order = true;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    /* More events than fit in the queue's ring, from one thread, read back with a type filter */
+    SDL_zero(events[0]);
+    events[0].type = SDL_EVENT_USER;
+    for (i = 0; i < 3000; ++i) {
+        events[0].user.code = i;
+        SDL_PushEvent(&events[0]);
+    }
+    for (i = 0; i < 3000; ++i) {
+        n = SDL_PeepEvents(events, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+        if (n != 1 || events[0].user.code != i) {
+            in_order = false;
+            break;
+        }
+    }
+    SDLTest_AssertCheck(in_order, "Check 3000 events pushed on one thread come back in order");
+    SDLTest_AssertCheck(!SDL_HasEvent(SDL_EVENT_USER), "Check no user events are left");
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+    {
+        SDL_Thread *threads[PUSH_THREAD_COUNT];
+        const Uint64 start = SDL_GetTicks();
+
+        for (i = 0; i < PUSH_THREAD_COUNT; ++i) {
+            next[i] = 0;
+            threads[i] = SDL_CreateThread(PushUserEventsThread, "PushUserEvents", (void *)(intptr_t)i);
+            SDLTest_AssertCheck(threads[i] != NULL, "Create event pushing thread %d", i);
+        }
+
+        while (received < PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS && SDL_GetTicks() - start < 10000) {
+            /* Alternate between taking any event and filtering for user events */
+            if (received % 2) {
+                n = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+            } else {
+                n = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+            }
+            if (n <= 0) {
+                SDL_Delay(1);
+                continue;
+            }
+            for (i = 0; i < n; ++i) {
+                if (events[i].type == SDL_EVENT_USER && events[i].user.code >= 0 && events[i].user.code < PUSH_THREAD_COUNT) {
+                    const int thread_index = events[i].user.code;
+                    if ((int)(intptr_t)events[i].user.data1 != next[thread_index]) {
+                        in_order = false;
+                    }
+                    next[thread_index] = (int)(intptr_t)events[i].user.data1 + 1;
+                    ++received;
+                }
+            }
+        }
+
+        for (i = 0; i < PUSH_THREAD_COUNT; ++i) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+        SDLTest_AssertCheck(received == PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS, "Check all events arrived, expected %d, got %d", PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS, received);
+        SDLTest_AssertCheck(in_order, "Check the events of each thread arrived in order");
+    }
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test that filtering events by type keeps them in queue order.
+ *
+ * \sa SDL_HasEvent
+ * \sa SDL_PeepEvents
+ * \sa SDL_FlushEvent
+ */
+static int SDLCALL events_filterByType(void *arg)
+{
+    SDL_Event events[64];
+    int i, n, received, last;
+    bool in_order;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    /* Interleave four different user event types */
+    SDL_zero(events[0]);
+    for (i = 0; i < 2000; ++i) {
+        events[0].type = SDL_EVENT_USER + (i % 4);
+        events[0].user.code = i;
+        SDL_PushEvent(&events[0]);
+    }
+    SDLTest_AssertCheck(SDL_HasEvent(SDL_EVENT_USER + 2), "Check SDL_HasEvent() finds a queued type");
+    SDLTest_AssertCheck(!SDL_HasEvent(SDL_EVENT_USER + 4), "Check SDL_HasEvent() doesn't find a type that wasn't queued");
+    SDLTest_AssertCheck(!SDL_HasEvents(SDL_EVENT_FIRST, SDL_EVENT_USER - 1), "Check SDL_HasEvents() doesn't find types below the queued ones");
+
+    n = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_USER + 1, SDL_EVENT_USER + 2);
+    SDLTest_AssertCheck(n == 1000, "Count two of the types, expected 1000, got %d", n);
+
+    /* Take two of the types, they should come back merged in the order they were pushed */
+    received = 0;
+    last = -1;
+    in_order = true;
+    while ((n = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_USER + 1, SDL_EVENT_USER + 2)) > 0) {
+        for (i = 0; i < n; ++i) {
+            const int code = events[i].user.code;
+            if (code <= last || (code % 4) != (int)(events[i].type - SDL_EVENT_USER) || (code % 4) == 0 || (code % 4) == 3) {
+                in_order = false;
+            }
+            last = code;
+        }
+        received += n;
+    }
+    SDLTest_AssertCheck(received == 1000, "Check all events of two types were taken, expected 1000, got %d", received);
+    SDLTest_AssertCheck(in_order, "Check the events of two types were taken in order");
+
+    SDL_FlushEvent(SDL_EVENT_USER + 3);
+    SDLTest_AssertCheck(!SDL_HasEvent(SDL_EVENT_USER + 3), "Check SDL_FlushEvent() removed the type");
+
+    /* Only the first type is left, in order */
+    received = 0;
+    last = -1;
+    in_order = true;
+    while ((n = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST)) > 0) {
+        for (i = 0; i < n; ++i) {
+            if (events[i].type != SDL_EVENT_USER || events[i].user.code <= last) {
+                in_order = false;
+            }
+            last = events[i].user.code;
+        }
+        received += n;
+    }
+    SDLTest_AssertCheck(received == 500, "Check the remaining events, expected 500, got %d", received);
+    SDLTest_AssertCheck(in_order, "Check the remaining events are in order");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test that motion events are merged when SDL_HINT_EVENT_COALESCE_MOTION is set.
+ *
+ * \sa SDL_GetCoalescedEventCount
+ */
+static int SDLCALL events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    int i, n;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHintWithPriority(SDL_HINT_EVENT_COALESCE_MOTION, "1", SDL_HINT_OVERRIDE);
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    event.motion.windowID = 1;
+    event.motion.which = 1;
+    for (i = 1; i <= 10; ++i) {
+        event.common.timestamp = i;
+        event.motion.x = (float)i;
+        event.motion.y = (float)(i * 2);
+        event.motion.xrel = 1.0f;
+        event.motion.yrel = 2.0f;
+        SDL_PushEvent(&event);
+    }
+
+    /* A different mouse isn't merged, and neither is motion after another event */
+    event.motion.which = 2;
+    SDL_PushEvent(&event);
+    event.type = SDL_EVENT_USER;
+    SDL_PushEvent(&event);
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    SDL_PushEvent(&event);
+
+    n = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(n == 4, "Check the queued event count, expected 4, got %d", n);
+
+    SDL_PollEvent(&event);
+    SDLTest_AssertCheck(event.type == SDL_EVENT_MOUSE_MOTION && event.motion.which == 1, "Check the first event is motion of the first mouse");
+    SDLTest_AssertCheck(SDL_GetCoalescedEventCount(&event) == 10, "Check the merged sample count, expected 10, got %d", SDL_GetCoalescedEventCount(&event));
+    SDLTest_AssertCheck(event.motion.samples == 10, "Check the samples field, expected 10, got %" SDL_PRIu32, event.motion.samples);
+    SDLTest_AssertCheck(event.common.reserved == 0, "Check the reserved field wasn't used, got %" SDL_PRIu32, event.common.reserved);
+    SDLTest_AssertCheck(event.motion.x == 10.0f && event.motion.y == 20.0f, "Check the position is the latest, got %g,%g", event.motion.x, event.motion.y);
+    SDLTest_AssertCheck(event.motion.xrel == 10.0f && event.motion.yrel == 20.0f, "Check the relative motion is accumulated, got %g,%g", event.motion.xrel, event.motion.yrel);
+    SDLTest_AssertCheck(event.common.timestamp == 10, "Check the timestamp is the latest, got %" SDL_PRIu64, event.common.timestamp);
+
+    SDL_PollEvent(&event);
+    SDLTest_AssertCheck(SDL_GetCoalescedEventCount(&event) == 1, "Check motion of the second mouse wasn't merged");
+
+    SDL_SetHintWithPriority(SDL_HINT_EVENT_COALESCE_MOTION, "0", SDL_HINT_OVERRIDE);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    /* Without the hint every event is queued */
+    event.motion.which = 1;
+    for (i = 0; i < 10; ++i) {
+        SDL_PushEvent(&event);
+    }
+    n = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+    SDLTest_AssertCheck(n == 10, "Check motion isn't merged by default, expected 10, got %d", n);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+
+    return TEST_COMPLETED;
+}
+
+static bool SDLCALL DropOddUserEvents(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_USER) {
+        if ((event->user.code % 2) != 0) {
+            return false;
+        }
+        ++*(int *)userdata;
+    }
+    return true;
+}
+
+static bool SDLCALL CountUserEvents(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_USER) {
+        ++*(int *)userdata;
+    }
+    return true;
+}
+
+/**
+ * Test pushing an array of events at once.
+ *
+ * \sa SDL_PushEvents
+ */
+static int SDLCALL events_pushEvents(void *arg)
+{
+    SDL_Event events[100];
+    SDL_Event event;
+    int i, n, total, filtered = 0, watched = 0;
+    bool in_order = true;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    SDL_zeroa(events);
+    for (i = 0; i < SDL_arraysize(events); ++i) {
+        events[i].type = SDL_EVENT_USER;
+        events[i].user.code = i;
+    }
+
+    n = SDL_PushEvents(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(n == SDL_arraysize(events), "Check all events were pushed, expected %d, got %d", (int)SDL_arraysize(events), n);
+    SDLTest_AssertCheck(events[0].common.timestamp != 0, "Check the events were given a timestamp");
+    for (i = 0; i < SDL_arraysize(events); ++i) {
+        if (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER) != 1 || event.user.code != i) {
+            in_order = false;
+        }
+    }
+    SDLTest_AssertCheck(in_order, "Check the events came back in order");
+
+    /* The filter drops odd events, watchers see the rest */
+    SDL_SetEventFilter(DropOddUserEvents, &filtered);
+    SDL_AddEventWatch(CountUserEvents, &watched);
+    n = SDL_PushEvents(events, SDL_arraysize(events));
+    SDL_RemoveEventWatch(CountUserEvents, &watched);
+    SDL_SetEventFilter(NULL, NULL);
+    SDLTest_AssertCheck(n == SDL_arraysize(events) / 2, "Check the filtered events weren't counted, expected %d, got %d", (int)SDL_arraysize(events) / 2, n);
+    SDLTest_AssertCheck(filtered == SDL_arraysize(events) / 2, "Check the filter passed half the events, got %d", filtered);
+    SDLTest_AssertCheck(watched == SDL_arraysize(events) / 2, "Check the watcher saw the events that passed, got %d", watched);
+    for (i = 0; i < SDL_arraysize(events); i += 2) {
+        if (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER) != 1 || event.user.code != i) {
+            in_order = false;
+        }
+    }
+    SDLTest_AssertCheck(in_order, "Check the events that passed the filter came back in order");
+    SDLTest_AssertCheck(!SDL_HasEvent(SDL_EVENT_USER), "Check no user events are left");
+
+    /* Fill the queue, the last push only adds some of the events */
+    total = 0;
+    do {
+        n = SDL_PushEvents(events, SDL_arraysize(events));
+        if (n > 0) {
+            total += n;
+        }
+    } while (n == SDL_arraysize(events) && total < 1000000);
+    SDLTest_AssertCheck(n >= 0 && n < SDL_arraysize(events), "Check the queue filled up with a partial push, got %d", n);
+    SDL_ClearError();
+    n = SDL_PushEvents(events, SDL_arraysize(events));
+    SDLTest_AssertCheck(n == -1, "Check pushing to a full queue fails, got %d", n);
+    SDLTest_AssertCheck(*SDL_GetError() != '\0', "Check that an error is set when the queue is full");
+    SDL_FlushEvent(SDL_EVENT_USER);
+    SDLTest_AssertCheck(!SDL_HasEvent(SDL_EVENT_USER), "Check the full queue was flushed");
+
+    n = SDL_PushEvents(events, 0);
+    SDLTest_AssertCheck(n == 0, "Check pushing no events, expected 0, got %d", n);
+    n = SDL_PushEvents(NULL, 1);
+    SDLTest_AssertCheck(n == -1, "Check pushing NULL events fails, got %d", n);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    SDL_AtomicInt calls;
+    SDL_AtomicInt removed;
+    SDL_AtomicInt late_calls;
+} WatchState;
+
+static bool SDLCALL CountWatchCalls(void *userdata, SDL_Event *event)
+{
+    WatchState *state = (WatchState *)userdata;
+
+    if (event->type == SDL_EVENT_USER) {
+        if (SDL_GetAtomicInt(&state->removed)) {
+            SDL_AddAtomicInt(&state->late_calls, 1);
+        }
+        SDL_AddAtomicInt(&state->calls, 1);
+    }
+    return true;
+}
+
+static bool SDLCALL RemoveSelfWatch(void *userdata, SDL_Event *event)
+{
+    ++*(int *)userdata;
+    SDL_RemoveEventWatch(RemoveSelfWatch, userdata);
+    return true;
+}
+
+/**
+ * Test adding and removing event watchers while events are being pushed.
+ *
+ * \sa SDL_AddEventWatch
+ * \sa SDL_RemoveEventWatch
+ */
+static int SDLCALL events_watchWhilePushing(void *arg)
+{
+    SDL_Event event;
+    int self_calls = 0;
+    int i;
+    Sint64 leaked;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    /* A watcher can remove itself while it's being called */
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    SDL_AddEventWatch(RemoveSelfWatch, &self_calls);
+    SDL_PushEvent(&event);
+    SDL_PushEvent(&event);
+    SDLTest_AssertCheck(self_calls == 1, "Check a watcher that removed itself was called once, got %d", self_calls);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    /* Old copies of the watcher list are freed once nothing is using them */
+    SDLTest_AssertCheck(SDLTest_BeginLeakCheck(), "Check the leak check started");
+    for (i = 0; i < 1000; ++i) {
+        SDL_AddEventWatch(RemoveSelfWatch, &self_calls);
+        SDL_PushEvent(&event);
+        SDL_RemoveEventWatch(RemoveSelfWatch, &self_calls);
+
+        /* Flushed queue entries are kept for reuse, so keep the queue short */
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    }
+    leaked = SDLTest_EndLeakCheck();
+    SDLTest_AssertCheck(leaked >= 0 && leaked < 1024, "Check adding and removing watchers doesn't leak, %" SDL_PRIs64 " bytes remain", leaked);
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+    {
+        SDL_Thread *threads[PUSH_THREAD_COUNT];
+        WatchState always, sometimes;
+        int received = 0;
+
+        SDL_zero(always);
+        SDL_zero(sometimes);
+
+        /* Freed queue entries are kept for reuse, so make room for every event up front */
+        for (i = 0; i < PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS; ++i) {
+            SDL_PushEvent(&event);
+        }
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+        SDL_AddEventWatch(CountWatchCalls, &always);
+
+        /* The old watcher lists are freed even if events are always being dispatched */
+        SDLTest_AssertCheck(SDLTest_BeginLeakCheck(), "Check the leak check started");
+
+        for (i = 0; i < PUSH_THREAD_COUNT; ++i) {
+            threads[i] = SDL_CreateThread(PushUserEventsThread, "PushUserEvents", (void *)(intptr_t)i);
+        }
+
+        /* Keep adding and removing a second watcher, it must never be called after it's removed */
+        for (i = 0; received < PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS; ++i) {
+            SDL_Event events[64];
+            int n;
+
+            if (i % 2) {
+                SDL_RemoveEventWatch(CountWatchCalls, &sometimes);
+                SDL_SetAtomicInt(&sometimes.removed, 1);
+            } else {
+                SDL_SetAtomicInt(&sometimes.removed, 0);
+                SDL_AddEventWatch(CountWatchCalls, &sometimes);
+            }
+
+            n = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+            if (n > 0) {
+                received += n;
+            } else {
+                SDL_Delay(1);
+            }
+        }
+        SDL_RemoveEventWatch(CountWatchCalls, &sometimes);
+
+        for (i = 0; i < PUSH_THREAD_COUNT; ++i) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+        SDL_RemoveEventWatch(CountWatchCalls, &always);
+        leaked = SDLTest_EndLeakCheck();
+
+        SDLTest_AssertCheck(leaked >= 0 && leaked < 1024, "Check the old watcher lists were freed, %" SDL_PRIs64 " bytes remain", leaked);
+        SDLTest_AssertCheck(SDL_GetAtomicInt(&always.calls) == PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS, "Check the watcher saw every event, expected %d, got %d", PUSH_THREAD_COUNT * PUSH_THREAD_EVENTS, SDL_GetAtomicInt(&always.calls));
+        SDLTest_AssertCheck(SDL_GetAtomicInt(&sometimes.late_calls) == 0, "Check a removed watcher wasn't called, got %d calls", SDL_GetAtomicInt(&sometimes.late_calls));
+    }
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test recording how long events take to get to the application.
+ *
+ * \sa SDL_GetEventLatencyHistogram
+ * \sa SDL_ResetEventLatencyHistograms
+ */
+static int SDLCALL events_latencyHistogram(void *arg)
+{
+    SDL_EventLatencyHistogram histogram;
+    SDL_Event event;
+    Uint64 total;
+    int i;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHintWithPriority(SDL_HINT_EVENT_LATENCY_TRACING, "1", SDL_HINT_OVERRIDE);
+    SDL_ResetEventLatencyHistograms();
+
+    /* An event that happened 5 ms ago and waits in the queue for at least 2 ms */
+    while (SDL_GetTicksNS() <= SDL_MS_TO_NS(5)) {
+        SDL_Delay(1);
+    }
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    event.common.timestamp = SDL_GetTicksNS() - SDL_MS_TO_NS(5);
+    SDL_PushEvent(&event);
+    SDL_Delay(2);
+    SDLTest_AssertCheck(SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER) == 1, "Check the event was retrieved");
+
+    SDLTest_AssertCheck(SDL_GetEventLatencyHistogram(SDL_EVENT_USER, SDL_LATENCY_SOURCE_TO_QUEUE, &histogram), "Call to SDL_GetEventLatencyHistogram()");
+    SDLTest_AssertCheck(histogram.count == 1, "Check one event was recorded, got %" SDL_PRIu64, histogram.count);
+    SDLTest_AssertCheck(histogram.max_ns >= SDL_MS_TO_NS(5) && histogram.total_ns == histogram.max_ns, "Check the source latency is at least 5 ms, got %" SDL_PRIu64 " ns", histogram.max_ns);
+    for (total = 0, i = 0; i < SDL_EVENT_LATENCY_BUCKETS; ++i) {
+        total += histogram.buckets[i];
+    }
+    SDLTest_AssertCheck(total == 1 && histogram.buckets[13] == 1, "Check the event is in the 4-8 ms bucket");
+
+    SDLTest_AssertCheck(SDL_GetEventLatencyHistogram(SDL_EVENT_USER, SDL_LATENCY_QUEUE_TO_POLL, &histogram), "Call to SDL_GetEventLatencyHistogram()");
+    SDLTest_AssertCheck(histogram.count == 1 && histogram.max_ns >= SDL_MS_TO_NS(2), "Check the queue latency is at least 2 ms, got %" SDL_PRIu64 " ns", histogram.max_ns);
+
+    /* Flushed events weren't delivered, so they aren't recorded */
+    SDL_PushEvent(&event);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_GetEventLatencyHistogram(SDL_EVENT_USER, SDL_LATENCY_QUEUE_TO_POLL, &histogram);
+    SDLTest_AssertCheck(histogram.count == 1, "Check flushed events aren't recorded, got %" SDL_PRIu64, histogram.count);
+
+    SDL_ResetEventLatencyHistograms();
+    SDL_GetEventLatencyHistogram(SDL_EVENT_USER, SDL_LATENCY_QUEUE_TO_POLL, &histogram);
+    SDLTest_AssertCheck(histogram.count == 0, "Check the histograms were reset, got %" SDL_PRIu64, histogram.count);
+
+    /* Nothing is recorded without the hint */
+    SDL_SetHintWithPriority(SDL_HINT_EVENT_LATENCY_TRACING, "0", SDL_HINT_OVERRIDE);
+    SDL_PushEvent(&event);
+    SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDL_GetEventLatencyHistogram(SDL_EVENT_USER, SDL_LATENCY_QUEUE_TO_POLL, &histogram);
+    SDLTest_AssertCheck(histogram.count == 0, "Check latency isn't recorded by default, got %" SDL_PRIu64, histogram.count);
+
+    SDLTest_AssertCheck(!SDL_GetEventLatencyHistogram(SDL_EVENT_USER, SDL_LATENCY_QUEUE_TO_POLL, NULL), "Check a NULL histogram is rejected");
+    SDLTest_AssertCheck(!SDL_GetEventLatencyHistogram(SDL_EVENT_USER, (SDL_EventLatencyStage)2, &histogram), "Check an invalid stage is rejected");
+
+    SDL_ResetHint(SDL_HINT_EVENT_LATENCY_TRACING);
+
+    return TEST_COMPLETED;
+}
+
+/* Each clipboard update carries a copy of its mime types in temporary memory */
+#define TEMPORARY_MEMORY_EVENTS           16
+#define TEMPORARY_MEMORY_MIME_TYPES       10
+#define TEMPORARY_MEMORY_LARGE_MIME_TYPES 40
+
+static const void *SDLCALL events_clipboardData(void *userdata, const char *mime_type, size_t *size)
+{
+    *size = 0;
+    return NULL;
+}
+
+static int events_temporaryMemoryMimeTypes(int index)
+{
+    /* One of the events needs more than a quarter of a chunk, so it gets a chunk of its own */
+    return (index % TEMPORARY_MEMORY_EVENTS) == TEMPORARY_MEMORY_EVENTS / 2 ? TEMPORARY_MEMORY_LARGE_MIME_TYPES : TEMPORARY_MEMORY_MIME_TYPES;
+}
+
+static bool events_pushClipboardUpdate(int index)
+{
+    char names[TEMPORARY_MEMORY_LARGE_MIME_TYPES][64];
+    const char *mime_types[TEMPORARY_MEMORY_LARGE_MIME_TYPES];
+    const int count = events_temporaryMemoryMimeTypes(index);
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        SDL_snprintf(names[i], sizeof(names[i]), "application/x-sdl-test-event-%d-mime-type-%d", index, i);
+        mime_types[i] = names[i];
+    }
+    return SDL_SetClipboardData(events_clipboardData, NULL, NULL, mime_types, count);
+}
+
+static bool events_checkClipboardUpdate(const SDL_Event *event, int index)
+{
+    char name[64];
+    const int count = events_temporaryMemoryMimeTypes(index);
+    int i;
+
+    if (event->type != SDL_EVENT_CLIPBOARD_UPDATE || event->clipboard.num_mime_types != (Uint32)count) {
+        return false;
+    }
+    for (i = 0; i < count; ++i) {
+        SDL_snprintf(name, sizeof(name), "application/x-sdl-test-event-%d-mime-type-%d", index, i);
+        if (SDL_strcmp(event->clipboard.mime_types[i], name) != 0) {
+            return false;
+        }
+    }
+    return !event->clipboard.mime_types[count];
+}
+
+static bool events_pollClipboardUpdate(SDL_Event *event)
+{
+    while (SDL_PollEvent(event)) {
+        if (event->type == SDL_EVENT_CLIPBOARD_UPDATE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check that memory owned by queued events stays valid while temporary memory is freed and reused.
+ */
+static int SDLCALL events_temporaryMemory(void *arg)
+{
+    SDL_Event events[2 * TEMPORARY_MEMORY_EVENTS];
+    SDL_Event event;
+    int i, n, valid;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    if (!events_pushClipboardUpdate(0)) {
+        SDLTest_Log("Clipboard updates aren't available: %s", SDL_GetError());
+        return TEST_SKIPPED;
+    }
+
+    /* These span several chunks of temporary memory */
+    for (i = 1; i < TEMPORARY_MEMORY_EVENTS; ++i) {
+        events_pushClipboardUpdate(i);
+    }
+
+    /* Pumping frees this thread's temporary memory, which mustn't reuse what the queued events still own */
+    SDL_PumpEvents();
+    for (i = TEMPORARY_MEMORY_EVENTS; i < 2 * TEMPORARY_MEMORY_EVENTS; ++i) {
+        events_pushClipboardUpdate(i);
+    }
+
+    n = SDL_PeepEvents(events, SDL_arraysize(events), SDL_PEEKEVENT, SDL_EVENT_CLIPBOARD_UPDATE, SDL_EVENT_CLIPBOARD_UPDATE);
+    SDLTest_AssertCheck(n == SDL_arraysize(events), "Check the queued clipboard updates, expected %d, got %d", (int)SDL_arraysize(events), n);
+    for (valid = 0, i = 0; i < n; ++i) {
+        if (events_checkClipboardUpdate(&events[i], i)) {
+            ++valid;
+        }
+    }
+    SDLTest_AssertCheck(valid == n, "Check the mime types of the queued events, %d of %d are intact", valid, n);
+
+    /* Retrieve some of the events, their memory is valid until the next poll */
+    for (valid = 0, i = 0; i < TEMPORARY_MEMORY_EVENTS; ++i) {
+        if (events_pollClipboardUpdate(&event) && events_checkClipboardUpdate(&event, i)) {
+            ++valid;
+        }
+    }
+    SDLTest_AssertCheck(valid == TEMPORARY_MEMORY_EVENTS, "Check the mime types of the retrieved events, %d of %d are intact", valid, TEMPORARY_MEMORY_EVENTS);
+
+    /* Flushing frees the memory of the rest */
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_PumpEvents();
+    SDLTest_AssertPass("Flushed the remaining events");
+
+    /* And new events can use it again */
+    for (i = 0; i < TEMPORARY_MEMORY_EVENTS; ++i) {
+        events_pushClipboardUpdate(2 * TEMPORARY_MEMORY_EVENTS + i);
+    }
+    for (valid = 0, i = 0; i < TEMPORARY_MEMORY_EVENTS; ++i) {
+        if (events_pollClipboardUpdate(&event) && events_checkClipboardUpdate(&event, 2 * TEMPORARY_MEMORY_EVENTS + i)) {
+            ++valid;
+        }
+    }
+    SDLTest_AssertCheck(valid == TEMPORARY_MEMORY_EVENTS, "Check the mime types of new events, %d of %d are intact", valid, TEMPORARY_MEMORY_EVENTS);
+
+    SDL_ClearClipboardData();
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -327,12 +964,47 @@ static const SDLTest_TestCaseReference eventsTest_mainThreadCallbacks = {
     events_mainThreadCallbacks, "events_mainThreadCallbacks", "Run callbacks on the main thread", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_pushFromThreads = {
+    events_pushFromThreads, "events_pushFromThreads", "Push events from several threads at once", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_filterByType = {
+    events_filterByType, "events_filterByType", "Find, take and flush events by type", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_coalesceMotion = {
+    events_coalesceMotion, "events_coalesceMotion", "Merge consecutive motion events", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_pushEvents = {
+    events_pushEvents, "events_pushEvents", "Push an array of events at once", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_watchWhilePushing = {
+    events_watchWhilePushing, "events_watchWhilePushing", "Add and remove event watchers while events are pushed", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_latencyHistogram = {
+    events_latencyHistogram, "events_latencyHistogram", "Record event latency histograms", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_temporaryMemory = {
+    events_temporaryMemory, "events_temporaryMemory", "Keep event memory valid while temporary memory is reused", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
     &eventsTest_pushPumpAndPollUserevent,
     &eventsTest_addDelEventWatch,
     &eventsTest_addDelEventWatchWithUserdata,
     &eventsTest_mainThreadCallbacks,
+    &eventsTest_pushFromThreads,
+    &eventsTest_filterByType,
+    &eventsTest_coalesceMotion,
+    &eventsTest_pushEvents,
+    &eventsTest_watchWhilePushing,
+    &eventsTest_latencyHistogram,
+    &eventsTest_temporaryMemory,
     NULL
 };
 
@@ -4,6 +4,7 @@
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_test.h>
+#include "testautomation_memory.h"
 #include "testautomation_suites.h"
 
 static const char *HintsEnum[] = {
@@ -271,6 +272,57 @@ static int SDLCALL hints_setHint(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Change a hint that SDL caches internally many times
+ */
+static int SDLCALL hints_setHintRepeatedly(void *arg)
+{
+    const char *testHint = SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH;
+    char value[32];
+    int i;
+    Sint64 leaked;
+    bool observed = true;
+
+    SDL_SetHint(testHint, "0");
+    SDLTest_AssertCheck(!SDL_GetHintBoolean(testHint, true), "Check that the hint is false");
+
+    /* Changing the hint back and forth shouldn't use up memory. The video
+       backends cache this hint, so this covers their hint callbacks when a
+       video driver reads it, and the hint store itself otherwise. */
+    SDLTest_AssertCheck(SDLTest_BeginLeakCheck(), "Check that the leak check started");
+    for (i = 0; i < 1000; ++i) {
+        SDL_SetHint(testHint, (i % 2) ? "0" : "1");
+    }
+    for (i = 0; i < 1000; ++i) {
+        SDL_snprintf(value, sizeof(value), "%d", i);
+        SDL_SetHint(testHint, value);
+    }
+    leaked = SDLTest_EndLeakCheck();
+    SDLTest_AssertCheck(leaked >= 0 && leaked < 1024,
+                        "Check that changing the hint doesn't keep memory, %" SDL_PRIs64 " bytes remain", leaked);
+
+    /* Every change is seen */
+    for (i = 0; i < 100; ++i) {
+        const bool expected = (i % 2) == 0;
+        SDL_SetHint(testHint, expected ? "1" : "0");
+        if (SDL_GetHintBoolean(testHint, !expected) != expected) {
+            observed = false;
+        }
+    }
+    SDLTest_AssertCheck(observed, "Check that every change was seen");
+
+    SDL_ResetHint(testHint);
+    SDLTest_AssertPass("Call to SDL_ResetHint()");
+    SDLTest_AssertCheck(SDL_GetHint(testHint) == NULL, "Check that the hint has no value after being reset");
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, true), "Check that the default value is used after a reset");
+
+    SDL_SetHint(testHint, "1");
+    SDLTest_AssertCheck(SDL_GetHintBoolean(testHint, false), "Check that the hint can be set again after a reset");
+    SDL_ResetHint(testHint);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Hints test cases */
@@ -282,10 +334,15 @@ static const SDLTest_TestCaseReference hintsSetHint = {
     hints_setHint, "hints_setHint", "Call to SDL_SetHint", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference hintsSetHintRepeatedly = {
+    hints_setHintRepeatedly, "hints_setHintRepeatedly", "Call to SDL_SetHint many times on a cached hint", TEST_ENABLED
+};
+
 /* Sequence of Hints test cases */
 static const SDLTest_TestCaseReference *hintsTests[] = {
     &hintsGetHint,
     &hintsSetHint,
+    &hintsSetHintRepeatedly,
     NULL
 };
 
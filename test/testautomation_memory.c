@@ -0,0 +1,57 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_memory.h"
+
+/* Leak checks sample every allocation with the heap profiler, which tracks live bytes per tag */
+#define LEAK_CHECK_TAG "testautomation-leak-check"
+
+bool SDLTest_BeginLeakCheck(void)
+{
+    if (!SDLTest_StartHeapProfiler(1)) {
+        return false;
+    }
+    SDLTest_SetHeapProfilerTag(LEAK_CHECK_TAG);
+    return true;
+}
+
+Sint64 SDLTest_EndLeakCheck(void)
+{
+    SDL_IOStream *stream;
+    const char *profile;
+    const char *line;
+    Sint64 bytes = -1;
+
+    SDLTest_SetHeapProfilerTag(NULL);
+
+    stream = SDL_IOFromDynamicMem();
+    if (stream) {
+        if (SDLTest_WriteHeapProfile(stream, false) && SDL_WriteU8(stream, '\0')) {
+            profile = (const char *)SDL_GetPointerProperty(SDL_GetIOProperties(stream), SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+            if (profile) {
+                /* The per-subsystem totals have a line "  <tag>: <bytes> bytes in <count> allocations" */
+                line = SDL_strstr(profile, "  " LEAK_CHECK_TAG ": ");
+                if (line) {
+                    bytes = (Sint64)SDL_strtoll(line + SDL_strlen("  " LEAK_CHECK_TAG ": "), NULL, 10);
+                } else {
+                    /* Nothing the tag allocated is still alive */
+                    bytes = 0;
+                }
+            }
+        }
+        SDL_CloseIO(stream);
+    }
+
+    SDLTest_StopHeapProfiler();
+    return bytes;
+}
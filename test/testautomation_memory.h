@@ -0,0 +1,24 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Helpers for checking that code under test doesn't leak memory */
+
+#ifndef testautomation_memory_h_
+#define testautomation_memory_h_
+
+/* Start recording the allocations made by the calling thread */
+extern bool SDLTest_BeginLeakCheck(void);
+
+/* Stop recording and return the number of bytes still allocated since SDLTest_BeginLeakCheck(), or -1 on error */
+extern Sint64 SDLTest_EndLeakCheck(void);
+
+#endif /* testautomation_memory_h_ */
@@ -490,6 +490,79 @@ static int SDLCALL platform_testGetPowerInfo(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests SDL_GetCPUTopology() and SDL_SetCurrentThreadAffinity()
+ * \sa SDL_GetCPUTopology
+ * \sa SDL_SetCurrentThreadAffinity
+ */
+static int SDLCALL platform_testCPUTopology(void *arg)
+{
+    const SDL_CPUTopology *topology;
+    int i, cores = 0;
+    int cpu;
+    bool result;
+
+    topology = SDL_GetCPUTopology();
+    SDLTest_AssertPass("SDL_GetCPUTopology()");
+    SDLTest_AssertCheck(topology != NULL, "SDL_GetCPUTopology() != NULL");
+    if (!topology) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(topology == SDL_GetCPUTopology(), "Validate that the topology is cached");
+
+    SDLTest_Log("%d logical cores, %d physical cores (%d performance, %d efficiency), %d packages, %d NUMA nodes",
+                topology->num_logical_cores, topology->num_physical_cores,
+                topology->num_performance_cores, topology->num_efficiency_cores,
+                topology->num_packages, topology->num_numa_nodes);
+    SDLTest_Log("L1d %d bytes, L2 %d bytes, L3 %d bytes",
+                topology->l1d_cache_size, topology->l2_cache_size, topology->l3_cache_size);
+
+    SDLTest_AssertCheck(topology->num_logical_cores > 0, "Validate num_logical_cores > 0, got %d", topology->num_logical_cores);
+    SDLTest_AssertCheck(topology->num_physical_cores > 0 && topology->num_physical_cores <= topology->num_logical_cores,
+                        "Validate 0 < num_physical_cores <= num_logical_cores, got %d", topology->num_physical_cores);
+    SDLTest_AssertCheck(topology->num_performance_cores + topology->num_efficiency_cores == topology->num_physical_cores,
+                        "Validate performance and efficiency cores add up to num_physical_cores");
+    SDLTest_AssertCheck(topology->num_packages > 0, "Validate num_packages > 0, got %d", topology->num_packages);
+    SDLTest_AssertCheck(topology->num_numa_nodes > 0, "Validate num_numa_nodes > 0, got %d", topology->num_numa_nodes);
+
+    for (i = 0; i < topology->num_logical_cores; ++i) {
+        const SDL_LogicalCPU *info = &topology->cpus[i];
+        SDLTest_AssertCheck(i == 0 || info->cpu > topology->cpus[i - 1].cpu, "Validate CPUs are sorted");
+        SDLTest_AssertCheck(info->core >= 0 && info->core < topology->num_physical_cores, "Validate core of CPU %d, got %d", info->cpu, info->core);
+        SDLTest_AssertCheck(info->package >= 0 && info->package < topology->num_packages, "Validate package of CPU %d, got %d", info->cpu, info->package);
+        SDLTest_AssertCheck(info->numa_node >= 0 && info->numa_node < topology->num_numa_nodes, "Validate NUMA node of CPU %d, got %d", info->cpu, info->numa_node);
+        cores = SDL_max(cores, info->core + 1);
+    }
+    SDLTest_AssertCheck(cores == topology->num_physical_cores, "Validate every physical core has a logical CPU");
+
+    /* Pin to the first CPU, then allow all of them again */
+    cpu = topology->cpus[0].cpu;
+    result = SDL_SetCurrentThreadAffinity(&cpu, 1);
+    SDLTest_AssertPass("SDL_SetCurrentThreadAffinity(%d)", cpu);
+    if (result) {
+        int *all = (int *)SDL_malloc(topology->num_logical_cores * sizeof(*all));
+        SDLTest_AssertCheck(all != NULL, "SDL_malloc()");
+        if (all) {
+            for (i = 0; i < topology->num_logical_cores; ++i) {
+                all[i] = topology->cpus[i].cpu;
+            }
+            result = SDL_SetCurrentThreadAffinity(all, topology->num_logical_cores);
+            SDLTest_AssertCheck(result, "SDL_SetCurrentThreadAffinity() with all CPUs, expected true, got %s", result ? "true" : "false");
+            SDL_free(all);
+        }
+    } else {
+        SDLTest_Log("Thread affinity is not supported: %s", SDL_GetError());
+    }
+
+    cpu = -1;
+    result = SDL_SetCurrentThreadAffinity(&cpu, 1);
+    SDLTest_AssertCheck(!result, "SDL_SetCurrentThreadAffinity() with CPU -1, expected false, got %s", result ? "true" : "false");
+    result = SDL_SetCurrentThreadAffinity(NULL, 1);
+    SDLTest_AssertCheck(!result, "SDL_SetCurrentThreadAffinity() with NULL, expected false, got %s", result ? "true" : "false");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Platform test cases */
@@ -533,6 +606,10 @@ static const SDLTest_TestCaseReference platformTest10 = {
     platform_testGetPowerInfo, "platform_testGetPowerInfo", "Tests SDL_GetPowerInfo function", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference platformTest11 = {
+    platform_testCPUTopology, "platform_testCPUTopology", "Tests SDL_GetCPUTopology and SDL_SetCurrentThreadAffinity", TEST_ENABLED
+};
+
 /* Sequence of Platform test cases */
 static const SDLTest_TestCaseReference *platformTests[] = {
     &platformTest1,
@@ -545,6 +622,7 @@ static const SDLTest_TestCaseReference *platformTests[] = {
     &platformTest8,
     &platformTest9,
     &platformTest10,
+    &platformTest11,
     NULL
 };
 
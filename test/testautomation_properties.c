@@ -4,6 +4,7 @@
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_test.h>
+#include "testautomation_memory.h"
 #include "testautomation_suites.h"
 
 /* Test case functions */
@@ -274,6 +275,46 @@ static int SDLCALL properties_testCopy(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test copying properties that have a cached string value
+ */
+static int SDLCALL properties_testCopyCachedString(void *arg)
+{
+    SDL_PropertiesID a, b;
+    const char *string;
+
+    a = SDL_CreateProperties();
+    SDL_SetNumberProperty(a, "num", 42);
+    SDL_SetFloatProperty(a, "float", 1.5f);
+
+    SDLTest_AssertPass("Call to SDL_GetStringProperty() on number and float properties");
+    string = SDL_GetStringProperty(a, "num", NULL);
+    SDLTest_AssertCheck(string && SDL_strcmp(string, "42") == 0,
+        "Checking num as string, got \"%s\", expected \"42\"", string ? string : "NULL");
+    string = SDL_GetStringProperty(a, "float", NULL);
+    SDLTest_AssertCheck(string && SDL_strcmp(string, "1.500000") == 0,
+        "Checking float as string, got \"%s\", expected \"1.500000\"", string ? string : "NULL");
+
+    b = SDL_CreateProperties();
+    SDLTest_AssertPass("Call to SDL_CopyProperties(a, b)");
+    SDL_CopyProperties(a, b);
+
+    SDLTest_AssertPass("Call to SDL_DestroyProperties(a)");
+    SDL_DestroyProperties(a);
+
+    string = SDL_GetStringProperty(b, "num", NULL);
+    SDLTest_AssertCheck(string && SDL_strcmp(string, "42") == 0,
+        "Checking copied num as string, got \"%s\", expected \"42\"", string ? string : "NULL");
+    string = SDL_GetStringProperty(b, "float", NULL);
+    SDLTest_AssertCheck(string && SDL_strcmp(string, "1.500000") == 0,
+        "Checking copied float as string, got \"%s\", expected \"1.500000\"", string ? string : "NULL");
+
+    SDLTest_AssertPass("Call to SDL_DestroyProperties(b)");
+    SDL_DestroyProperties(b);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Test cleanup functionality
  */
@@ -333,11 +374,42 @@ static int SDLCALL properties_thread(void *arg)
     SDL_UnlockProperties(data->props);
     return 0;
 }
+struct properties_reader_data
+{
+    SDL_AtomicInt done;
+    SDL_AtomicInt reads;
+    SDL_AtomicInt errors;
+    SDL_PropertiesID props;
+};
+static int SDLCALL properties_reader_thread(void *arg)
+{
+    struct properties_reader_data *data = (struct properties_reader_data *)arg;
+    const char *string;
+    Sint64 num;
+
+    while (!SDL_GetAtomicInt(&data->done)) {
+        num = SDL_GetNumberProperty(data->props, "a", 0);
+        if (num != 0 && num != 1 && num != 2) {
+            SDL_AddAtomicInt(&data->errors, 1);
+        }
+        // The string form of "a" may be freed by the writer at any time, so only check the stable "b"
+        SDL_GetStringProperty(data->props, "a", NULL);
+        string = SDL_GetStringProperty(data->props, "b", NULL);
+        if (!string || SDL_strcmp(string, "7") != 0) {
+            SDL_AddAtomicInt(&data->errors, 1);
+        }
+        SDL_AddAtomicInt(&data->reads, 1);
+    }
+    return 0;
+}
 static int SDLCALL properties_testLocking(void *arg)
 {
     struct properties_thread_data data;
+    struct properties_reader_data reader;
     SDL_Thread *thread;
+    SDL_Thread *readers[2];
     void *value;
+    int i;
 
     SDLTest_AssertPass("Testing property locking");
     data.done = false;
@@ -379,6 +451,133 @@ static int SDLCALL properties_testLocking(void *arg)
     }
     SDL_DestroyProperties(data.props);
 
+    SDLTest_AssertPass("Testing property reads while another thread writes");
+    SDL_SetAtomicInt(&reader.done, 0);
+    SDL_SetAtomicInt(&reader.reads, 0);
+    SDL_SetAtomicInt(&reader.errors, 0);
+    reader.props = SDL_CreateProperties();
+    SDL_SetNumberProperty(reader.props, "a", 1);
+    SDL_SetNumberProperty(reader.props, "b", 7);
+    for (i = 0; i < SDL_arraysize(readers); ++i) {
+        readers[i] = SDL_CreateThread(properties_reader_thread, "properties_reader", &reader);
+    }
+    for (i = 0; i < 10000 || (readers[0] && SDL_GetAtomicInt(&reader.reads) < 1000); ++i) {
+        if ((i % 3) == 2) {
+            SDL_ClearProperty(reader.props, "a");
+        } else {
+            SDL_SetNumberProperty(reader.props, "a", 1 + (i % 3));
+        }
+        if ((i % 100) == 0) {
+            SDL_Delay(0);
+        }
+    }
+    SDL_SetAtomicInt(&reader.done, 1);
+    for (i = 0; i < SDL_arraysize(readers); ++i) {
+        SDL_WaitThread(readers[i], NULL);
+    }
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&reader.errors) == 0,
+        "Readers saw %d invalid values in %d reads, expected 0", SDL_GetAtomicInt(&reader.errors), SDL_GetAtomicInt(&reader.reads));
+    SDL_DestroyProperties(reader.props);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test interned property names
+ */
+static void SDLCALL get_property_name(void *userdata, SDL_PropertiesID props, const char *name)
+{
+    *(const char **)userdata = name;
+}
+
+static int SDLCALL properties_testIntern(void *arg)
+{
+    SDL_PropertiesID props;
+    const char *name, *other;
+    char buffer[32];
+    Sint64 num;
+    int i, pass, count;
+    Sint64 leaked;
+
+    SDLTest_AssertPass("Call to SDL_InternString(NULL)");
+    name = SDL_InternString(NULL);
+    SDLTest_AssertCheck(name == NULL,
+        "Verify SDL_InternString(NULL) fails, got %p", name);
+
+    SDL_strlcpy(buffer, "intern.test", sizeof(buffer));
+    name = SDL_InternString(buffer);
+    SDLTest_AssertCheck(name && name != buffer && SDL_strcmp(name, "intern.test") == 0,
+        "Verify interned string, got %s", name ? name : "NULL");
+    other = SDL_InternString("intern.test");
+    SDLTest_AssertCheck(other == name,
+        "Verify equal strings are interned to the same pointer, got %p, expected %p", other, name);
+    other = SDL_InternString(name);
+    SDLTest_AssertCheck(other == name,
+        "Verify interning an interned string returns it, got %p, expected %p", other, name);
+    other = SDL_InternString("intern.test2");
+    SDLTest_AssertCheck(other && other != name,
+        "Verify different strings are interned to different pointers");
+
+    /* Interned and regular names refer to the same property */
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, name, 1);
+    num = SDL_GetNumberProperty(props, "intern.test", 0);
+    SDLTest_AssertCheck(num == 1,
+        "Verify property set with interned name, got %" SDL_PRIs64 ", expected 1", num);
+    SDL_SetNumberProperty(props, "intern.test", 2);
+    num = SDL_GetNumberProperty(props, name, 0);
+    SDLTest_AssertCheck(num == 2,
+        "Verify property queried with interned name, got %" SDL_PRIs64 ", expected 2", num);
+    count = 0;
+    SDL_EnumerateProperties(props, count_properties, &count);
+    SDLTest_AssertCheck(count == 1,
+        "Verify property count, expected 1, got: %d", count);
+    other = NULL;
+    SDL_EnumerateProperties(props, get_property_name, &other);
+    SDLTest_AssertCheck(other == name,
+        "Verify the property is stored under the interned name, got %p, expected %p", other, name);
+
+    /* Names that were never used aren't found */
+    num = SDL_GetNumberProperty(props, "intern.unused", 3);
+    SDLTest_AssertCheck(num == 3,
+        "Verify unused property name, got %" SDL_PRIs64 ", expected 3", num);
+    SDLTest_AssertCheck(SDL_ClearProperty(props, "intern.unused"),
+        "Verify clearing an unused property name succeeds");
+
+    SDL_ClearProperty(props, name);
+    SDLTest_AssertCheck(!SDL_HasProperty(props, "intern.test"),
+        "Verify property cleared with interned name");
+
+    /* Setting a property doesn't intern its name */
+    SDL_SetNumberProperty(props, "intern.owned", 4);
+    other = NULL;
+    SDL_EnumerateProperties(props, get_property_name, &other);
+    SDLTest_AssertCheck(other && SDL_strcmp(other, "intern.owned") == 0 && other != SDL_InternString("intern.owned"),
+        "Verify the property has its own copy of a name that wasn't interned");
+    SDL_ClearProperty(props, "intern.owned");
+
+    /* Names that weren't interned are freed with their properties. The
+       first pass grows the property table, which keeps its size, so only
+       the second pass with new names is measured. */
+    for (pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            SDLTest_AssertCheck(SDLTest_BeginLeakCheck(), "Verify the leak check started");
+        }
+        for (i = 0; i < 1000; ++i) {
+            SDL_snprintf(buffer, sizeof(buffer), "intern.dynamic.%d.%d", pass, i);
+            SDL_SetNumberProperty(props, buffer, i);
+        }
+        for (i = 0; i < 1000; ++i) {
+            SDL_snprintf(buffer, sizeof(buffer), "intern.dynamic.%d.%d", pass, i);
+            SDL_ClearProperty(props, buffer);
+        }
+    }
+    leaked = SDLTest_EndLeakCheck();
+    SDLTest_AssertCheck(leaked >= 0 && leaked < 1024,
+        "Verify cleared property names are freed, %" SDL_PRIs64 " bytes remain", leaked);
+
+    SDL_DestroyProperties(props);
+
     return TEST_COMPLETED;
 }
 
@@ -393,6 +592,10 @@ static const SDLTest_TestCaseReference propertiesTestCopy = {
     properties_testCopy, "properties_testCopy", "Test property copy functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTestCopyCachedString = {
+    properties_testCopyCachedString, "properties_testCopyCachedString", "Test copying properties with a cached string value", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference propertiesTestCleanup = {
     properties_testCleanup, "properties_testCleanup", "Test property cleanup functionality", TEST_ENABLED
 };
@@ -401,12 +604,18 @@ static const SDLTest_TestCaseReference propertiesTestLocking = {
     properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTestIntern = {
+    properties_testIntern, "properties_testIntern", "Test interned property names", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
     &propertiesTestBasic,
     &propertiesTestCopy,
+    &propertiesTestCopyCachedString,
     &propertiesTestCleanup,
     &propertiesTestLocking,
+    &propertiesTestIntern,
     NULL
 };
 
@@ -1224,6 +1224,61 @@ static int SDLCALL sdltest_randomAsciiStringOfSize(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Calls to SDLTest_StartHeapProfiler() and SDLTest_WriteHeapProfile()
+ */
+static int SDLCALL sdltest_heapProfiler(void *arg)
+{
+    const char *tag = "sdltest_heapProfiler";
+    void *blocks[64];
+    SDL_IOStream *stream;
+    const char *profile;
+    bool result;
+    int i;
+
+    /* Sample about every allocation, so the blocks below are sure to show up */
+    result = SDLTest_StartHeapProfiler(1);
+    SDLTest_AssertPass("Call to SDLTest_StartHeapProfiler(1)");
+    SDLTest_AssertCheck(result, "Validate that the heap profiler started: %s", result ? "true" : SDL_GetError());
+    if (!result) {
+        return TEST_ABORTED;
+    }
+
+    SDLTest_SetHeapProfilerTag(tag);
+    for (i = 0; i < SDL_arraysize(blocks); ++i) {
+        blocks[i] = SDL_malloc(1024);
+    }
+    SDLTest_SetHeapProfilerTag(NULL);
+
+    stream = SDL_IOFromDynamicMem();
+    SDLTest_AssertCheck(stream != NULL, "Validate that SDL_IOFromDynamicMem() succeeded");
+    if (stream) {
+        result = SDLTest_WriteHeapProfile(stream, false);
+        SDLTest_AssertPass("Call to SDLTest_WriteHeapProfile()");
+        SDLTest_AssertCheck(result, "Validate that the heap profile was written: %s", result ? "true" : SDL_GetError());
+        SDLTest_AssertCheck(SDL_GetIOSize(stream) > 0, "Validate that the heap profile isn't empty, got %d bytes", (int)SDL_GetIOSize(stream));
+        SDL_WriteU8(stream, '\0');
+        profile = (const char *)SDL_GetPointerProperty(SDL_GetIOProperties(stream), SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+        SDLTest_AssertCheck(profile && SDL_strstr(profile, tag) != NULL, "Validate that the tagged allocations are in the profile");
+        SDL_CloseIO(stream);
+    }
+
+    for (i = 0; i < SDL_arraysize(blocks); ++i) {
+        SDL_free(blocks[i]);
+    }
+
+    SDLTest_StopHeapProfiler();
+    SDLTest_AssertPass("Call to SDLTest_StopHeapProfiler()");
+
+    stream = SDL_IOFromDynamicMem();
+    if (stream) {
+        result = SDLTest_WriteHeapProfile(stream, true);
+        SDLTest_AssertCheck(!result, "Validate that writing a profile fails when the profiler isn't running");
+    }
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* SDL_test test cases */
@@ -1287,11 +1342,15 @@ static const SDLTest_TestCaseReference sdltestTest15 = {
     sdltest_generateRunSeed, "sdltest_generateRunSeed", "Checks internal harness function SDLTest_GenerateRunSeed", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference sdltestTest16 = {
+    sdltest_heapProfiler, "sdltest_heapProfiler", "Calls to the sampling heap profiler", TEST_ENABLED
+};
+
 /* Sequence of SDL_test test cases */
 static const SDLTest_TestCaseReference *sdltestTests[] = {
     &sdltestTest1, &sdltestTest2, &sdltestTest3, &sdltestTest4, &sdltestTest5, &sdltestTest6,
     &sdltestTest7, &sdltestTest8, &sdltestTest9, &sdltestTest10, &sdltestTest11, &sdltestTest12,
-    &sdltestTest13, &sdltestTest14, &sdltestTest15, NULL
+    &sdltestTest13, &sdltestTest14, &sdltestTest15, &sdltestTest16, NULL
 };
 
 /* SDL_test test suite (global) */
@@ -1433,6 +1433,116 @@ static int SDLCALL stdlib_strtod(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_CreateArena and friends
+ */
+static int SDLCALL stdlib_arena(void *arg)
+{
+    SDL_Arena *arena;
+    SDL_ArenaMark mark;
+    Uint8 *first, *second, *big, *again;
+    int i;
+
+    arena = SDL_CreateArena(1024);
+    SDLTest_AssertPass("Call to SDL_CreateArena(1024)");
+    SDLTest_AssertCheck(arena != NULL, "Check that SDL_CreateArena() succeeded");
+    if (!arena) {
+        return TEST_ABORTED;
+    }
+
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) == 0, "Check that a new arena is empty");
+
+    first = (Uint8 *)SDL_AllocateArenaMemory(arena, 10, 1);
+    second = (Uint8 *)SDL_AllocateArenaMemory(arena, 100, 64);
+    SDLTest_AssertCheck(first && second, "Check that small allocations succeed");
+    SDLTest_AssertCheck(((uintptr_t)second % 64) == 0, "Check that the allocation is aligned to 64 bytes");
+    SDLTest_AssertCheck(second >= first + 10, "Check that allocations don't overlap");
+    SDL_memset(first, 0xAA, 10);
+    SDL_memset(second, 0xBB, 100);
+
+    again = (Uint8 *)SDL_AllocateArenaMemory(arena, 16, 0);
+    SDLTest_AssertCheck(again && ((uintptr_t)again % SDL_GetSIMDAlignment()) == 0, "Check that the default alignment is SDL_GetSIMDAlignment()");
+
+    /* Everything after the mark, including allocations bigger than a block, is released by resetting to it */
+    mark = SDL_GetArenaMark(arena);
+    big = (Uint8 *)SDL_AllocateArenaMemory(arena, 5000, 16);
+    SDLTest_AssertCheck(big != NULL, "Check that an allocation bigger than the block size succeeds");
+    if (big) {
+        SDL_memset(big, 0xCC, 5000);
+    }
+    for (i = 0; i < 100; ++i) {
+        SDL_AllocateArenaMemory(arena, 100, 8);
+    }
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) > mark, "Check that the arena position moves forward");
+    SDL_ResetArenaToMark(arena, mark);
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) == mark, "Check that SDL_ResetArenaToMark() restores the position");
+    SDLTest_AssertCheck(first[9] == 0xAA && second[99] == 0xBB, "Check that memory before the mark is untouched");
+
+    /* The same allocations reuse the same memory */
+    again = (Uint8 *)SDL_AllocateArenaMemory(arena, 5000, 16);
+    SDLTest_AssertCheck(again == big, "Check that the large block is reused after a reset");
+
+    SDL_ResetArena(arena);
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) == 0, "Check that SDL_ResetArena() empties the arena");
+    again = (Uint8 *)SDL_AllocateArenaMemory(arena, 10, 1);
+    SDLTest_AssertCheck(again == first, "Check that the first block is reused after SDL_ResetArena()");
+
+    again = (Uint8 *)SDL_AllocateArenaMemory(arena, 10, 3);
+    SDLTest_AssertCheck(again == NULL, "Check that an alignment that isn't a power of two fails");
+
+    SDL_DestroyArena(arena);
+    SDLTest_AssertPass("Call to SDL_DestroyArena()");
+
+    arena = SDL_GetThreadArena();
+    SDLTest_AssertCheck(arena != NULL, "Check that SDL_GetThreadArena() succeeded");
+    SDLTest_AssertCheck(arena == SDL_GetThreadArena(), "Check that SDL_GetThreadArena() returns the same arena");
+    if (arena) {
+        mark = SDL_GetArenaMark(arena);
+        SDLTest_AssertCheck(SDL_AllocateArenaMemory(arena, 256, 0) != NULL, "Check that the thread arena can allocate");
+        SDL_ResetArenaToMark(arena, mark);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Call to SDL_ResetArenaToMark on an arena that hasn't allocated anything yet
+ */
+static int SDLCALL stdlib_arenaEmptyMark(void *arg)
+{
+    SDL_Arena *arena;
+    SDL_ArenaMark mark;
+    void *mem;
+
+    arena = SDL_CreateArena(0);
+    SDLTest_AssertPass("Call to SDL_CreateArena(0)");
+    SDLTest_AssertCheck(arena != NULL, "Check that SDL_CreateArena() succeeded");
+    if (!arena) {
+        return TEST_ABORTED;
+    }
+
+    mark = SDL_GetArenaMark(arena);
+    SDLTest_AssertCheck(mark == 0, "Check that a new arena is empty");
+    SDL_ResetArenaToMark(arena, mark);
+    SDLTest_AssertPass("Call to SDL_ResetArenaToMark() on an empty arena");
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) == 0, "Check that the arena is still empty");
+
+    mem = SDL_AllocateArenaMemory(arena, 128, 0);
+    SDLTest_AssertCheck(mem != NULL, "Check that the arena can allocate after the reset");
+    SDL_ResetArenaToMark(arena, mark);
+    SDLTest_AssertCheck(SDL_GetArenaMark(arena) == 0, "Check that SDL_ResetArenaToMark() returns to the start");
+
+    /* Resetting to the current position doesn't change anything */
+    mark = SDL_GetArenaMark(arena);
+    SDL_ResetArenaToMark(arena, mark);
+    SDLTest_AssertCheck(SDL_AllocateArenaMemory(arena, 128, 0) == mem, "Check that the first allocation is reused");
+
+    SDL_DestroyArena(arena);
+    SDLTest_AssertPass("Call to SDL_DestroyArena()");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Standard C routine test cases */
@@ -1468,6 +1578,14 @@ static const SDLTest_TestCaseReference stdlibTest_aligned_alloc = {
     stdlib_aligned_alloc, "stdlib_aligned_alloc", "Call to SDL_aligned_alloc", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference stdlibTest_arena = {
+    stdlib_arena, "stdlib_arena", "Calls to SDL_CreateArena and SDL_AllocateArenaMemory", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest_arenaEmptyMark = {
+    stdlib_arenaEmptyMark, "stdlib_arenaEmptyMark", "Call to SDL_ResetArenaToMark on an empty arena", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference stdlibTestOverflow = {
     stdlib_overflow, "stdlib_overflow", "Overflow detection", TEST_ENABLED
 };
@@ -1502,6 +1620,8 @@ static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest_getsetenv,
     &stdlibTest_sscanf,
     &stdlibTest_aligned_alloc,
+    &stdlibTest_arena,
+    &stdlibTest_arenaEmptyMark,
     &stdlibTestOverflow,
     &stdlibTest_iconv,
     &stdlibTest_strpbrk,
@@ -1626,6 +1626,82 @@ static int SDLCALL surface_testScale(void *arg)
 }
 
 
+/**
+ * Tests stretching surfaces large enough to be split into bands of rows.
+ */
+static int SDLCALL surface_testStretchLarge(void *arg)
+{
+    const int src_w = 320, src_h = 200;
+    const int dst_w = 2 * src_w, dst_h = 2 * src_h;
+    SDL_Surface *src, *dst;
+    const Uint32 *row;
+    Uint32 expected, actual;
+    float position;
+    int x, y, bad_x = -1, bad_y = -1;
+    bool ret;
+
+    src = SDL_CreateSurface(src_w, src_h, SDL_PIXELFORMAT_ARGB8888);
+    dst = SDL_CreateSurface(dst_w, dst_h, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+    if (!src || !dst) {
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        return TEST_ABORTED;
+    }
+
+    /* Every source pixel is different, so each destination pixel shows where it came from */
+    for (y = 0; y < src_h; ++y) {
+        Uint32 *pixels = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (x = 0; x < src_w; ++x) {
+            pixels[x] = 0xFF000000 | ((Uint32)y << 12) | (Uint32)x;
+        }
+    }
+    ret = SDL_StretchSurface(src, NULL, dst, NULL, SDL_SCALEMODE_NEAREST);
+    SDLTest_AssertCheck(ret == true, "Verify result from SDL_StretchSurface(SDL_SCALEMODE_NEAREST), expected: true, got: %i", ret);
+    for (y = 0; y < dst_h && bad_y < 0; ++y) {
+        row = (const Uint32 *)((const Uint8 *)dst->pixels + y * dst->pitch);
+        for (x = 0; x < dst_w; ++x) {
+            expected = 0xFF000000 | ((Uint32)(y / 2) << 12) | (Uint32)(x / 2);
+            if (row[x] != expected) {
+                bad_x = x;
+                bad_y = y;
+                break;
+            }
+        }
+    }
+    SDLTest_AssertCheck(bad_y < 0, "Verify every pixel was scaled from the right source pixel, first wrong pixel at %d,%d", bad_x, bad_y);
+
+    /* Each row has its own shade of green, which is interpolated between rows */
+    for (y = 0; y < src_h; ++y) {
+        Uint32 *pixels = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (x = 0; x < src_w; ++x) {
+            pixels[x] = 0xFF000000 | ((Uint32)y << 8);
+        }
+    }
+    ret = SDL_StretchSurface(src, NULL, dst, NULL, SDL_SCALEMODE_LINEAR);
+    SDLTest_AssertCheck(ret == true, "Verify result from SDL_StretchSurface(SDL_SCALEMODE_LINEAR), expected: true, got: %i", ret);
+    bad_x = bad_y = -1;
+    for (y = 0; y < dst_h && bad_y < 0; ++y) {
+        row = (const Uint32 *)((const Uint8 *)dst->pixels + y * dst->pitch);
+        position = SDL_clamp((y + 0.5f) / 2.0f - 0.5f, 0.0f, (float)(src_h - 1));
+        for (x = 0; x < dst_w; ++x) {
+            actual = (row[x] >> 8) & 0xFF;
+            if (row[x] != row[0] || SDL_fabsf((float)actual - position) > 1.0f) {
+                bad_x = x;
+                bad_y = y;
+                break;
+            }
+        }
+    }
+    SDLTest_AssertCheck(bad_y < 0, "Verify every row was interpolated from the right source rows, first wrong pixel at %d,%d", bad_x, bad_y);
+
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+
+    return TEST_COMPLETED;
+}
+
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -1737,6 +1813,10 @@ static const SDLTest_TestCaseReference surfaceTestScale = {
     surface_testScale, "surface_testScale", "Test scaling operations.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestStretchLarge = {
+    surface_testStretchLarge, "surface_testStretchLarge", "Test stretching large surfaces.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestInvalidFormat,
@@ -1766,6 +1846,7 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
     &surfaceTestScale,
+    &surfaceTestStretchLarge,
     NULL
 };
 
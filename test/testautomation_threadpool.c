@@ -0,0 +1,284 @@
+/**
+ * Thread pool test suite
+ */
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+/* ================= Test Case Implementation ================== */
+
+/* Helper functions */
+
+#define NUM_JOBS      10000
+#define NUM_NESTED    16
+#define NESTED_JOBS   100
+#define TREE_SIZE     ((1 << 9) - 1)
+#define PARALLEL_SIZE 1000000
+
+static SDL_AtomicInt g_jobsRun;
+
+static SDL_JobGroup *g_treeGroup;
+
+/* Each test runs on a pool of its own and on the pool shared with SDL */
+static SDL_ThreadPool *threadpoolCreate(int iteration)
+{
+    SDL_ThreadPool *pool = NULL;
+
+    if (iteration == 0) {
+        pool = SDL_CreateThreadPool(4);
+        SDLTest_AssertPass("Call to SDL_CreateThreadPool(4)");
+        SDLTest_AssertCheck(pool != NULL, "Validate that the thread pool was created: %s", pool ? "true" : SDL_GetError());
+    } else {
+        SDLTest_AssertPass("Using the shared thread pool");
+    }
+    return pool;
+}
+
+static void threadpoolDestroy(SDL_ThreadPool *pool)
+{
+    if (pool) {
+        SDL_DestroyThreadPool(pool);
+        SDLTest_AssertPass("Call to SDL_DestroyThreadPool()");
+    }
+}
+
+static void SDLCALL CountJob(void *userdata)
+{
+    SDL_AddAtomicInt(&g_jobsRun, 1);
+}
+
+/* Each node of a complete binary tree submits its two children to the same group */
+static void SDLCALL TreeJob(void *userdata)
+{
+    const int index = (int)(intptr_t)userdata;
+
+    SDL_AddAtomicInt(&g_jobsRun, 1);
+    if (2 * index + 2 < TREE_SIZE) {
+        SDL_SubmitJob(g_treeGroup, TreeJob, (void *)(intptr_t)(2 * index + 1));
+        SDL_SubmitJob(g_treeGroup, TreeJob, (void *)(intptr_t)(2 * index + 2));
+    }
+}
+
+/* A job that waits for a group of its own */
+static void SDLCALL NestedJob(void *userdata)
+{
+    SDL_ThreadPool *pool = (SDL_ThreadPool *)userdata;
+    SDL_JobGroup *group = SDL_CreateJobGroup(pool);
+    int i;
+
+    if (group) {
+        for (i = 0; i < NESTED_JOBS; ++i) {
+            SDL_SubmitJob(group, CountJob, NULL);
+        }
+        SDL_DestroyJobGroup(group);
+    }
+}
+
+static void SDLCALL FillRange(void *userdata, int start, int end)
+{
+    Uint8 *visited = (Uint8 *)userdata;
+    int i;
+
+    for (i = start; i < end; ++i) {
+        ++visited[i];
+    }
+}
+
+/* Returns the first index that wasn't visited exactly once, or -1 if they all were */
+static int FindBadVisit(const Uint8 *visited, int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        if (visited[i] != 1) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Test case functions */
+
+/**
+ * Calls to the thread pool functions with invalid parameters
+ */
+static int SDLCALL threadpool_invalidParams(void *arg)
+{
+    SDL_ThreadPool *pool;
+    bool result;
+
+    pool = SDL_CreateThreadPool(-1);
+    SDLTest_AssertPass("Call to SDL_CreateThreadPool(-1)");
+    SDLTest_AssertCheck(pool == NULL, "Validate that a negative number of threads fails");
+    SDL_DestroyThreadPool(pool);
+
+    result = SDL_SubmitJob(NULL, CountJob, NULL);
+    SDLTest_AssertPass("Call to SDL_SubmitJob(NULL, ...)");
+    SDLTest_AssertCheck(!result, "Validate that submitting to a NULL group fails");
+
+    SDL_WaitJobGroup(NULL);
+    SDLTest_AssertPass("Call to SDL_WaitJobGroup(NULL)");
+    SDL_DestroyJobGroup(NULL);
+    SDLTest_AssertPass("Call to SDL_DestroyJobGroup(NULL)");
+
+    result = SDL_ParallelFor(NULL, -1, 0, FillRange, NULL);
+    SDLTest_AssertCheck(!result, "Validate that SDL_ParallelFor() with a negative count fails");
+    result = SDL_ParallelFor(NULL, 1, -1, FillRange, NULL);
+    SDLTest_AssertCheck(!result, "Validate that SDL_ParallelFor() with a negative grain fails");
+    result = SDL_ParallelFor(NULL, 1, 0, NULL, NULL);
+    SDLTest_AssertCheck(!result, "Validate that SDL_ParallelFor() without a function fails");
+    result = SDL_ParallelFor(NULL, 0, 0, FillRange, NULL);
+    SDLTest_AssertCheck(result, "Validate that SDL_ParallelFor() over no indices succeeds");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Submit lots of small jobs and wait for them
+ */
+static int SDLCALL threadpool_submitJobs(void *arg)
+{
+    SDL_ThreadPool *pool;
+    SDL_JobGroup *group;
+    int i, iteration, submitted;
+
+    for (iteration = 0; iteration < 2; ++iteration) {
+        pool = threadpoolCreate(iteration);
+        group = SDL_CreateJobGroup(pool);
+        SDLTest_AssertCheck(group != NULL, "Validate that the job group was created: %s", group ? "true" : SDL_GetError());
+        if (group) {
+            SDL_SetAtomicInt(&g_jobsRun, 0);
+            for (submitted = 0; submitted < NUM_JOBS; ++submitted) {
+                if (!SDL_SubmitJob(group, CountJob, NULL)) {
+                    break;
+                }
+            }
+            SDLTest_AssertCheck(submitted == NUM_JOBS, "Validate that every job was submitted, expected %d, got %d", NUM_JOBS, submitted);
+            SDL_WaitJobGroup(group);
+            SDLTest_AssertPass("Call to SDL_WaitJobGroup()");
+            i = SDL_GetAtomicInt(&g_jobsRun);
+            SDLTest_AssertCheck(i == submitted, "Validate that every job ran, expected %d, got %d", submitted, i);
+
+            /* The group can be reused once it's done */
+            SDL_SetAtomicInt(&g_jobsRun, 0);
+            SDL_SubmitJob(group, CountJob, NULL);
+            SDL_DestroyJobGroup(group);
+            SDLTest_AssertPass("Call to SDL_DestroyJobGroup()");
+            i = SDL_GetAtomicInt(&g_jobsRun);
+            SDLTest_AssertCheck(i == 1, "Validate that destroying a group waits for its jobs, expected 1, got %d", i);
+        }
+        threadpoolDestroy(pool);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Jobs that submit more jobs, and jobs that wait for other jobs
+ */
+static int SDLCALL threadpool_nestedJobs(void *arg)
+{
+    SDL_ThreadPool *pool;
+    SDL_JobGroup *group;
+    int i, iteration;
+
+    for (iteration = 0; iteration < 2; ++iteration) {
+        pool = threadpoolCreate(iteration);
+        group = SDL_CreateJobGroup(pool);
+        SDLTest_AssertCheck(group != NULL, "Validate that the job group was created: %s", group ? "true" : SDL_GetError());
+        if (group) {
+            SDL_SetAtomicInt(&g_jobsRun, 0);
+            g_treeGroup = group;
+            SDL_SubmitJob(group, TreeJob, (void *)(intptr_t)0);
+            SDL_WaitJobGroup(group);
+            i = SDL_GetAtomicInt(&g_jobsRun);
+            SDLTest_AssertCheck(i == TREE_SIZE, "Validate that every job submitted by a job ran, expected %d, got %d", TREE_SIZE, i);
+
+            SDL_SetAtomicInt(&g_jobsRun, 0);
+            for (i = 0; i < NUM_NESTED; ++i) {
+                SDL_SubmitJob(group, NestedJob, pool);
+            }
+            SDL_WaitJobGroup(group);
+            i = SDL_GetAtomicInt(&g_jobsRun);
+            SDLTest_AssertCheck(i == NUM_NESTED * NESTED_JOBS, "Validate that jobs can wait for other jobs, expected %d, got %d", NUM_NESTED * NESTED_JOBS, i);
+
+            SDL_DestroyJobGroup(group);
+        }
+        threadpoolDestroy(pool);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Run a function over a range of indices, with automatic and explicit grain sizes
+ */
+static int SDLCALL threadpool_parallelFor(void *arg)
+{
+    SDL_ThreadPool *pool;
+    Uint8 *visited;
+    int bad, iteration;
+    bool result;
+
+    visited = (Uint8 *)SDL_malloc(PARALLEL_SIZE);
+    SDLTest_AssertCheck(visited != NULL, "Validate that memory was allocated");
+    if (!visited) {
+        return TEST_ABORTED;
+    }
+
+    for (iteration = 0; iteration < 2; ++iteration) {
+        pool = threadpoolCreate(iteration);
+
+        SDL_memset(visited, 0, PARALLEL_SIZE);
+        result = SDL_ParallelFor(pool, PARALLEL_SIZE, 0, FillRange, visited);
+        SDLTest_AssertPass("Call to SDL_ParallelFor(%d, 0)", PARALLEL_SIZE);
+        SDLTest_AssertCheck(result, "Validate result from SDL_ParallelFor(): %s", result ? "true" : SDL_GetError());
+        bad = FindBadVisit(visited, PARALLEL_SIZE);
+        SDLTest_AssertCheck(bad < 0, "Validate that every index was visited once, first wrong index: %d", bad);
+
+        SDL_memset(visited, 0, PARALLEL_SIZE);
+        result = SDL_ParallelFor(pool, 1001, 7, FillRange, visited);
+        SDLTest_AssertPass("Call to SDL_ParallelFor(1001, 7)");
+        SDLTest_AssertCheck(result, "Validate result from SDL_ParallelFor(): %s", result ? "true" : SDL_GetError());
+        bad = FindBadVisit(visited, 1001);
+        SDLTest_AssertCheck(bad < 0, "Validate that every index was visited once with a grain of 7, first wrong index: %d", bad);
+        SDLTest_AssertCheck(visited[1001] == 0, "Validate that no index past the end was visited");
+
+        threadpoolDestroy(pool);
+    }
+    SDL_free(visited);
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Thread pool test cases */
+static const SDLTest_TestCaseReference threadpoolTest1 = {
+    threadpool_invalidParams, "threadpool_invalidParams", "Calls to the thread pool functions with invalid parameters", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadpoolTest2 = {
+    threadpool_submitJobs, "threadpool_submitJobs", "Calls to SDL_SubmitJob and SDL_WaitJobGroup with many jobs", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadpoolTest3 = {
+    threadpool_nestedJobs, "threadpool_nestedJobs", "Jobs that submit and wait for other jobs", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference threadpoolTest4 = {
+    threadpool_parallelFor, "threadpool_parallelFor", "Calls to SDL_ParallelFor", TEST_ENABLED
+};
+
+/* Sequence of Thread pool test cases */
+static const SDLTest_TestCaseReference *threadpoolTests[] = {
+    &threadpoolTest1, &threadpoolTest2, &threadpoolTest3, &threadpoolTest4, NULL
+};
+
+/* Thread pool test suite (global) */
+SDLTest_TestSuiteReference threadpoolTestSuite = {
+    "ThreadPool",
+    NULL,
+    threadpoolTests,
+    NULL
+};
@@ -174,6 +174,186 @@ static int SDLCALL timer_addRemoveTimer(void *arg)
 #endif
 }
 
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+
+#define MANY_TIMERS 1000
+
+static SDL_AtomicInt g_timersFired;
+static int g_timerOrder[MANY_TIMERS];
+
+/* Records the order the timers fire in, these are all called on the timer thread */
+static Uint64 SDLCALL timerOrderCallback(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    const int fired = SDL_GetAtomicInt(&g_timersFired);
+    if (fired < MANY_TIMERS) {
+        g_timerOrder[fired] = (int)(intptr_t)param;
+    }
+    SDL_AddAtomicInt(&g_timersFired, 1);
+    return 0;
+}
+
+#endif
+
+/**
+ * Call to SDL_AddTimerNS and SDL_RemoveTimer with many timers
+ */
+static int SDLCALL timer_manyTimers(void *arg)
+{
+#ifdef SDL_PLATFORM_EMSCRIPTEN
+    SDLTest_Log("Timer callbacks on Emscripten require a main loop to handle events");
+    return TEST_SKIPPED;
+#else
+    SDL_TimerID ids[MANY_TIMERS];
+    Uint64 start;
+    int i, fired, removed;
+    bool in_order = true;
+
+    SDL_SetAtomicInt(&g_timersFired, 0);
+
+    /* Timers with the same interval fire in the order they were added */
+    for (i = 0; i < MANY_TIMERS; ++i) {
+        ids[i] = SDL_AddTimerNS(SDL_MS_TO_NS(50), timerOrderCallback, (void *)(intptr_t)i);
+        if (!ids[i]) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == MANY_TIMERS, "Check %d timers were added, got %d", MANY_TIMERS, i);
+
+    /* Removing a timer doesn't disturb the others */
+    for (i = 1; i < MANY_TIMERS; i += 2) {
+        SDL_RemoveTimer(ids[i]);
+    }
+
+    start = SDL_GetTicks();
+    while (SDL_GetAtomicInt(&g_timersFired) < MANY_TIMERS / 2 && SDL_GetTicks() - start < 5000) {
+        SDL_Delay(10);
+    }
+    SDL_Delay(100);
+
+    fired = SDL_GetAtomicInt(&g_timersFired);
+    SDLTest_AssertCheck(fired == MANY_TIMERS / 2, "Check the remaining timers fired, expected: %d, got: %d", MANY_TIMERS / 2, fired);
+    for (i = 0; i < fired && i < MANY_TIMERS; ++i) {
+        if (g_timerOrder[i] != i * 2) {
+            in_order = false;
+            break;
+        }
+    }
+    SDLTest_AssertCheck(in_order, "Check the timers fired in order");
+
+    /* Timers that already fired can't be removed */
+    removed = 0;
+    for (i = 0; i < MANY_TIMERS; i += 2) {
+        if (SDL_RemoveTimer(ids[i])) {
+            ++removed;
+        }
+    }
+    SDLTest_AssertCheck(removed == 0, "Check fired timers can't be removed, expected: 0, got: %d", removed);
+
+    return TEST_COMPLETED;
+#endif
+}
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+
+#define WORKER_TIMERS 4
+
+typedef struct
+{
+    SDL_AtomicInt running;  /* Calls of this timer's callback in progress */
+    SDL_AtomicInt calls;
+    SDL_AtomicInt overlaps; /* Calls that started while another call of the same timer was running */
+} WorkerTimerState;
+
+static WorkerTimerState g_workerTimers[WORKER_TIMERS];
+static SDL_AtomicInt g_workerCallbacksRunning;
+static SDL_AtomicInt g_workerCallbacksMaxRunning;
+
+/* Takes longer than the timer interval, so the next call is always due before this one returns */
+static Uint64 SDLCALL timerWorkerCallback(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    WorkerTimerState *state = (WorkerTimerState *)param;
+    const int running = SDL_AddAtomicInt(&g_workerCallbacksRunning, 1) + 1;
+    int max_running = SDL_GetAtomicInt(&g_workerCallbacksMaxRunning);
+
+    while (running > max_running && !SDL_CompareAndSwapAtomicInt(&g_workerCallbacksMaxRunning, max_running, running)) {
+        max_running = SDL_GetAtomicInt(&g_workerCallbacksMaxRunning);
+    }
+    if (SDL_AddAtomicInt(&state->running, 1) + 1 > 1) {
+        SDL_AddAtomicInt(&state->overlaps, 1);
+    }
+    SDL_AddAtomicInt(&state->calls, 1);
+
+    SDL_Delay(5);
+
+    SDL_AddAtomicInt(&state->running, -1);
+    SDL_AddAtomicInt(&g_workerCallbacksRunning, -1);
+    return interval;
+}
+
+#endif
+
+/* Timer worker thread fixture */
+
+static void SDLCALL timerWorkersSetUp(void **arg)
+{
+    /* The hint is only checked when the timer thread starts, so restart SDL to start it again */
+    SDL_Quit();
+    SDL_SetHint(SDL_HINT_TIMER_WORKER_THREADS, "2");
+    SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_TIMER_WORKER_THREADS, \"2\")");
+}
+
+static void SDLCALL timerWorkersTearDown(void *arg)
+{
+    /* This waits for any callbacks that are still running and resets the hint */
+    SDL_Quit();
+
+    SDLTest_AssertPass("Cleanup of timer worker thread test completed");
+}
+
+/**
+ * Call to SDL_AddTimerNS with SDL_HINT_TIMER_WORKER_THREADS set
+ */
+static int SDLCALL timer_workerThreads(void *arg)
+{
+#ifdef SDL_PLATFORM_EMSCRIPTEN
+    SDLTest_Log("Timer callbacks on Emscripten require a main loop to handle events");
+    return TEST_SKIPPED;
+#else
+    SDL_TimerID ids[WORKER_TIMERS];
+    int i, calls, overlaps;
+
+    SDL_zeroa(g_workerTimers);
+    SDL_SetAtomicInt(&g_workerCallbacksRunning, 0);
+    SDL_SetAtomicInt(&g_workerCallbacksMaxRunning, 0);
+    for (i = 0; i < WORKER_TIMERS; ++i) {
+        ids[i] = SDL_AddTimerNS(SDL_MS_TO_NS(1), timerWorkerCallback, &g_workerTimers[i]);
+        SDLTest_AssertCheck(ids[i] > 0, "Check result value of SDL_AddTimerNS(SDL_MS_TO_NS(1), ...), expected: >0, got: %" SDL_PRIu32, ids[i]);
+    }
+
+    SDL_Delay(200);
+    SDLTest_AssertPass("Call to SDL_Delay(200)");
+
+    for (i = 0; i < WORKER_TIMERS; ++i) {
+        SDL_RemoveTimer(ids[i]);
+    }
+
+    /* This waits for any callbacks that are still running */
+    SDL_Quit();
+
+    for (i = 0; i < WORKER_TIMERS; ++i) {
+        calls = SDL_GetAtomicInt(&g_workerTimers[i].calls);
+        overlaps = SDL_GetAtomicInt(&g_workerTimers[i].overlaps);
+        SDLTest_AssertCheck(calls > 1, "Check timer %d fired repeatedly, expected: >1, got: %d", i, calls);
+        SDLTest_AssertCheck(overlaps == 0, "Check timer %d's callback never overlapped itself, got: %d overlaps", i, overlaps);
+    }
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&g_workerCallbacksMaxRunning) > 1,
+                        "Check callbacks of different timers ran at the same time, got at most %d at once",
+                        SDL_GetAtomicInt(&g_workerCallbacksMaxRunning));
+
+    return TEST_COMPLETED;
+#endif
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -193,9 +373,13 @@ static const SDLTest_TestCaseReference timerTest4 = {
     timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference timerTest5 = {
+    timer_manyTimers, "timer_manyTimers", "Call to SDL_AddTimerNS and SDL_RemoveTimer with many timers", TEST_ENABLED
+};
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] = {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, NULL
 };
 
 /* Timer test suite (global) */
@@ -205,3 +389,21 @@ SDLTest_TestSuiteReference timerTestSuite = {
     timerTests,
     NULL
 };
+
+/* Timer worker thread test cases */
+static const SDLTest_TestCaseReference timerWorkersTest1 = {
+    timer_workerThreads, "timer_workerThreads", "Call to SDL_AddTimerNS with timer worker threads", TEST_ENABLED
+};
+
+/* Sequence of Timer worker thread test cases */
+static const SDLTest_TestCaseReference *timerWorkersTests[] = {
+    &timerWorkersTest1, NULL
+};
+
+/* Timer worker thread test suite (global), restarts SDL around each test */
+SDLTest_TestSuiteReference timerWorkersTestSuite = {
+    "TimerWorkers",
+    timerWorkersSetUp,
+    timerWorkersTests,
+    timerWorkersTearDown
+};